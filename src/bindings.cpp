@@ -9,20 +9,27 @@
 
 #include <genogrove/config/version.hpp>
 
+#include "data_type/byte_view.hpp"
 #include "data_type/genomic_coordinate.hpp"
 #include "data_type/json_value.hpp"
 #include "data_type/kmer.hpp"
+#include "data_type/mapped_registry.hpp"
 #include "data_type/numeric.hpp"
+#include "data_type/packed_sequence.hpp"
 #include "data_type/registry.hpp"
+#include "data_type/variant_genotypes.hpp"
 #include "io/bam_reader.hpp"
 #include "io/bed_reader.hpp"
 #include "io/fasta_index.hpp"
 #include "io/fasta_reader.hpp"
 #include "io/filetype_detector.hpp"
 #include "io/gff_reader.hpp"
+#include "io/vcf_annotate.hpp"
 #include "io/vcf_reader.hpp"
 #include "structure/grove.hpp"
 #include "structure/grove_view.hpp"
+#include "structure/kmer_counter.hpp"
+#include "structure/sketch.hpp"
 
 namespace py = pybind11;
 namespace gio = genogrove::io;
@@ -110,10 +117,34 @@ PYBIND11_MODULE(pygenogrove, m) {
 
     // VCF/BCF variant reader: SampleGenotype / VcfEntry value types + VcfReader
     // iterator. Like SAM, vcf_entry isn't serializable (variant-valued INFO /
-    // nested samples), so there's no typed VcfGrove — load into the universal
-    // Grove via VcfEntry.to_coordinate() + .to_dict().
+    // nested samples), so there's no VcfEntry-typed grove — load site fields into
+    // the universal Grove via VcfEntry.to_coordinate() + .to_dict(), or
+    // genotypes into VariantGrove below.
     bind_vcf_reader(m);
 
+    // Variant grove: grove<genomic_coordinate, variant_genotypes> — REF/ALT plus
+    // 2-bit packed per-sample genotypes (and optional 8-bit GQ / DP), bulk-loaded
+    // from a VcfReader with insert_vcf(); VariantQueryResult.genotypes() returns
+    // the hits as one dosage matrix. Void edges, like the other typed groves.
+    bind_variant_genotypes(m);
+    bind_grove<gdt::genomic_coordinate, pygg::variant_genotypes>(
+        m, "VariantGrove", "VariantKey", "VariantQueryResult",
+        "VariantFlankingResult");
+    bind_grove_view<gdt::genomic_coordinate, pygg::variant_genotypes>(
+        m, "VariantGroveView");
+
+    // annotate_vcf(vcf, grove, out): stream a VCF/BCF through htslib, intersect
+    // each record with a Bed/Gff Grove or GroveView in C++, and write the hits'
+    // fields back as INFO tags (or TSV columns). Needs the typed groves above.
+    bind_annotate_vcf(m);
+
+    // Zero-copy memoryview exporter (sequence_view / PackedSequence.packed) and
+    // PackedSequence: 2-bit DNA with an N-run sidecar, SWAR encode / revcomp /
+    // GC / k-mer kernels. Produced by FastaEntry / FastaChunk.to_packed() and
+    // FastaIndex.fetch_packed().
+    bind_byte_view(m);
+    bind_packed_sequence(m);
+
     // FASTA/FASTQ sequence reader: FastaEntry value type + FastaReader iterator.
     // Standalone (named sequences, not intervals — no grove integration).
     bind_fasta_entry(m);
@@ -124,31 +155,28 @@ PYBIND11_MODULE(pygenogrove, m) {
     // feature's sequence); requires a writable directory to build a missing .fai.
     bind_fasta_index(m);
 
+    // KmerCounter: multi-threaded k-mer counting over a FastaReader / path into
+    // hash-partitioned C++ tables; exports NumPy arrays or a KmerGrove /
+    // NumericGrove carrying the counts.
+    bind_kmer_counter(m);
+
+    // Sketches: minimizers(), bottom-k MinHashSketch, and SketchIndex — a
+    // KmerGrove of per-hash sample postings answering containment / Jaccard
+    // screens.
+    bind_sketch(m);
+
     // File-type detector: Filetype / CompressionType enums + FiletypeDetector.
     bind_filetype_detector(m);
 
-    // Universal interning registry: registry<std::string, void, json_value>
-    // exposed as Registry — a process-wide singleton mapping a string identity
-    // (gene_id / chrom / transcript_id) to any JSON-serializable payload. One
-    // bound class covers every payload shape, mirroring how the universal Grove
-    // uses json_value instead of a per-type template zoo. The two-arg
-    // intern(key, payload) form comes from the generic template; the single-arg
-    // intern(value) sugar below stores the string as its own payload so
-    // get(id) returns it back (plain string interning).
-    using registry_t = gdt::registry<std::string, void, pygg::json_value>;
-    auto reg = bind_registry<std::string, void, pygg::json_value>(m, "Registry");
-    reg.def(
-        "intern",
-        [](registry_t& r, const std::string& value) {
-            return r.intern(value, py::cast<pygg::json_value>(py::str(value)));
-        },
-        py::arg("value"),
-        R"pbdoc(
-            Intern a string as both key and payload and return its stable id.
-            Idempotent (deduplicated); get(id) returns the string back.
-            Convenience for plain string interning — use intern(key, payload)
-            to attach a distinct JSON payload.
-        )pbdoc");
+    // Universal interning registry: a string identity (gene_id / chrom /
+    // transcript_id) -> stable id -> any JSON-serializable payload, exposed as
+    // Registry. gdt::registry's interface over pygenogrove's own sharded,
+    // append-only storage, so it is safe to intern from many threads and
+    // intern_many can run with the GIL released. One bound class covers every
+    // payload shape, mirroring how the universal Grove uses json_value.
+    // MappedRegistry is its read-only, memory-mapped form (Registry.write_mapped).
+    auto registry = bind_registry(m, "Registry");
+    bind_mapped_registry(m, registry, "MappedRegistry");
 
     // __version__ is single-sourced from pyproject.toml via CMake; __genogrove_version__
     // reports the genogrove the wheel was built against (independent SemVer — the two
@@ -0,0 +1,59 @@
+/*
+ * byte_view — zero-copy, read-only memoryviews over bytes owned by a bound C++
+ * object (FastaEntry / FastaChunk sequences, PackedSequence's packed bases).
+ *
+ * The exporter (_ByteView) holds a reference to the owning Python object, so a
+ * memoryview keeps its owner alive; the owner must not reallocate the bytes
+ * while a view exists. An owner whose bytes can be reassigned hands each view a
+ * `pin` and refuses the reassignment while a pin is held elsewhere.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace py = pybind11;
+
+namespace pygg {
+
+// A read-only byte range inside a Python-owned object. Exported through the
+// buffer protocol; `owner` keeps the bytes alive for as long as any memoryview
+// over them exists.
+struct byte_view {
+    py::object owner;
+    const char* data;
+    std::size_t size;
+    std::shared_ptr<const void> pin;  // held for as long as the view exists
+};
+
+// memoryview over `bytes`, which must live inside `owner`.
+inline py::memoryview make_byte_view(py::object owner, const std::string& bytes,
+                                     std::shared_ptr<const void> pin = nullptr) {
+    return py::memoryview(
+        py::cast(byte_view{std::move(owner), bytes.data(), bytes.size(), std::move(pin)}));
+}
+
+// memoryview over a raw byte range that must live inside `owner`.
+inline py::memoryview make_byte_view(py::object owner, const void* data, std::size_t size) {
+    return py::memoryview(
+        py::cast(byte_view{std::move(owner), static_cast<const char*>(data), size, nullptr}));
+}
+
+}  // namespace pygg
+
+inline void bind_byte_view(py::module_& m) {
+    // Not meant to be used directly: the exporter behind the sequence_view /
+    // quality_view / PackedSequence.packed memoryviews.
+    py::class_<pygg::byte_view>(m, "_ByteView", py::buffer_protocol())
+        .def_buffer([](pygg::byte_view& v) {
+            return py::buffer_info(const_cast<char*>(v.data), 1,
+                                   py::format_descriptor<uint8_t>::format(), 1,
+                                   {static_cast<py::ssize_t>(v.size)}, {1},
+                                   /*readonly=*/true);
+        });
+}
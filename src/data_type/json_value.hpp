@@ -8,33 +8,110 @@
  * (byte-identical to serializer<std::string>), so the resulting `.gg` is a valid
  * genogrove file readable by a C++ grove<KeyT, std::string> — the payload is just
  * JSON text rather than a typed binary record.
+ *
+ * A payload of a grove with interned fields (payload_columns.hpp) holds registry
+ * ids in those fields, and in memory opens with a header member naming the
+ * grove's columns by handle and listing the ids by slot; the caster expands the
+ * ids back to strings on the way to Python. serialize() drops the header, so
+ * the stored text stays plain JSON, and deserialize() rebuilds it for a grove
+ * loaded with its columns. Read without its "<path>.columns" file, a payload's
+ * interned fields come back as their integer ids.
  */
 #pragma once
 
 #include <pybind11/pybind11.h>
 
+#include <cstddef>
+#include <cstdio>
 #include <istream>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <utility>
 
 #include <genogrove/data_type/serialization_traits.hpp>
 
 namespace pygg {
 
+struct payload_columns;
+
+// Columns indexed into every json_value deserialized on this thread — set while
+// a grove with interned fields is loaded, or a view of one pages blocks in.
+inline const payload_columns*& loading_columns() {
+    thread_local const payload_columns* columns = nullptr;
+    return columns;
+}
+
+// The in-memory header of a payload holding interned ids:
+// {"\u0000":[handle,id0,id1,…],<the payload's own members>}. json.dumps
+// separates with ": ", so no payload it writes can open the same way, and the
+// header is never the last member (it exists only beside an interned field).
+inline constexpr std::string_view columns_header_open = "{\"\\u0000\":[";
+
+// Position just past json's header and its comma, or 0 when it has none.
+inline std::size_t columns_header_end(std::string_view json) {
+    if (json.substr(0, columns_header_open.size()) != columns_header_open) return 0;
+    return json.find(']', columns_header_open.size()) + 2;
+}
+
+struct json_value;
+
+// Rebuild v's header from the ids in its interned fields (defined in
+// payload_columns.hpp).
+inline void index_columns(const payload_columns& cols, json_value& v);
+
 struct json_value {
     // Always valid JSON. "null" decodes to Python None, so a default / no-data
     // payload round-trips to None.
     std::string json = "null";
 
     void serialize(std::ostream& os) const {
-        genogrove::data_type::serialization_traits<std::string>::serialize(os, json);
+        using traits = genogrove::data_type::serialization_traits<std::string>;
+        if (const std::size_t end = columns_header_end(json)) {
+            traits::serialize(os, '{' + json.substr(end));
+        } else {
+            traits::serialize(os, json);
+        }
     }
     static json_value deserialize(std::istream& is) {
-        return json_value{
-            genogrove::data_type::serialization_traits<std::string>::deserialize(is)};
+        json_value v{genogrove::data_type::serialization_traits<std::string>::deserialize(is)};
+        if (loading_columns()) index_columns(*loading_columns(), v);
+        return v;
     }
 };
 
+// The JSON text with interned field ids replaced by their strings (defined in
+// payload_columns.hpp).
+inline std::string expanded_json(const json_value& v);
+
+// A JSON string literal for s (UTF-8 passed through, quotes / backslashes /
+// control characters escaped) — builds a string payload without the GIL.
+inline json_value json_quote(std::string_view s) {
+    json_value v;
+    v.json.clear();
+    v.json.reserve(s.size() + 2);
+    v.json += '"';
+    for (char c : s) {
+        switch (c) {
+            case '"': v.json += "\\\""; break;
+            case '\\': v.json += "\\\\"; break;
+            case '\n': v.json += "\\n"; break;
+            case '\r': v.json += "\\r"; break;
+            case '\t': v.json += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof buf, "\\u%04x", static_cast<unsigned>(c));
+                    v.json += buf;
+                } else {
+                    v.json += c;
+                }
+        }
+    }
+    v.json += '"';
+    return v;
+}
+
 }  // namespace pygg
 
 namespace pybind11 {
@@ -52,9 +129,12 @@ struct type_caster<pygg::json_value> {
         return true;
     }
 
-    // json_value -> Python object (json.loads).
+    // json_value -> Python object (json.loads), interned fields expanded.
     static handle cast(const pygg::json_value& v, return_value_policy /*policy*/,
                        handle /*parent*/) {
+        if (pygg::columns_header_end(v.json)) {
+            return json_loads()(str(pygg::expanded_json(v))).release();
+        }
         return json_loads()(str(v.json)).release();
     }
 
@@ -48,5 +48,5 @@ void bind_key(py::module_& m, const char* name) {
         "BedKey/GffKey it is a live, mutable reference into grove storage "
         "(mutating it in place is safe). On the universal Grove the payload is "
         "JSON, so .data returns a freshly decoded copy each access — mutating that "
-        "copy does not persist; re-insert to change it.");
+        "copy does not persist; use Grove.set_data() / update() to change it.");
 }
\ No newline at end of file
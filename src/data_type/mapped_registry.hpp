@@ -0,0 +1,291 @@
+/*
+ * mapped_registry — a read-only Registry queried in place from a memory-mapped
+ * file. Opening one maps the file and checks its header; nothing is parsed,
+ * hashed or copied, so a dictionary of millions of names opens instantly and
+ * processes mapping the same file share its pages through the page cache.
+ *
+ * The file is a sorted string table (native little-endian, 8-byte aligned):
+ *
+ *   magic "PGGRTB\0\1" | n | key_bytes | payload_bytes      (4 x 8 bytes)
+ *   key_offsets[n + 1]     uint64, id order, into the key blob
+ *   payload_offsets[n + 1] uint64, id order, into the payload blob
+ *   sorted_ids[n]          uint32, ids in ascending (bytewise) key order,
+ *                          zero-padded to a multiple of 8 bytes
+ *   key blob | payload blob (JSON text)
+ *
+ * get(id) / key(id) are two offset reads; find(key) is a binary search over
+ * sorted_ids. Offsets are bounds-checked on access rather than validated up
+ * front, so a corrupt file raises instead of reading out of range. Ids are the
+ * source registry's, so ids stored elsewhere (e.g. in grove payloads) stay valid.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>  // std::optional<id> -> int | None
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json_value.hpp"
+#include "registry.hpp"
+
+namespace py = pybind11;
+
+namespace pygg {
+
+inline constexpr char mapped_registry_magic[8] = {'P', 'G', 'G', 'R', 'T', 'B', '\0', '\1'};
+
+// Write `reg` as a mapped_registry table (a consistent snapshot of it).
+inline void write_mapped_registry(const string_registry& reg, std::ostream& os) {
+    if constexpr (std::endian::native != std::endian::little) {
+        throw std::runtime_error("mapped registry files are little-endian only");
+    }
+    std::vector<uint64_t> key_off{0};
+    std::vector<uint64_t> payload_off{0};
+    std::string keys;
+    std::string payloads;
+    reg.for_each(
+        [&](std::size_t n) {
+            key_off.reserve(n + 1);
+            payload_off.reserve(n + 1);
+        },
+        [&](string_registry::id_type, std::string_view key, const json_value& payload) {
+            keys += key;
+            payloads += payload.json;
+            key_off.push_back(keys.size());
+            payload_off.push_back(payloads.size());
+        });
+    const std::size_t n = key_off.size() - 1;
+    auto key_at = [&](uint32_t id) {
+        return std::string_view(keys).substr(key_off[id], key_off[id + 1] - key_off[id]);
+    };
+    std::vector<uint32_t> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), uint32_t{0});
+    std::sort(sorted.begin(), sorted.end(),
+              [&](uint32_t a, uint32_t b) { return key_at(a) < key_at(b); });
+
+    const uint64_t header[3] = {n, keys.size(), payloads.size()};
+    os.write(mapped_registry_magic, sizeof mapped_registry_magic);
+    os.write(reinterpret_cast<const char*>(header), sizeof header);
+    os.write(reinterpret_cast<const char*>(key_off.data()),
+             static_cast<std::streamsize>(key_off.size() * sizeof(uint64_t)));
+    os.write(reinterpret_cast<const char*>(payload_off.data()),
+             static_cast<std::streamsize>(payload_off.size() * sizeof(uint64_t)));
+    os.write(reinterpret_cast<const char*>(sorted.data()),
+             static_cast<std::streamsize>(n * sizeof(uint32_t)));
+    if (n % 2) os.write("\0\0\0\0", 4);
+    os.write(keys.data(), static_cast<std::streamsize>(keys.size()));
+    os.write(payloads.data(), static_cast<std::streamsize>(payloads.size()));
+}
+
+class mapped_registry {
+  public:
+    using id_type = string_registry::id_type;
+
+    static std::unique_ptr<mapped_registry> open(const std::string& path) {
+        if constexpr (std::endian::native != std::endian::little) {
+            throw std::runtime_error("mapped registry files are little-endian only");
+        }
+        auto reg = std::unique_ptr<mapped_registry>(new mapped_registry());
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open registry file: " + path);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to stat registry file: " + path);
+        }
+        reg->map_len_ = static_cast<std::size_t>(st.st_size);
+        if (reg->map_len_ < header_size) {
+            ::close(fd);
+            throw std::runtime_error("not a pygenogrove mapped registry file: " + path);
+        }
+        void* p = ::mmap(nullptr, reg->map_len_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            throw std::runtime_error("Failed to mmap registry file: " + path);
+        }
+        reg->map_ = p;
+        reg->index(path);
+        return reg;
+    }
+
+    ~mapped_registry() {
+        if (map_) ::munmap(map_, map_len_);
+    }
+    mapped_registry(const mapped_registry&) = delete;
+    mapped_registry& operator=(const mapped_registry&) = delete;
+
+    std::optional<id_type> find(std::string_view key) const {
+        const uint32_t* end = sorted_ + n_;
+        const uint32_t* it = std::partition_point(
+            sorted_, end, [&](uint32_t id) { return this->key(checked(id)) < key; });
+        if (it != end && this->key(checked(*it)) == key) return *it;
+        return std::nullopt;
+    }
+
+    bool contains(id_type id) const { return id < n_; }
+
+    std::string_view key(id_type id) const {
+        return slice(keys_, key_bytes_, key_off_, check(id));
+    }
+
+    json_value get(id_type id) const {
+        return json_value{std::string(slice(payloads_, payload_bytes_, payload_off_, check(id)))};
+    }
+
+    std::size_t size() const { return n_; }
+    bool empty() const { return n_ == 0; }
+    std::size_t mapped_bytes() const { return map_len_; }
+
+  private:
+    static constexpr std::size_t header_size = 4 * sizeof(uint64_t);
+
+    mapped_registry() = default;
+
+    void index(const std::string& path) {
+        const auto* base = static_cast<const char*>(map_);
+        uint64_t head[3];
+        std::memcpy(head, base + sizeof mapped_registry_magic, sizeof head);
+        const uint64_t n = head[0];
+        if (std::memcmp(base, mapped_registry_magic, sizeof mapped_registry_magic) != 0 ||
+            n >= string_registry::null_id) {
+            throw std::runtime_error("not a pygenogrove mapped registry file: " + path);
+        }
+        const uint64_t sorted_bytes = (n * sizeof(uint32_t) + 7) / 8 * 8;
+        const uint64_t keys_at = header_size + 2 * (n + 1) * sizeof(uint64_t) + sorted_bytes;
+        if (head[1] > map_len_ || head[2] > map_len_ ||
+            keys_at + head[1] + head[2] != map_len_) {
+            throw std::runtime_error("truncated or corrupt registry file: " + path);
+        }
+        n_ = static_cast<std::size_t>(n);
+        key_bytes_ = static_cast<std::size_t>(head[1]);
+        payload_bytes_ = static_cast<std::size_t>(head[2]);
+        key_off_ = reinterpret_cast<const uint64_t*>(base + header_size);
+        payload_off_ = key_off_ + n_ + 1;
+        sorted_ = reinterpret_cast<const uint32_t*>(payload_off_ + n_ + 1);
+        keys_ = base + keys_at;
+        payloads_ = keys_ + key_bytes_;
+    }
+
+    id_type check(id_type id) const {
+        if (id >= n_) {
+            throw std::out_of_range("registry id " + std::to_string(id) + " is not interned");
+        }
+        return id;
+    }
+
+    // An id read from the file itself; out of range means corruption.
+    id_type checked(uint32_t id) const {
+        if (id >= n_) throw std::runtime_error("corrupt registry file: bad sorted id");
+        return id;
+    }
+
+    static std::string_view slice(const char* blob, std::size_t bytes, const uint64_t* off,
+                                  id_type id) {
+        const uint64_t a = off[id];
+        const uint64_t b = off[id + 1];
+        if (a > b || b > bytes) throw std::runtime_error("corrupt registry file: bad offset");
+        return std::string_view(blob + a, static_cast<std::size_t>(b - a));
+    }
+
+    void* map_ = nullptr;
+    std::size_t map_len_ = 0;
+    std::size_t n_ = 0;
+    std::size_t key_bytes_ = 0;
+    std::size_t payload_bytes_ = 0;
+    const uint64_t* key_off_ = nullptr;
+    const uint64_t* payload_off_ = nullptr;
+    const uint32_t* sorted_ = nullptr;
+    const char* keys_ = nullptr;
+    const char* payloads_ = nullptr;
+};
+
+}  // namespace pygg
+
+// Registers MappedRegistry and Registry.write_mapped on the class bind_registry
+// returned.
+inline void bind_mapped_registry(
+    py::module_& m,
+    py::class_<pygg::string_registry, std::shared_ptr<pygg::string_registry>>& registry,
+    const char* name) {
+    using map_t = pygg::mapped_registry;
+    using id_type = map_t::id_type;
+
+    registry.def(
+        "write_mapped",
+        [](const pygg::string_registry& r, const std::string& path) {
+            std::ofstream os(path, std::ios::binary);
+            if (!os) {
+                throw std::runtime_error("Failed to open file for writing: " + path);
+            }
+            {
+                py::gil_scoped_release release;
+                pygg::write_mapped_registry(r, os);
+            }
+            if (!os) {
+                throw std::runtime_error("Failed to write registry to file: " + path);
+            }
+        },
+        py::arg("path"),
+        R"pbdoc(
+            Write the registry as a sorted string table that MappedRegistry(path)
+            opens in place, without loading it. Ids are preserved.
+        )pbdoc");
+
+    auto cls = py::class_<map_t>(m, name, R"pbdoc(
+        A read-only Registry backed by a memory-mapped file written with
+        Registry.write_mapped(). Opening maps the file without reading it, so a
+        huge dictionary opens instantly and is shared between processes through
+        the page cache. find(key) is a binary search over the sorted keys;
+        get(id) / key(id) read the entry in place. Ids match the registry the
+        file was written from.
+    )pbdoc");
+
+    cls.def(py::init([](const std::string& path) { return map_t::open(path); }),
+             py::arg("path"), "Map a file written with Registry.write_mapped().")
+        .def("find", [](const map_t& r, std::string_view key) { return r.find(key); },
+             py::arg("key"),
+             "Return the id for key if present, otherwise None.")
+        .def("get", [](const map_t& r, id_type id) { return r.get(id); },
+             py::arg("id"),
+             "Return the payload for id. Raises IndexError if id is invalid.")
+        .def("key", [](const map_t& r, id_type id) { return std::string(r.key(id)); },
+             py::arg("id"),
+             "Return the key interned as id. Raises IndexError if id is invalid.")
+        .def("contains", &map_t::contains, py::arg("id"),
+             "Whether id refers to a valid entry.")
+        .def("size", &map_t::size, "Number of entries.")
+        .def("__len__", &map_t::size)
+        .def("empty", &map_t::empty, "Whether the table has no entries.")
+        .def_property_readonly("mapped_bytes", &map_t::mapped_bytes,
+                               "Size of the mapped file in bytes.")
+        .def("to_registry",
+             [](const map_t& r) {
+                 auto out = std::make_shared<pygg::string_registry>();
+                 for (id_type id = 0; id < r.size(); ++id) out->intern(r.key(id), r.get(id));
+                 return out;
+             },
+             R"pbdoc(
+                 Copy the table into a new, writable Registry (same ids).
+             )pbdoc");
+    cls.attr("null_id") = pygg::string_registry::null_id;
+}
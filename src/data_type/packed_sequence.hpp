@@ -0,0 +1,394 @@
+/*
+ * PackedSequence — a DNA sequence at 2 bits per base (the gdt::kmer code:
+ * A=0, C=1, G=2, T=3), with the bases that are not A/C/G/T (N and other IUPAC
+ * codes) kept as a sorted run list beside it. 4x smaller than ASCII; case
+ * (soft-masking) and the exact ambiguity code are not kept — a masked base
+ * decodes as 'N'.
+ *
+ * The kernels work a 64-bit word at a time (SWAR): encoding classifies and
+ * packs 8 ASCII bases per step, GC counting is a popcount over 32 packed bases,
+ * and reverse complement is a byte table plus one bit shift. They need no
+ * target-specific flags, so the wheels stay portable.
+ *
+ * The rolling k-mer kernels (for_each_kmer over a packed sequence or over ASCII)
+ * emit gdt::kmer encodings (first base in the most significant bits) and are
+ * shared with KmerGrove.from_sequences and the k-mer counters.
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "byte_view.hpp"
+
+namespace py = pybind11;
+
+namespace pygg {
+
+// ASCII -> 2-bit code; 4 marks anything that is not A/C/G/T (either case).
+inline constexpr std::array<uint8_t, 256> base_code_table = [] {
+    std::array<uint8_t, 256> t{};
+    t.fill(4);
+    t['A'] = t['a'] = 0;
+    t['C'] = t['c'] = 1;
+    t['G'] = t['g'] = 2;
+    t['T'] = t['t'] = 3;
+    return t;
+}();
+
+inline void check_kmer_k(unsigned k) {
+    if (k == 0 || k > 32) {
+        throw std::invalid_argument("k must be in 1..32, got " + std::to_string(k));
+    }
+}
+
+// Rolling forward / reverse-complement k-mer state shared by both kernels.
+struct kmer_roller {
+    unsigned k;
+    uint64_t mask;
+    unsigned rc_shift;
+    uint64_t fw = 0;
+    uint64_t rc = 0;
+    unsigned filled = 0;  // valid bases since the last reset, saturating at k
+
+    explicit kmer_roller(unsigned k_)
+        : k(k_), mask(k_ == 32 ? ~uint64_t{0} : (uint64_t{1} << (2 * k_)) - 1),
+          rc_shift(2 * (k_ - 1)) {}
+
+    void reset() { filled = 0; }
+
+    // Push one base code (0..3); true once a full k-mer is in the window.
+    bool push(uint8_t c) {
+        fw = ((fw << 2) | c) & mask;
+        rc = (rc >> 2) | (uint64_t{3u - c} << rc_shift);
+        if (filled < k) ++filled;
+        return filled == k;
+    }
+
+    uint64_t value(bool canonical) const { return canonical ? std::min(fw, rc) : fw; }
+};
+
+// Mixes a k-mer encoding into a well-spread 64-bit hash (the splitmix64
+// finalizer): hash-table probing and partitioning, and the ordering of
+// minimizers and MinHash sketches. Stable across runs and platforms.
+inline uint64_t kmer_hash(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Every k-mer of an ASCII sequence that contains only A/C/G/T, as
+// fn(position, encoding); positions are offset by `origin` and only those that
+// are multiples of `step` are emitted.
+template <typename Fn>
+void for_each_kmer_ascii(std::string_view seq, unsigned k, bool canonical,
+                         std::size_t step, Fn&& fn, std::size_t origin = 0) {
+    kmer_roller roll(k);
+    for (std::size_t i = 0; i < seq.size(); ++i) {
+        const uint8_t c = base_code_table[static_cast<unsigned char>(seq[i])];
+        if (c > 3) {
+            roll.reset();
+            continue;
+        }
+        if (roll.push(c)) {
+            const std::size_t pos = origin + i + 1 - k;
+            if (pos % step == 0) fn(pos, roll.value(canonical));
+        }
+    }
+}
+
+namespace swar {
+
+inline constexpr uint64_t ones = 0x0101010101010101ULL;
+inline constexpr uint64_t high = 0x8080808080808080ULL;
+
+// 0x80 in every byte of v that is zero, 0x00 elsewhere (exact, no borrow).
+inline uint64_t zero_bytes(uint64_t v) {
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+    return ~(((v & low7) + low7) | v | low7);
+}
+
+// 0x80 in every byte that is A/C/G/T in either case.
+inline uint64_t acgt_bytes(uint64_t x) {
+    const uint64_t u = x & 0xDFDFDFDFDFDFDFDFULL;  // fold lowercase letters
+    return zero_bytes(u ^ ('A' * ones)) | zero_bytes(u ^ ('C' * ones)) |
+           zero_bytes(u ^ ('G' * ones)) | zero_bytes(u ^ ('T' * ones));
+}
+
+// Pack the 2-bit codes of 8 ASCII bases into 16 bits (base j at bits 2j).
+// ((c >> 1) ^ (c >> 2)) & 3 maps A/C/G/T (and a/c/g/t) to 0/1/2/3.
+inline uint16_t pack8(uint64_t x) {
+    uint64_t y = ((x >> 1) ^ (x >> 2)) & (3 * ones);
+    y = (y | (y >> 6)) & 0x000F000F000F000FULL;
+    y = (y | (y >> 12)) & 0x000000FF000000FFULL;
+    y = (y | (y >> 24)) & 0xFFFFULL;
+    return static_cast<uint16_t>(y);
+}
+
+}  // namespace swar
+
+struct packed_sequence {
+    std::string name;
+    std::size_t length = 0;
+    std::vector<uint8_t> bits;  // ceil(length / 4) bytes, base i at bits 2*(i%4)
+    // Sorted, disjoint [start, end) runs of non-A/C/G/T bases (packed as 0).
+    std::vector<std::pair<std::size_t, std::size_t>> n_runs;
+
+    uint8_t code(std::size_t i) const { return (bits[i >> 2] >> ((i & 3) * 2)) & 3; }
+
+    std::size_t n_count() const {
+        std::size_t n = 0;
+        for (const auto& [s, e] : n_runs) n += e - s;
+        return n;
+    }
+
+    static packed_sequence encode(std::string_view seq, std::string name = {}) {
+        static_assert(std::endian::native == std::endian::little,
+                      "pack8 assumes little-endian byte order");
+        packed_sequence p;
+        p.name = std::move(name);
+        p.length = seq.size();
+        p.bits.assign((seq.size() + 3) / 4, 0);
+        const char* s = seq.data();
+        std::size_t i = 0;
+        for (; i + 8 <= seq.size(); i += 8) {
+            uint64_t x;
+            std::memcpy(&x, s + i, 8);
+            uint16_t packed = swar::pack8(x);
+            const uint64_t ok = swar::acgt_bytes(x);
+            if (ok != swar::high) {
+                for (unsigned j = 0; j < 8; ++j) {
+                    if (!((ok >> (8 * j + 7)) & 1)) {
+                        packed &= static_cast<uint16_t>(~(3u << (2 * j)));
+                        p.mark_n(i + j);
+                    }
+                }
+            }
+            p.bits[i >> 2] = static_cast<uint8_t>(packed);
+            p.bits[(i >> 2) + 1] = static_cast<uint8_t>(packed >> 8);
+        }
+        for (; i < seq.size(); ++i) {
+            const uint8_t c = base_code_table[static_cast<unsigned char>(s[i])];
+            if (c > 3) {
+                p.mark_n(i);
+            } else {
+                p.bits[i >> 2] |= static_cast<uint8_t>(c << ((i & 3) * 2));
+            }
+        }
+        return p;
+    }
+
+    std::string decode() const {
+        static constexpr char letters[4] = {'A', 'C', 'G', 'T'};
+        std::string out(length, 'A');
+        for (std::size_t i = 0; i < length; ++i) out[i] = letters[code(i)];
+        for (const auto& [s, e] : n_runs) std::fill(out.begin() + s, out.begin() + e, 'N');
+        return out;
+    }
+
+    packed_sequence reverse_complement() const {
+        // Per byte: reverse the 4 codes and complement each (c ^ 3).
+        static constexpr std::array<uint8_t, 256> rc_byte = [] {
+            std::array<uint8_t, 256> t{};
+            for (unsigned b = 0; b < 256; ++b) {
+                unsigned r = 0;
+                for (unsigned j = 0; j < 4; ++j) r |= (((b >> (2 * j)) & 3) ^ 3) << (2 * (3 - j));
+                t[b] = static_cast<uint8_t>(r);
+            }
+            return t;
+        }();
+        packed_sequence r;
+        r.name = name;
+        r.length = length;
+        const std::size_t nb = bits.size();
+        r.bits.resize(nb);
+        for (std::size_t b = 0; b < nb; ++b) r.bits[nb - 1 - b] = rc_byte[bits[b]];
+        // The padding of the last byte now leads; shift it out.
+        const unsigned pad = static_cast<unsigned>(nb * 4 - length);
+        if (pad) {
+            const unsigned sh = 2 * pad;
+            for (std::size_t b = 0; b < nb; ++b) {
+                const unsigned next = b + 1 < nb ? r.bits[b + 1] : 0;
+                r.bits[b] = static_cast<uint8_t>((r.bits[b] >> sh) | (next << (8 - sh)));
+            }
+        }
+        r.n_runs.reserve(n_runs.size());
+        for (auto it = n_runs.rbegin(); it != n_runs.rend(); ++it) {
+            r.n_runs.emplace_back(length - it->second, length - it->first);
+            for (std::size_t i = length - it->second; i < length - it->first; ++i) {
+                r.bits[i >> 2] &= static_cast<uint8_t>(~(3u << ((i & 3) * 2)));
+            }
+        }
+        return r;
+    }
+
+    // Number of C/G bases (codes 1 and 2, i.e. the two bits differ). Masked
+    // bases and padding are packed as 0 and never count.
+    std::size_t gc_count() const {
+        const uint64_t lo = 0x5555555555555555ULL;
+        std::size_t gc = 0;
+        std::size_t b = 0;
+        for (; b + 8 <= bits.size(); b += 8) {
+            uint64_t w;
+            std::memcpy(&w, bits.data() + b, 8);
+            gc += static_cast<std::size_t>(std::popcount((w ^ (w >> 1)) & lo));
+        }
+        for (; b < bits.size(); ++b) {
+            gc += static_cast<std::size_t>(
+                std::popcount(static_cast<unsigned>((bits[b] ^ (bits[b] >> 1)) & 0x55)));
+        }
+        return gc;
+    }
+
+    // k-mers over unmasked stretches as fn(position, encoding).
+    template <typename Fn>
+    void for_each_kmer(unsigned k, bool canonical, std::size_t step, Fn&& fn) const {
+        kmer_roller roll(k);
+        auto run = n_runs.begin();
+        for (std::size_t i = 0; i < length; ++i) {
+            if (run != n_runs.end() && i >= run->first) {
+                roll.reset();
+                i = run->second - 1;
+                ++run;
+                continue;
+            }
+            if (roll.push(code(i))) {
+                const std::size_t pos = i + 1 - k;
+                if (pos % step == 0) fn(pos, roll.value(canonical));
+            }
+        }
+    }
+
+  private:
+    void mark_n(std::size_t i) {
+        if (!n_runs.empty() && n_runs.back().second == i) {
+            ++n_runs.back().second;
+        } else {
+            n_runs.emplace_back(i, i + 1);
+        }
+    }
+};
+
+}  // namespace pygg
+
+inline void bind_packed_sequence(py::module_& m) {
+    using ps_t = pygg::packed_sequence;
+
+    py::class_<ps_t>(m, "PackedSequence", R"pbdoc(
+        A DNA sequence packed at 2 bits per base (A=0, C=1, G=2, T=3 — the Kmer
+        encoding), with non-A/C/G/T bases (N, IUPAC codes) recorded as a sorted
+        run list. 4x smaller than ASCII; case is not kept and every masked base
+        decodes as 'N'.
+
+        Build one from a str / bytes, or without a Python str from
+        FastaEntry.to_packed(), FastaChunk.to_packed() or
+        FastaIndex.fetch_packed(). Immutable.
+    )pbdoc")
+        .def(py::init([](const std::string& sequence, std::string name) {
+                 py::gil_scoped_release release;
+                 return ps_t::encode(sequence, std::move(name));
+             }),
+             py::arg("sequence"), py::arg("name") = "",
+             "Encode an ASCII sequence (str or bytes).")
+        .def_readonly("name", &ps_t::name, "Sequence name (may be empty).")
+        .def("__len__", [](const ps_t& p) { return p.length; })
+        .def_property_readonly("nbytes",
+                               [](const ps_t& p) {
+                                   return p.bits.size() + p.n_runs.size() *
+                                                              sizeof(p.n_runs[0]);
+                               },
+                               "Bytes used by the packed bases plus the N-run list.")
+        .def_property_readonly(
+            "packed",
+            [](py::object self) {
+                const auto& p = self.cast<const ps_t&>();
+                return pygg::make_byte_view(self, p.bits.data(), p.bits.size());
+            },
+            "Read-only memoryview over the packed bytes (base i at bits "
+            "2*(i % 4) of byte i // 4; masked bases are 0).")
+        .def("n_count", &ps_t::n_count, "Number of masked (non-A/C/G/T) bases.")
+        .def("n_runs",
+             [](const ps_t& p) {
+                 py::array_t<int64_t> out(
+                     {static_cast<py::ssize_t>(p.n_runs.size()), py::ssize_t{2}});
+                 auto buf = out.mutable_unchecked<2>();
+                 for (std::size_t i = 0; i < p.n_runs.size(); ++i) {
+                     buf(i, 0) = static_cast<int64_t>(p.n_runs[i].first);
+                     buf(i, 1) = static_cast<int64_t>(p.n_runs[i].second);
+                 }
+                 return out;
+             },
+             "Masked runs as an int64 array shaped (runs, 2) of [start, end).")
+        .def("gc_count", &ps_t::gc_count, "Number of C/G bases.")
+        .def("gc_content",
+             [](const ps_t& p) {
+                 const std::size_t acgt = p.length - p.n_count();
+                 return acgt == 0 ? std::numeric_limits<double>::quiet_NaN()
+                                  : static_cast<double>(p.gc_count()) /
+                                        static_cast<double>(acgt);
+             },
+             "GC fraction over the unmasked bases (NaN if there are none).")
+        .def("reverse_complement", &ps_t::reverse_complement,
+             py::call_guard<py::gil_scoped_release>(),
+             "The reverse complement as a new PackedSequence (masked runs mirrored).")
+        .def("kmers",
+             [](const ps_t& p, unsigned k, bool canonical, std::size_t step,
+                bool positions) -> py::object {
+                 pygg::check_kmer_k(k);
+                 if (step == 0) throw std::invalid_argument("step must be positive");
+                 std::vector<uint64_t> enc;
+                 std::vector<int64_t> pos;
+                 {
+                     py::gil_scoped_release release;
+                     if (p.length >= k) enc.reserve((p.length - k) / step + 1);
+                     p.for_each_kmer(k, canonical, step, [&](std::size_t at, uint64_t e) {
+                         enc.push_back(e);
+                         if (positions) pos.push_back(static_cast<int64_t>(at));
+                     });
+                 }
+                 py::array_t<uint64_t> enc_arr(static_cast<py::ssize_t>(enc.size()));
+                 std::copy(enc.begin(), enc.end(), enc_arr.mutable_data());
+                 if (!positions) return std::move(enc_arr);
+                 py::array_t<int64_t> pos_arr(static_cast<py::ssize_t>(pos.size()));
+                 std::copy(pos.begin(), pos.end(), pos_arr.mutable_data());
+                 return py::make_tuple(std::move(enc_arr), std::move(pos_arr));
+             },
+             py::arg("k"), py::arg("canonical") = false, py::arg("step") = 1,
+             py::arg("positions") = false,
+             R"pbdoc(
+                 kmers(k, canonical=False, step=1, positions=False) -> numpy.ndarray
+
+                 Encodings (uint64, as Kmer.encoding) of every k-mer (1 <= k <=
+                 32) at positions that are multiples of `step`, skipping k-mers
+                 that touch a masked base. canonical=True yields min(k-mer,
+                 reverse complement). With positions=True, returns
+                 (encodings, int64 start positions).
+             )pbdoc")
+        .def("to_string", &ps_t::decode, py::call_guard<py::gil_scoped_release>(),
+             "Decode back to ASCII (uppercase; masked bases as 'N').")
+        .def("__str__", &ps_t::decode)
+        .def("__eq__",
+             [](const ps_t& a, const ps_t& b) {
+                 return a.length == b.length && a.bits == b.bits && a.n_runs == b.n_runs;
+             })
+        .def("__repr__", [](const ps_t& p) {
+            return "PackedSequence(name='" + p.name + "', len=" +
+                   std::to_string(p.length) + ", n=" + std::to_string(p.n_count()) + ")";
+        });
+}
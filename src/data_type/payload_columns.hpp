@@ -0,0 +1,434 @@
+/*
+ * payload_columns — interned string fields in JSON payloads. A grove declares
+ * payload fields (gene_id, biotype, source, …) whose string values are interned
+ * through a Registry: the stored JSON text holds the registry id, written as a
+ * decimal integer, in place of the quoted string, on every key payload and edge
+ * metadata of that grove (in memory and in its .gg). In memory such a payload
+ * also opens with a header member (json_value.hpp) holding the grove's columns
+ * handle and the ids in field order, so the json_value caster can expand the
+ * ids back to strings — key.data (and edge metadata) read exactly as inserted —
+ * and filtering on a field (column_id) reads one integer from the header: no
+ * scan of the payload's members, no JSON decode and no string compare.
+ *
+ * Payloads are json.dumps text, so a small scanner over the top-level object's
+ * members is enough to splice values in and out; nested values are skipped
+ * whole. Columns are attached per grove object (keyed by address, dropped when
+ * the Python grove is collected) and are fixed once declared. serialize() writes
+ * them, with the registry table, to a "<path>.columns" file beside the .gg.
+ */
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <genogrove/data_type/serialization_traits.hpp>
+
+#include "json_value.hpp"
+#include "registry.hpp"
+#include "side_table.hpp"
+
+namespace pygg {
+
+struct payload_columns {
+    std::vector<std::string> fields;
+    std::shared_ptr<string_registry> registry;
+    uint32_t handle = 0;  // what its payloads' headers name it by
+
+    // Position of `name` in fields, or -1.
+    int slot(std::string_view name) const {
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i] == name) return static_cast<int>(i);
+        }
+        return -1;
+    }
+};
+
+// Process-wide handle -> columns, so a payload names its grove's columns in its
+// own text instead of holding a pointer to them. Handles are never reused; an
+// entry expires with its columns.
+class columns_directory {
+  public:
+    static columns_directory& instance() {
+        static columns_directory directory;
+        return directory;
+    }
+
+    std::shared_ptr<payload_columns> make(std::vector<std::string> fields,
+                                          std::shared_ptr<string_registry> registry) {
+        auto cols = std::make_shared<payload_columns>();
+        cols->fields = std::move(fields);
+        cols->registry = std::move(registry);
+        std::lock_guard<std::mutex> lock(mu_);
+        cols->handle = static_cast<uint32_t>(entries_.size());
+        entries_.push_back(cols);
+        return cols;
+    }
+
+    std::shared_ptr<const payload_columns> find(uint64_t handle) const {
+        std::lock_guard<std::mutex> lock(mu_);
+        return handle < entries_.size() ? entries_[handle].lock() : nullptr;
+    }
+
+  private:
+    mutable std::mutex mu_;
+    std::vector<std::weak_ptr<const payload_columns>> entries_;
+};
+
+// ---- Minimal JSON scanning (top-level object members only) ----
+
+inline std::size_t json_skip_ws(std::string_view s, std::size_t i) {
+    while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\n' || s[i] == '\r')) {
+        ++i;
+    }
+    return i;
+}
+
+// i at an opening quote; returns the position just past the closing quote.
+inline std::size_t json_skip_string(std::string_view s, std::size_t i) {
+    for (++i; i < s.size(); ++i) {
+        if (s[i] == '\\') {
+            ++i;
+        } else if (s[i] == '"') {
+            return i + 1;
+        }
+    }
+    throw std::invalid_argument("malformed JSON payload: unterminated string");
+}
+
+// i at the start of a value; returns the position just past it.
+inline std::size_t json_skip_value(std::string_view s, std::size_t i) {
+    int depth = 0;
+    while (i < s.size()) {
+        const char c = s[i];
+        if (c == '"') {
+            i = json_skip_string(s, i);
+            if (depth == 0) return i;
+            continue;
+        }
+        if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) return i;
+            if (--depth == 0) return i + 1;
+        } else if (depth == 0 && (c == ',' || c == ' ' || c == '\t' || c == '\n' ||
+                                  c == '\r')) {
+            return i;
+        }
+        ++i;
+    }
+    return i;
+}
+
+inline void append_utf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// The string a JSON string literal's body (between the quotes) denotes.
+inline std::string json_unescape(std::string_view body) {
+    std::string out;
+    out.reserve(body.size());
+    auto hex4 = [&](std::size_t i) {
+        uint32_t v = 0;
+        if (i + 4 > body.size() ||
+            std::from_chars(body.data() + i, body.data() + i + 4, v, 16).ptr !=
+                body.data() + i + 4) {
+            throw std::invalid_argument("malformed JSON payload: bad \\u escape");
+        }
+        return v;
+    };
+    for (std::size_t i = 0; i < body.size(); ++i) {
+        if (body[i] != '\\') {
+            out += body[i];
+            continue;
+        }
+        if (++i >= body.size()) break;
+        switch (body[i]) {
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t cp = hex4(i + 1);
+                i += 4;
+                if (cp >= 0xD800 && cp < 0xDC00 && body.substr(i + 1, 2) == "\\u") {
+                    const uint32_t lo = hex4(i + 3);
+                    if (lo >= 0xDC00 && lo < 0xE000) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                        i += 6;
+                    }
+                }
+                append_utf8(out, cp);
+                break;
+            }
+            default: out += body[i];  // \" \\ \/
+        }
+    }
+    return out;
+}
+
+// fn(name_body, value_begin, value_end) for each member of a top-level JSON
+// object; name_body is the raw (still escaped) text between the name's quotes.
+// Returns false when the JSON is not an object.
+template <typename Fn>
+bool for_each_json_member(std::string_view s, Fn&& fn) {
+    auto at = [&](std::size_t i) { return i < s.size() ? s[i] : '\0'; };
+    std::size_t i = json_skip_ws(s, 0);
+    if (at(i) != '{') return false;
+    i = json_skip_ws(s, i + 1);
+    if (at(i) == '}') return true;
+    for (;;) {
+        if (at(i) != '"') throw std::invalid_argument("malformed JSON payload");
+        const std::size_t name_end = json_skip_string(s, i);
+        const std::string_view name = s.substr(i + 1, name_end - i - 2);
+        i = json_skip_ws(s, name_end);
+        if (at(i) != ':') throw std::invalid_argument("malformed JSON payload");
+        const std::size_t value = json_skip_ws(s, i + 1);
+        const std::size_t value_end = json_skip_value(s, value);
+        fn(name, value, value_end);
+        i = json_skip_ws(s, value_end);
+        if (at(i) == '}') return true;
+        if (at(i) != ',') throw std::invalid_argument("malformed JSON payload");
+        i = json_skip_ws(s, i + 1);
+    }
+}
+
+// fn(slot, value_begin, value_end) for each member naming an interned field.
+template <typename Fn>
+void for_each_column(const payload_columns& cols, std::string_view json, Fn&& fn) {
+    for_each_json_member(json, [&](std::string_view name, std::size_t b, std::size_t e) {
+        const int slot = name.find('\\') == std::string_view::npos
+                             ? cols.slot(name)
+                             : cols.slot(json_unescape(name));
+        if (slot >= 0) fn(static_cast<std::size_t>(slot), b, e);
+    });
+}
+
+inline std::optional<string_registry::id_type> parse_column_id(std::string_view text) {
+    string_registry::id_type id = 0;
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), id);
+    if (ec != std::errc() || ptr != text.data() + text.size()) return std::nullopt;
+    return id;
+}
+
+// ---- The in-memory header: {"\u0000":[handle,id0,id1,…],…} ----
+
+using column_ids = std::vector<std::optional<string_registry::id_type>>;
+
+// The header's entry n (0 = the handle, 1 + slot = that field's id or null).
+inline std::optional<std::string_view> columns_header_entry(std::string_view json,
+                                                            std::size_t n) {
+    const std::size_t end = columns_header_end(json);
+    if (end == 0) return std::nullopt;
+    const std::size_t close = end - 2;
+    std::size_t b = columns_header_open.size();
+    for (; n > 0; --n) {
+        b = json.find(',', b);
+        if (b >= close) return std::nullopt;
+        ++b;
+    }
+    return json.substr(b, std::min(json.find(',', b), close) - b);
+}
+
+inline void strip_columns_header(json_value& v) {
+    if (const std::size_t end = columns_header_end(v.json)) v.json.erase(1, end - 1);
+}
+
+// Prepend the header for `ids` to v, a JSON object holding an interned field.
+inline void put_columns_header(const payload_columns& cols, json_value& v,
+                               const column_ids& ids) {
+    std::string out(columns_header_open);
+    out += std::to_string(cols.handle);
+    for (const auto& id : ids) {
+        out += ',';
+        out += id ? std::to_string(*id) : "null";
+    }
+    out += "],";
+    out.append(v.json, 1, std::string::npos);
+    v.json = std::move(out);
+}
+
+inline void index_columns(const payload_columns& cols, json_value& v) {
+    strip_columns_header(v);
+    column_ids ids(cols.fields.size());
+    bool any = false;
+    for_each_column(cols, v.json, [&](std::size_t slot, std::size_t b, std::size_t e) {
+        ids[slot] = parse_column_id(std::string_view(v.json).substr(b, e - b));
+        any = any || ids[slot].has_value();
+    });
+    if (any) put_columns_header(cols, v, ids);
+}
+
+// Intern v's declared fields (str or null) and index their ids in its header.
+inline void encode_columns(const payload_columns& cols, json_value& v) {
+    strip_columns_header(v);
+    column_ids ids(cols.fields.size());
+    std::string out;
+    std::size_t copied = 0;
+    for_each_column(cols, v.json, [&](std::size_t slot, std::size_t b, std::size_t e) {
+        const std::string_view value = std::string_view(v.json).substr(b, e - b);
+        if (value == "null") return;
+        if (value.empty() || value.front() != '"') {
+            throw std::invalid_argument("interned payload field '" + cols.fields[slot] +
+                                        "' must be a str or None");
+        }
+        const std::string text = json_unescape(value.substr(1, value.size() - 2));
+        const auto id = cols.registry->intern(text, json_quote(text));
+        out.append(v.json, copied, b - copied);
+        out += std::to_string(id);
+        copied = e;
+        ids[slot] = id;
+    });
+    if (copied > 0) {
+        out.append(v.json, copied, std::string::npos);
+        v.json = std::move(out);
+        put_columns_header(cols, v, ids);
+    }
+}
+
+// v's text without its header, interned field ids replaced by their strings.
+inline std::string expanded_json(const json_value& v) {
+    const std::size_t end = columns_header_end(v.json);
+    if (end == 0) return v.json;
+    std::string body = '{' + v.json.substr(end);
+    const auto handle = parse_column_id(*columns_header_entry(v.json, 0));
+    const auto cols = handle ? columns_directory::instance().find(*handle) : nullptr;
+    if (!cols) return body;
+    std::string out;
+    std::size_t copied = 0;
+    for_each_column(*cols, body, [&](std::size_t, std::size_t b, std::size_t e) {
+        const auto id = parse_column_id(std::string_view(body).substr(b, e - b));
+        if (!id) return;  // null
+        out.append(body, copied, b - copied);
+        out += json_quote(cols->registry->key(*id)).json;
+        copied = e;
+    });
+    if (copied == 0) return body;
+    out.append(body, copied, std::string::npos);
+    return out;
+}
+
+// The id stored in v's interned field `slot`, or nullopt when absent / null —
+// read from v's header, without scanning its members.
+inline std::optional<string_registry::id_type> column_id(const payload_columns& cols,
+                                                          const json_value& v,
+                                                          std::size_t slot) {
+    const auto handle = columns_header_entry(v.json, 0);
+    if (!handle || parse_column_id(*handle) != cols.handle) return std::nullopt;
+    const auto id = columns_header_entry(v.json, slot + 1);
+    return id ? parse_column_id(*id) : std::nullopt;
+}
+
+// ---- Columns declared per grove object ----
+
+using grove_columns_table = object_side_table<const payload_columns, struct grove_columns_tag>;
+
+inline std::shared_ptr<const payload_columns> grove_columns(const void* grove) {
+    return grove_columns_table::instance().find(grove);
+}
+
+// Points loading_columns() at `columns` for the scope. A GroveView pages blocks
+// in during its queries, so every view call that can page runs inside one, and
+// the payloads it reads point at the view's columns as deserialize()'s do.
+class columns_scope {
+  public:
+    explicit columns_scope(const payload_columns* columns) : previous_(loading_columns()) {
+        loading_columns() = columns;
+    }
+    explicit columns_scope(const void* owner)
+        : held_(grove_columns(owner)), previous_(loading_columns()) {
+        loading_columns() = held_.get();
+    }
+    ~columns_scope() { loading_columns() = previous_; }
+    columns_scope(const columns_scope&) = delete;
+    columns_scope& operator=(const columns_scope&) = delete;
+
+  private:
+    std::shared_ptr<const payload_columns> held_;
+    const payload_columns* previous_;
+};
+
+// Encode a payload (or a batch) for `grove`; a no-op for typed payloads and
+// for groves without interned fields.
+template <typename DataT>
+void apply_columns(const void* grove, DataT& data) {
+    if constexpr (std::is_same_v<DataT, json_value>) {
+        if (auto cols = grove_columns(grove)) encode_columns(*cols, data);
+    }
+}
+
+template <typename KeyT, typename DataT>
+void apply_columns(const void* grove, std::vector<std::pair<KeyT, DataT>>& items) {
+    if constexpr (std::is_same_v<DataT, json_value>) {
+        if (auto cols = grove_columns(grove)) {
+            for (auto& item : items) encode_columns(*cols, item.second);
+        }
+    }
+}
+
+// ---- The "<path>.columns" file written beside a .gg ----
+
+inline constexpr char columns_file_magic[8] = {'P', 'G', 'G', 'C', 'O', 'L', '\0', '\1'};
+
+inline std::string columns_path(const std::string& gg_path) { return gg_path + ".columns"; }
+
+inline void write_columns(const std::string& path, const payload_columns& cols) {
+    using traits = genogrove::data_type::serialization_traits<std::string>;
+    std::ofstream os(path, std::ios::binary);
+    if (!os) throw std::runtime_error("Failed to open file for writing: " + path);
+    os.write(columns_file_magic, sizeof columns_file_magic);
+    const uint64_t n = cols.fields.size();
+    os.write(reinterpret_cast<const char*>(&n), sizeof n);
+    for (const auto& f : cols.fields) traits::serialize(os, f);
+    cols.registry->serialize(os);
+    if (!os) throw std::runtime_error("Failed to write interned fields to file: " + path);
+}
+
+// The columns stored beside `gg_path`, or null when it has none.
+inline std::shared_ptr<payload_columns> read_columns(const std::string& gg_path) {
+    using traits = genogrove::data_type::serialization_traits<std::string>;
+    const std::string path = columns_path(gg_path);
+    std::ifstream is(path, std::ios::binary);
+    if (!is) return nullptr;
+    char magic[sizeof columns_file_magic];
+    uint64_t n = 0;
+    if (!is.read(magic, sizeof magic) ||
+        std::memcmp(magic, columns_file_magic, sizeof magic) != 0 ||
+        !is.read(reinterpret_cast<char*>(&n), sizeof n)) {
+        throw std::runtime_error("not a pygenogrove interned-fields file: " + path);
+    }
+    std::vector<std::string> fields;
+    for (uint64_t i = 0; i < n; ++i) fields.push_back(traits::deserialize(is));
+    auto registry = std::make_shared<string_registry>();
+    registry->deserialize(is);
+    return columns_directory::instance().make(std::move(fields), std::move(registry));
+}
+
+}  // namespace pygg
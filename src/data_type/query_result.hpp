@@ -2,15 +2,20 @@
  * Binding for gdt::query_result<KeyT, DataT> — the container returned by
  * Grove.intersect(). Mirrors genogrove data_type/query_result.hpp. Generic over
  * the key type KeyT (instantiated per concrete key type from the grove binding).
+ * Payload-specific vectorized accessors (genotypes() on VariantQueryResult) are
+ * switched on the data type with `if constexpr`.
  */
 #pragma once
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <vector>
+
 #include <genogrove/data_type/query_result.hpp>
 
 #include "key_list.hpp"
+#include "variant_genotypes.hpp"
 
 namespace py = pybind11;
 namespace gdt = genogrove::data_type;
@@ -19,7 +24,7 @@ template <typename KeyT, typename DataT>
 void bind_query_result(py::module_& m, const char* name) {
     using qr_t = gdt::query_result<KeyT, DataT>;
 
-    py::class_<qr_t>(m, name, R"pbdoc(
+    auto cls = py::class_<qr_t>(m, name, R"pbdoc(
         Result of an intersect() query: the query interval plus the matching keys.
     )pbdoc")
         .def_property_readonly("query", &qr_t::get_query,
@@ -38,4 +43,27 @@ void bind_query_result(py::module_& m, const char* name) {
         .def("__iter__", [](const qr_t& qr) {
             return py::make_iterator(qr.get_keys().begin(), qr.get_keys().end());
         }, py::keep_alive<0, 1>());
-}
\ No newline at end of file
+
+    // ---- Genotype matrix (VariantQueryResult only) ----
+    if constexpr (has_packed_genotypes<DataT>) {
+        cls.def("genotypes",
+                [](const qr_t& qr) {
+                    std::vector<const DataT*> payloads;
+                    payloads.reserve(qr.get_keys().size());
+                    for (auto* k : qr.get_keys()) {
+                        payloads.push_back(&k->get_data());
+                    }
+                    const std::size_t width =
+                        payloads.empty() ? 0 : payloads.front()->n_samples;
+                    return genotype_matrix(payloads, width);
+                },
+                R"pbdoc(
+                    genotypes() -> numpy.ndarray
+
+                    The hits' genotypes as one int8 dosage matrix shaped
+                    (hits, samples), rows in result order (0 / 1 / 2, -1 =
+                    missing). Raises ValueError if the hits were packed with
+                    different sample counts.
+                )pbdoc");
+    }
+}
@@ -1,67 +1,469 @@
 /*
- * Binding for gdt::registry<Key, Tag, Payload> — a process-wide singleton that
- * interns values into small stable integer ids. Mirrors genogrove
- * data_type/registry.hpp.
+ * Registry — interns string identities (gene_id / chrom / transcript_id / read
+ * names) into small stable integer ids, each mapped to a JSON payload. The
+ * interface follows genogrove's gdt::registry<std::string, void, json_value>
+ * (intern / find / get / contains / instance / reset / null_id), but the
+ * storage is pygenogrove's own so it can be shared by many threads:
  *
- * Generic over the registry type: instantiated per concrete (Key[, Tag, Payload])
- * from bindings.cpp. The single-arg vs (key, payload) intern() form is switched
- * on registry::key_is_payload with `if constexpr`. The Tag template parameter is
- * a C++ compile-time discriminator for independent same-type pools; it has no
- * Python analogue, so Python sees one default-tag singleton per bound class.
+ *   - the key -> id map is split into shards, each behind its own reader/writer
+ *     lock, so concurrent interns of different keys rarely contend and lookups
+ *     of existing keys only take a shared lock;
+ *   - entries live in append-only segments that never move once allocated
+ *     (segment s holds base << s entries), so get(id) is lock-free and the
+ *     references it hands out stay valid while entries are added;
+ *   - ids are assigned once and never change. A single thread interning in
+ *     order gets 0, 1, 2, …; intern_many assigns new ids in input order, exactly
+ *     as a loop of intern() would, while hashing and probing in parallel.
+ *
+ * instance() is the process-wide registry; independently constructed registries
+ * keep their own id namespaces. clear() / deserialize() replace the whole table
+ * and must not race with lookups on the same registry (interns are excluded by a
+ * registry-wide lock). mapped_registry.hpp holds the read-only, memory-mapped
+ * form of a registry.
  */
 #pragma once
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>  // std::optional<id> -> int | None
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <genogrove/data_type/serialization_traits.hpp>
 
-#include <genogrove/data_type/registry.hpp>
+#include "json_value.hpp"
 
 namespace py = pybind11;
-namespace gdt = genogrove::data_type;
 
-template <typename Key, typename Tag = void, typename Payload = Key>
-py::class_<gdt::registry<Key, Tag, Payload>>
+namespace pygg {
+
+class string_registry {
+public:
+    using id_type = uint32_t;
+    static constexpr id_type null_id = std::numeric_limits<id_type>::max();
+
+    string_registry() = default;
+    string_registry(const string_registry&) = delete;
+    string_registry& operator=(const string_registry&) = delete;
+    ~string_registry() { release(); }
+
+    static string_registry& instance() {
+        static string_registry registry;
+        return registry;
+    }
+
+    // The singleton as a (non-owning) shared_ptr, the holder Python sees.
+    static std::shared_ptr<string_registry> shared_instance() {
+        static const std::shared_ptr<string_registry> registry(&instance(),
+                                                               [](string_registry*) {});
+        return registry;
+    }
+
+    // key's id, interning key -> payload first if absent (first write wins).
+    id_type intern(std::string_view key, const json_value& payload) {
+        std::shared_lock<std::shared_mutex> batch(batch_mu_);
+        const std::size_t h = hash(key);
+        shard& sh = shards_[shard_of(h)];
+        {
+            std::shared_lock<std::shared_mutex> read(sh.mu);
+            if (auto it = sh.map.find(key); it != sh.map.end()) return it->second;
+        }
+        std::unique_lock<std::shared_mutex> write(sh.mu);
+        if (auto it = sh.map.find(key); it != sh.map.end()) return it->second;
+        const id_type id = allocate(1);
+        entry& e = publish(id, key, payload);
+        sh.map.emplace(std::string_view(e.key), id);
+        return id;
+    }
+
+    // Ids for keys (in order), interning absent ones; make_payload(key) builds a
+    // new entry's payload. New ids follow first occurrence in `keys`.
+    template <typename MakePayload>
+    std::vector<id_type> intern_many(const std::vector<std::string_view>& keys,
+                                     unsigned threads, MakePayload&& make_payload) {
+        std::unique_lock<std::shared_mutex> batch(batch_mu_);
+        const std::size_t n = keys.size();
+        std::vector<id_type> ids(n, null_id);
+        if (n == 0) return ids;
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        if (n < parallel_threshold) threads = 1;
+
+        // Bucket input positions by shard (stable, so each bucket is ascending).
+        std::vector<uint8_t> shard_ix(n);
+        parallel_for(threads, n, [&](std::size_t i) {
+            shard_ix[i] = static_cast<uint8_t>(shard_of(hash(keys[i])));
+        });
+        std::array<std::size_t, shard_count + 1> start{};
+        for (uint8_t s : shard_ix) ++start[s + 1];
+        for (std::size_t s = 0; s < shard_count; ++s) start[s + 1] += start[s];
+        std::vector<std::size_t> order(n);
+        {
+            auto fill = start;
+            for (std::size_t i = 0; i < n; ++i) order[fill[shard_ix[i]]++] = i;
+        }
+
+        // Per shard: resolve existing keys, and map every occurrence of a new
+        // key to its first position. Shards are disjoint, so workers don't share.
+        std::vector<std::size_t> first(n);
+        std::vector<std::vector<std::size_t>> fresh(shard_count);
+        parallel_for(threads, shard_count, [&](std::size_t s) {
+            const shard& sh = shards_[s];
+            std::unordered_map<std::string_view, std::size_t> seen;
+            for (std::size_t o = start[s]; o < start[s + 1]; ++o) {
+                const std::size_t i = order[o];
+                if (auto it = sh.map.find(keys[i]); it != sh.map.end()) {
+                    ids[i] = it->second;
+                    continue;
+                }
+                auto [it, inserted] = seen.emplace(keys[i], i);
+                first[i] = it->second;
+                if (inserted) fresh[s].push_back(i);
+            }
+        });
+
+        // New ids in order of first occurrence.
+        std::vector<std::size_t> firsts;
+        for (const auto& f : fresh) firsts.insert(firsts.end(), f.begin(), f.end());
+        std::sort(firsts.begin(), firsts.end());
+        if (!firsts.empty()) {
+            const id_type base = allocate(firsts.size());
+            parallel_for(threads, firsts.size(), [&](std::size_t r) {
+                const std::size_t i = firsts[r];
+                ids[i] = base + static_cast<id_type>(r);
+                publish(ids[i], keys[i], make_payload(keys[i]));
+            });
+            parallel_for(threads, shard_count, [&](std::size_t s) {
+                if (fresh[s].empty()) return;
+                shard& sh = shards_[s];
+                std::unique_lock<std::shared_mutex> write(sh.mu);
+                for (std::size_t i : fresh[s]) {
+                    sh.map.emplace(std::string_view(at(ids[i]).key), ids[i]);
+                }
+            });
+            parallel_for(threads, n, [&](std::size_t i) {
+                if (ids[i] == null_id) ids[i] = ids[first[i]];
+            });
+        }
+        return ids;
+    }
+
+    std::optional<id_type> find(std::string_view key) const {
+        const shard& sh = shards_[shard_of(hash(key))];
+        std::shared_lock<std::shared_mutex> read(sh.mu);
+        if (auto it = sh.map.find(key); it != sh.map.end()) return it->second;
+        return std::nullopt;
+    }
+
+    bool contains(id_type id) const { return lookup(id) != nullptr; }
+
+    const json_value& get(id_type id) const {
+        if (const entry* e = lookup(id)) return e->payload;
+        throw std::out_of_range("registry id " + std::to_string(id) + " is not interned");
+    }
+
+    const std::string& key(id_type id) const {
+        if (const entry* e = lookup(id)) return e->key;
+        throw std::out_of_range("registry id " + std::to_string(id) + " is not interned");
+    }
+
+    std::size_t size() const { return size_.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+
+    void clear() {
+        std::unique_lock<std::shared_mutex> batch(batch_mu_);
+        for (auto& sh : shards_) {
+            std::unique_lock<std::shared_mutex> write(sh.mu);
+            sh.map.clear();
+        }
+        release();
+    }
+
+    // begin(n) once, then fn(id, key, payload) for every entry in id order — a
+    // consistent snapshot, with interns excluded throughout.
+    template <typename Begin, typename Fn>
+    void for_each(Begin&& begin, Fn&& fn) const {
+        std::unique_lock<std::shared_mutex> batch(batch_mu_);
+        const std::size_t n = size();
+        begin(n);
+        for (std::size_t id = 0; id < n; ++id) {
+            const entry& e = at(static_cast<id_type>(id));
+            fn(static_cast<id_type>(id), std::string_view(e.key), e.payload);
+        }
+    }
+
+    // gdt::registry's layout — a uint64 entry count, then each key and payload
+    // through serialization_traits in id order — so files stay interchangeable
+    // with genogrove and with earlier pygenogrove releases.
+    void serialize(std::ostream& os) const {
+        using traits = genogrove::data_type::serialization_traits<std::string>;
+        for_each(
+            [&](std::size_t count) {
+                const uint64_t n = count;
+                os.write(reinterpret_cast<const char*>(&n), sizeof n);
+            },
+            [&](id_type, std::string_view key, const json_value& payload) {
+                traits::serialize(os, std::string(key));
+                payload.serialize(os);
+            });
+    }
+
+    // Replace the contents with a serialize()d table; ids are preserved. Also
+    // reads the magic-prefixed files of the interim "PGGREG" format.
+    void deserialize(std::istream& is) {
+        using traits = genogrove::data_type::serialization_traits<std::string>;
+        char head[sizeof pggreg_magic];
+        uint64_t n = 0;
+        if (!is.read(head, sizeof head)) {
+            throw std::runtime_error("not a registry file");
+        }
+        if (std::memcmp(head, pggreg_magic, sizeof head) == 0) {
+            if (!is.read(reinterpret_cast<char*>(&n), sizeof n)) {
+                throw std::runtime_error("truncated registry file");
+            }
+        } else {
+            std::memcpy(&n, head, sizeof n);
+        }
+        if (n > null_id) throw std::runtime_error("not a registry file");
+        clear();
+        for (uint64_t id = 0; id < n; ++id) {
+            std::string k = traits::deserialize(is);
+            json_value payload = json_value::deserialize(is);
+            if (!is) throw std::runtime_error("truncated registry file");
+            intern(k, payload);
+        }
+    }
+
+private:
+    static constexpr std::size_t shard_count = 64;
+    static constexpr std::size_t segment_base = 1024;
+    static constexpr std::size_t segment_count = 23;  // covers every 32-bit id
+    static constexpr std::size_t parallel_threshold = std::size_t{1} << 14;
+    // Header of the interim format, which prefixed the gdt::registry layout.
+    static constexpr char pggreg_magic[8] = {'P', 'G', 'G', 'R', 'E', 'G', '\0', '\1'};
+
+    struct entry {
+        std::string key;
+        json_value payload;
+        std::atomic<bool> ready{false};
+    };
+
+    struct shard {
+        mutable std::shared_mutex mu;
+        std::unordered_map<std::string_view, id_type> map;  // views into entries
+    };
+
+    static std::size_t hash(std::string_view key) {
+        return std::hash<std::string_view>{}(key);
+    }
+    static std::size_t shard_of(std::size_t h) {
+        return static_cast<std::size_t>((uint64_t{h} * 0x9e3779b97f4a7c15ULL) >> 58);
+    }
+
+    // Segment s covers ids [base * (2^s - 1), base * (2^(s+1) - 1)).
+    static std::size_t segment_of(id_type id) {
+        return static_cast<std::size_t>(std::bit_width(id / segment_base + 1)) - 1;
+    }
+    static std::size_t segment_offset(id_type id, std::size_t s) {
+        return id - segment_base * ((std::size_t{1} << s) - 1);
+    }
+
+    id_type allocate(std::size_t n) {
+        const std::size_t first = next_.fetch_add(n, std::memory_order_relaxed);
+        if (first + n > null_id) {
+            next_.fetch_sub(n, std::memory_order_relaxed);
+            throw std::length_error("registry is full (2^32 - 1 ids)");
+        }
+        return static_cast<id_type>(first);
+    }
+
+    entry& at(id_type id) const {
+        const std::size_t s = segment_of(id);
+        return segments_[s].load(std::memory_order_acquire)[segment_offset(id, s)];
+    }
+
+    entry& slot(id_type id) {
+        const std::size_t s = segment_of(id);
+        entry* seg = segments_[s].load(std::memory_order_acquire);
+        if (!seg) {
+            auto fresh = std::make_unique<entry[]>(segment_base << s);
+            if (segments_[s].compare_exchange_strong(seg, fresh.get(),
+                                                     std::memory_order_acq_rel)) {
+                seg = fresh.release();
+            }
+        }
+        return seg[segment_offset(id, s)];
+    }
+
+    entry& publish(id_type id, std::string_view key, json_value payload) {
+        entry& e = slot(id);
+        e.key.assign(key);
+        e.payload = std::move(payload);
+        e.ready.store(true, std::memory_order_release);
+        size_.fetch_add(1, std::memory_order_acq_rel);
+        return e;
+    }
+
+    const entry* lookup(id_type id) const {
+        if (id >= next_.load(std::memory_order_acquire)) return nullptr;
+        const std::size_t s = segment_of(id);
+        const entry* seg = segments_[s].load(std::memory_order_acquire);
+        if (!seg) return nullptr;
+        const entry& e = seg[segment_offset(id, s)];
+        return e.ready.load(std::memory_order_acquire) ? &e : nullptr;
+    }
+
+    void release() {
+        for (auto& seg : segments_) delete[] seg.exchange(nullptr);
+        next_.store(0);
+        size_.store(0);
+    }
+
+    template <typename Fn>
+    static void parallel_for(unsigned threads, std::size_t n, Fn&& fn) {
+        if (threads <= 1 || n < 2) {
+            for (std::size_t i = 0; i < n; ++i) fn(i);
+            return;
+        }
+        std::vector<std::thread> workers;
+        const std::size_t t_count = std::min<std::size_t>(threads, n);
+        for (std::size_t t = 0; t < t_count; ++t) {
+            workers.emplace_back([&, t] {
+                for (std::size_t i = n * t / t_count; i < n * (t + 1) / t_count; ++i) fn(i);
+            });
+        }
+        for (auto& w : workers) w.join();
+    }
+
+    // shared: intern(); exclusive: intern_many / clear / serialize
+    mutable std::shared_mutex batch_mu_;
+    std::array<shard, shard_count> shards_;
+    std::array<std::atomic<entry*>, segment_count> segments_{};
+    std::atomic<std::size_t> next_{0};
+    std::atomic<std::size_t> size_{0};
+};
+
+// Keys for intern_many: a list / iterable of str (or bytes), or a contiguous 1-D
+// NumPy bytes ('S') array read in place. `storage` owns converted strings.
+inline std::vector<std::string_view> registry_keys(py::handle values,
+                                                   std::vector<std::string>& storage) {
+    std::vector<std::string_view> keys;
+    if (py::isinstance<py::array>(values)) {
+        auto arr = py::reinterpret_borrow<py::array>(values);
+        if (arr.dtype().kind() == 'S' && arr.ndim() == 1 &&
+            (arr.flags() & py::array::c_style)) {
+            const auto width = static_cast<std::size_t>(arr.itemsize());
+            const char* base = static_cast<const char*>(arr.data());
+            keys.reserve(static_cast<std::size_t>(arr.size()));
+            for (py::ssize_t i = 0; i < arr.size(); ++i) {
+                const char* item = base + static_cast<std::size_t>(i) * width;
+                const char* end = std::find(item, item + width, '\0');  // NUL-padded
+                keys.emplace_back(item, static_cast<std::size_t>(end - item));
+            }
+            return keys;
+        }
+    }
+    for (py::handle v : values) storage.push_back(v.cast<std::string>());
+    keys.assign(storage.begin(), storage.end());
+    return keys;
+}
+
+}  // namespace pygg
+
+// Held by shared_ptr so a grove's interned payload fields can share a registry
+// with Python (see payload_columns.hpp).
+inline py::class_<pygg::string_registry, std::shared_ptr<pygg::string_registry>>
 bind_registry(py::module_& m, const char* name) {
-    using reg_t = gdt::registry<Key, Tag, Payload>;
-    using id_type = typename reg_t::id_type;
+    using reg_t = pygg::string_registry;
+    using id_type = reg_t::id_type;
+
+    auto cls = py::class_<reg_t, std::shared_ptr<reg_t>>(m, name, R"pbdoc(
+        Interns values into small, stable integer ids (deduplicated).
+        instance() is the process-wide singleton; Registry() creates an
+        independent registry with its own id namespace.
 
-    auto cls = py::class_<reg_t>(m, name, R"pbdoc(
-        A process-wide singleton that interns values into small, stable integer
-        ids (deduplicated). Access the single instance with instance().
+        Thread-safe: intern / find / get may be called from many threads at
+        once (the key map is sharded; stored entries never move). Ids are
+        stable — once assigned, an id never changes.
 
-        Global state — use reset() (or clear()) to wipe it, e.g. between tests.
+        The singleton is global state — use reset() (or clear()) to wipe it,
+        e.g. between tests.
     )pbdoc");
 
-    cls.def_static("instance", &reg_t::instance,
-                   py::return_value_policy::reference,
+    cls.def(py::init<>(),
+            "Create an empty registry, independent of the singleton.");
+    cls.def_static("instance", &reg_t::shared_instance,
                    "Return the process-wide singleton instance.");
 
-    if constexpr (reg_t::key_is_payload) {
-        cls.def("intern",
-                [](reg_t& r, const Key& value) { return r.intern(value); },
-                py::arg("value"),
-                R"pbdoc(
-                    Intern a value and return its stable integer id. Idempotent:
-                    the same value always returns the same id (deduplicated).
-                )pbdoc");
-    } else {
-        cls.def("intern",
-                [](reg_t& r, const Key& key, const Payload& payload) {
-                    return r.intern(key, payload);
-                },
-                py::arg("key"), py::arg("payload"),
-                R"pbdoc(
-                    Intern key -> payload and return key's stable id. First write
-                    wins: re-interning an existing key keeps its original payload.
-                )pbdoc");
-    }
+    cls.def("intern",
+            [](reg_t& r, std::string_view key, const pygg::json_value& payload) {
+                return r.intern(key, payload);
+            },
+            py::arg("key"), py::arg("payload"),
+            R"pbdoc(
+                Intern key -> payload and return key's stable id. First write
+                wins: re-interning an existing key keeps its original payload.
+            )pbdoc")
+       .def("intern",
+            [](reg_t& r, std::string_view value) {
+                return r.intern(value, pygg::json_quote(value));
+            },
+            py::arg("value"),
+            R"pbdoc(
+                Intern a string as both key and payload and return its stable id.
+                Idempotent (deduplicated); get(id) returns the string back.
+                Convenience for plain string interning — use intern(key, payload)
+                to attach a distinct JSON payload.
+            )pbdoc")
+       .def("intern_many",
+            [](reg_t& r, py::handle values, unsigned threads) {
+                std::vector<std::string> storage;
+                const auto keys = pygg::registry_keys(values, storage);
+                std::vector<id_type> ids;
+                {
+                    py::gil_scoped_release release;
+                    ids = r.intern_many(keys, threads, [](std::string_view k) {
+                        return pygg::json_quote(k);
+                    });
+                }
+                py::array_t<id_type> out(static_cast<py::ssize_t>(ids.size()));
+                std::copy(ids.begin(), ids.end(), out.mutable_data());
+                return out;
+            },
+            py::arg("values"), py::arg("threads") = 0,
+            R"pbdoc(
+                intern_many(values, threads=0) -> numpy.ndarray[uint32]
+
+                Intern every string of `values` (a list / iterable of str, or a
+                NumPy bytes array, read in place) as its own payload, like
+                intern(value) per element, and return their ids. Hashing and
+                lookups run on `threads` workers (0: all cores) with the GIL
+                released; new ids are assigned in input order, so the result is
+                identical to interning one by one.
+            )pbdoc");
 
     cls.def("find",
-            [](const reg_t& r, const Key& key) { return r.find(key); },
+            [](const reg_t& r, std::string_view key) { return r.find(key); },
             py::arg("key"),
             "Return the id for key if interned, otherwise None. Does not insert.")
        .def("get",
@@ -77,7 +479,7 @@ bind_registry(py::module_& m, const char* name) {
        .def("empty", &reg_t::empty, "Whether the registry has no entries.")
        .def("clear", &reg_t::clear,
             "Remove all interned data; ids restart from 0 afterward.")
-       .def_static("reset", &reg_t::reset,
+       .def_static("reset", [] { reg_t::instance().clear(); },
                    "Clear the singleton (convenience for e.g. test isolation; "
                    "equivalent to instance().clear()).");
 
@@ -96,17 +498,31 @@ bind_registry(py::module_& m, const char* name) {
             },
             py::arg("path"),
             "Serialize the registry's (key, payload) entries to a binary file.")
+       .def("load",
+            [](reg_t& r, const std::string& path) {
+                std::ifstream is(path, std::ios::binary);
+                if (!is) {
+                    throw std::runtime_error(
+                        "Failed to open file for reading: " + path);
+                }
+                r.deserialize(is);
+            },
+            py::arg("path"),
+            R"pbdoc(
+                Replace this registry's entries with those of a file written by
+                serialize(); ids are preserved.
+            )pbdoc")
        .def_static("deserialize",
-            [](const std::string& path) -> reg_t& {
+            [](const std::string& path) {
                 std::ifstream is(path, std::ios::binary);
                 if (!is) {
                     throw std::runtime_error(
                         "Failed to open file for reading: " + path);
                 }
-                return reg_t::deserialize(is);
+                reg_t::instance().deserialize(is);
+                return reg_t::shared_instance();
             },
             py::arg("path"),
-            py::return_value_policy::reference,
             R"pbdoc(
                 Load entries from a file written with serialize() INTO the
                 singleton (replacing its current data) and return it.
@@ -115,7 +531,5 @@ bind_registry(py::module_& m, const char* name) {
     // Sentinel id (= max uint32) returned where "no id" is meaningful.
     cls.attr("null_id") = reg_t::null_id;
 
-    // Returned so the caller can graft instantiation-specific conveniences
-    // (e.g. a single-arg string-intern overload on the json_value payload form).
     return cls;
-}
\ No newline at end of file
+}
@@ -0,0 +1,95 @@
+/*
+ * object_side_table — state pygenogrove attaches to a grove / view object that
+ * genogrove's types have no slot for (interned payload columns, a frozen CSR
+ * graph, the live KeyHandles). Entries are keyed by the C++ object's address
+ * and dropped by a weakref callback when the Python object wrapping it is
+ * collected, so a reused address never sees a stale entry.
+ *
+ * One process-wide table per (T, Tag). find() is a relaxed atomic load when the
+ * table holds nothing, so objects that never use the feature pay no lock.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace py = pybind11;
+
+namespace pygg {
+
+template <typename T, typename Tag>
+class object_side_table {
+  public:
+    static object_side_table& instance() {
+        static object_side_table table;
+        return table;
+    }
+
+    std::shared_ptr<T> find(const void* owner) const {
+        if (count_.load(std::memory_order_acquire) == 0) return nullptr;
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = table_.find(owner);
+        return it == table_.end() ? nullptr : it->second;
+    }
+
+    // Store `value` for the object wrapped by `self` unless it already holds
+    // one; returns the value held afterwards.
+    std::shared_ptr<T> try_attach(py::handle self, const void* owner,
+                                  std::shared_ptr<T> value) {
+        return store(self, owner, std::move(value), false);
+    }
+
+    // Store `value` for the object wrapped by `self`, replacing any held one.
+    void attach(py::handle self, const void* owner, std::shared_ptr<T> value) {
+        store(self, owner, std::move(value), true);
+    }
+
+    // Drop the held value but keep the entry, whose lifetime the weakref owns.
+    void reset(const void* owner) {
+        if (count_.load(std::memory_order_acquire) == 0) return;
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = table_.find(owner);
+        if (it != table_.end() && it->second) {
+            it->second.reset();
+            count_.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+  private:
+    std::shared_ptr<T> store(py::handle self, const void* owner, std::shared_ptr<T> value,
+                             bool replace) {
+        std::shared_ptr<T> held;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            auto [it, fresh] = table_.try_emplace(owner);
+            if (it->second && !replace) return it->second;
+            if (!it->second) count_.fetch_add(1, std::memory_order_release);
+            it->second = std::move(value);
+            held = it->second;
+            if (!fresh) return held;
+        }
+        py::cpp_function drop([this, owner](py::handle ref) {
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                auto it = table_.find(owner);
+                if (it->second) count_.fetch_sub(1, std::memory_order_release);
+                table_.erase(it);
+            }
+            ref.dec_ref();
+        });
+        py::weakref(self, drop).release();
+        return held;
+    }
+
+    mutable std::mutex mu_;
+    std::unordered_map<const void*, std::shared_ptr<T>> table_;
+    std::atomic<std::size_t> count_{0};  // entries holding a value
+};
+
+}  // namespace pygg
@@ -0,0 +1,249 @@
+/*
+ * variant_genotypes — the compact typed payload of `VariantGrove`
+ * (grove<genomic_coordinate, variant_genotypes>).
+ *
+ * One VCF record's REF/ALT plus every sample's genotype packed 2 bits per
+ * sample (0 = hom-ref, 1 = het, 2 = hom-alt / multi-copy alt, 3 = missing), with
+ * optional saturating 8-bit GQ / DP columns. A 5,000-sample site costs ~1.25 KB
+ * of genotypes instead of a JSON document per sample. Phase and the identity of
+ * the ALT allele in multi-allelic calls are not kept — the dosage is the count of
+ * non-REF alleles, capped at 2.
+ *
+ * Serialized as a flat binary record via the member serialize()/deserialize()
+ * pair genogrove calls for user payloads (like json_value), so a VariantGrove
+ * round-trips through .gg and opens as a VariantGroveView.
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <genogrove/data_type/serialization_traits.hpp>
+#include <genogrove/io/vcf_reader.hpp>
+
+namespace py = pybind11;
+namespace gio = genogrove::io;
+
+namespace pygg {
+
+struct variant_genotypes {
+    static constexpr uint8_t gt_missing = 3;
+    // GQ / DP are clamped to [0, 254]; 255 marks a missing value.
+    static constexpr uint8_t qual_missing = 255;
+
+    std::string id;
+    std::string ref;
+    std::vector<std::string> alt;
+    uint32_t n_samples = 0;
+    std::vector<uint8_t> gt;  // ceil(n_samples / 4) bytes, sample i at bits 2*(i%4)
+    std::vector<uint8_t> gq;  // n_samples bytes, or empty when not stored
+    std::vector<uint8_t> dp;  // n_samples bytes, or empty when not stored
+
+    // 2-bit code of sample i (gt_missing for a missing call).
+    uint8_t code(std::size_t i) const { return (gt[i >> 2] >> ((i & 3) * 2)) & 3; }
+
+    void set_code(std::size_t i, uint8_t c) {
+        gt[i >> 2] = static_cast<uint8_t>((gt[i >> 2] & ~(3 << ((i & 3) * 2))) |
+                                          (c << ((i & 3) * 2)));
+    }
+
+    // Decoded dosage of sample i: 0 / 1 / 2, or -1 when missing.
+    int8_t dosage(std::size_t i) const {
+        uint8_t c = code(i);
+        return c == gt_missing ? int8_t{-1} : static_cast<int8_t>(c);
+    }
+
+    static variant_genotypes from_entry(const gio::vcf_entry& e, bool with_gq,
+                                        bool with_dp) {
+        variant_genotypes v;
+        v.id = e.id;
+        v.ref = e.ref;
+        v.alt = e.alt;
+        v.n_samples = static_cast<uint32_t>(e.samples.size());
+        v.gt.assign((e.samples.size() + 3) / 4, 0xFF);  // all missing
+        if (with_gq) v.gq.assign(e.samples.size(), qual_missing);
+        if (with_dp) v.dp.assign(e.samples.size(), qual_missing);
+        for (std::size_t i = 0; i < e.samples.size(); ++i) {
+            const auto& s = e.samples[i];
+            if (s.has_gt && !s.gt_alleles.empty() &&
+                std::none_of(s.gt_alleles.begin(), s.gt_alleles.end(),
+                             [](auto a) { return a < 0; })) {
+                auto alts = std::count_if(s.gt_alleles.begin(), s.gt_alleles.end(),
+                                          [](auto a) { return a > 0; });
+                v.set_code(i, static_cast<uint8_t>(std::min<long>(alts, 2)));
+            }
+            if (with_gq) v.gq[i] = quantize_field(s.fields, "GQ");
+            if (with_dp) v.dp[i] = quantize_field(s.fields, "DP");
+        }
+        return v;
+    }
+
+    void serialize(std::ostream& os) const {
+        using str_traits = genogrove::data_type::serialization_traits<std::string>;
+        str_traits::serialize(os, id);
+        str_traits::serialize(os, ref);
+        write_u32(os, static_cast<uint32_t>(alt.size()));
+        for (const auto& a : alt) str_traits::serialize(os, a);
+        write_u32(os, n_samples);
+        const uint8_t flags = (gq.empty() ? 0 : 1) | (dp.empty() ? 0 : 2);
+        os.put(static_cast<char>(flags));
+        write_bytes(os, gt);
+        write_bytes(os, gq);
+        write_bytes(os, dp);
+    }
+
+    static variant_genotypes deserialize(std::istream& is) {
+        using str_traits = genogrove::data_type::serialization_traits<std::string>;
+        variant_genotypes v;
+        v.id = str_traits::deserialize(is);
+        v.ref = str_traits::deserialize(is);
+        v.alt.resize(read_u32(is));
+        for (auto& a : v.alt) a = str_traits::deserialize(is);
+        v.n_samples = read_u32(is);
+        const int flags = is.get();
+        if (!is) {
+            throw std::runtime_error("variant_genotypes: truncated record");
+        }
+        read_bytes(is, v.gt, (v.n_samples + 3) / 4);
+        if (flags & 1) read_bytes(is, v.gq, v.n_samples);
+        if (flags & 2) read_bytes(is, v.dp, v.n_samples);
+        return v;
+    }
+
+  private:
+    // First value of an integer/float FORMAT field, clamped into a byte.
+    template <typename Fields>
+    static uint8_t quantize_field(const Fields& fields, const std::string& tag) {
+        auto it = fields.find(tag);
+        if (it == fields.end()) return qual_missing;
+        return std::visit(
+            [](const auto& val) -> uint8_t {
+                using T = std::decay_t<decltype(val)>;
+                if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, bool>) {
+                    return qual_missing;
+                } else {
+                    if (val.empty()) return qual_missing;
+                    const double x = static_cast<double>(val.front());
+                    if (!(x >= 0)) return qual_missing;  // htslib missing / NaN
+                    return static_cast<uint8_t>(std::min(x, 254.0));
+                }
+            },
+            it->second);
+    }
+
+    static void write_u32(std::ostream& os, uint32_t x) {
+        os.write(reinterpret_cast<const char*>(&x), sizeof(x));
+    }
+    static uint32_t read_u32(std::istream& is) {
+        uint32_t x = 0;
+        is.read(reinterpret_cast<char*>(&x), sizeof(x));
+        if (!is) {
+            throw std::runtime_error("variant_genotypes: truncated record");
+        }
+        return x;
+    }
+    static void write_bytes(std::ostream& os, const std::vector<uint8_t>& b) {
+        os.write(reinterpret_cast<const char*>(b.data()),
+                 static_cast<std::streamsize>(b.size()));
+    }
+    static void read_bytes(std::istream& is, std::vector<uint8_t>& b, std::size_t n) {
+        b.resize(n);
+        is.read(reinterpret_cast<char*>(b.data()), static_cast<std::streamsize>(n));
+        if (!is) {
+            throw std::runtime_error("variant_genotypes: truncated record");
+        }
+    }
+};
+
+}  // namespace pygg
+
+// True for payloads carrying packed per-sample genotypes. Gates the VCF bulk
+// load on the grove and the genotype matrix on its QueryResult.
+template <typename T>
+concept has_packed_genotypes = std::same_as<T, pygg::variant_genotypes>;
+
+// Copy a run of payloads' genotypes into a (rows, samples) int8 dosage matrix.
+// Every payload must have the same sample count.
+template <typename Range>
+py::array_t<int8_t> genotype_matrix(const Range& payloads, std::size_t width) {
+    const auto rows = static_cast<py::ssize_t>(std::size(payloads));
+    py::array_t<int8_t> out({rows, static_cast<py::ssize_t>(width)});
+    auto buf = out.template mutable_unchecked<2>();
+    py::ssize_t r = 0;
+    for (const pygg::variant_genotypes* v : payloads) {
+        if (v->n_samples != width) {
+            throw std::invalid_argument(
+                "genotypes(): records have differing sample counts (" +
+                std::to_string(v->n_samples) + " vs " + std::to_string(width) + ")");
+        }
+        for (std::size_t j = 0; j < width; ++j) {
+            buf(r, static_cast<py::ssize_t>(j)) = v->dosage(j);
+        }
+        ++r;
+    }
+    return out;
+}
+
+inline void bind_variant_genotypes(py::module_& m) {
+    using vg_t = pygg::variant_genotypes;
+
+    auto as_array = [](const std::vector<uint8_t>& col) -> py::object {
+        if (col.empty()) return py::none();
+        py::array_t<uint8_t> out(static_cast<py::ssize_t>(col.size()));
+        std::copy(col.begin(), col.end(), out.mutable_data());
+        return std::move(out);
+    };
+
+    py::class_<vg_t>(m, "VariantGenotypes", R"pbdoc(
+        The VariantGrove payload: one variant's REF/ALT plus every sample's
+        genotype, bit-packed at 2 bits per sample, and optional 8-bit GQ / DP.
+
+        Genotypes decode to the non-REF allele count (0 / 1 / 2, capped at 2 for
+        multi-copy ALT calls) or -1 when missing; phase is not stored. GQ / DP
+        are clamped to 0..254, with 255 meaning missing.
+    )pbdoc")
+        .def(py::init<>())
+        .def_static("from_entry", &vg_t::from_entry, py::arg("entry"),
+                    py::arg("gq") = false, py::arg("dp") = false,
+                    "Pack a VcfEntry's samples (parse_samples=True); gq / dp also "
+                    "store those FORMAT fields.")
+        .def_readonly("id", &vg_t::id, "ID, empty when '.'.")
+        .def_readonly("ref", &vg_t::ref, "REF allele.")
+        .def_readonly("alt", &vg_t::alt, "ALT alleles.")
+        .def_readonly("sample_count", &vg_t::n_samples,
+                      "Number of samples packed into this record.")
+        .def("genotypes",
+             [](const vg_t& v) {
+                 py::array_t<int8_t> out(static_cast<py::ssize_t>(v.n_samples));
+                 auto* p = out.mutable_data();
+                 for (std::size_t i = 0; i < v.n_samples; ++i) p[i] = v.dosage(i);
+                 return out;
+             },
+             "Per-sample dosage as an int8 array (0 / 1 / 2, -1 = missing).")
+        .def("gq", [as_array](const vg_t& v) { return as_array(v.gq); },
+             "Per-sample GQ as a uint8 array (255 = missing), or None if not "
+             "stored.")
+        .def("dp", [as_array](const vg_t& v) { return as_array(v.dp); },
+             "Per-sample DP as a uint8 array (255 = missing), or None if not "
+             "stored.")
+        .def("__len__", [](const vg_t& v) { return v.n_samples; })
+        .def("__repr__", [](const vg_t& v) {
+            std::string alt = v.alt.empty() ? "." : v.alt.front();
+            if (v.alt.size() > 1) alt += ",...";
+            return "VariantGenotypes(ref='" + v.ref + "', alt='" + alt +
+                   "', samples=" + std::to_string(v.n_samples) + ")";
+        });
+}
@@ -22,6 +22,7 @@
 #include <genogrove/data_type/interval.hpp>
 #include <genogrove/io/bed_reader.hpp>
 #include <genogrove/io/gff_reader.hpp>
+#include <genogrove/io/vcf_reader.hpp>
 
 namespace gdt = genogrove::data_type;
 namespace gio = genogrove::io;
@@ -86,6 +87,16 @@ inline gdt::genomic_coordinate genomic_coordinate_from_entry(const gio::gff_entr
                                    iv.get_start(), iv.get_end());
 }
 
+// VCF: 0-based half-open [start, start + len(REF)) with no strand -> '.'
+// closed [start, end - 1]. A record spanning no reference bases has no key.
+inline gdt::genomic_coordinate genomic_coordinate_from_entry(const gio::vcf_entry& e) {
+    if (e.end <= e.start) {
+        throw std::invalid_argument(
+            "VcfEntry spans no reference bases; cannot derive a coordinate");
+    }
+    return gdt::genomic_coordinate('.', e.start, e.end - 1);
+}
+
 // True for data types that can derive a genomic_coordinate key. Gates the
 // entry-deriving insert overloads on the (now standard) genomic_coordinate grove.
 template <typename T>
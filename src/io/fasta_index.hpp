@@ -7,24 +7,504 @@
  * pairs with GenomicCoordinate: fetch a feature's bases with
  * idx.fetch(coord_index, gc.start, gc.end + 1) — fetch() is 0-based half-open
  * [start, end), GenomicCoordinate is 0-based closed [start, end].
+ *
+ * fetch_many() is the batch form: one GIL-released call that sorts the
+ * requests into file order (sequence order in the .fai, then start), merges
+ * requests closer than max_gap into a single faidx read, slices each feature
+ * back out, reverse-complements '-' strand features, and returns the results in
+ * input order. It also takes a genomic QueryResult directly.
+ *
+ * A faidx handle is not safe to fetch from concurrently (it owns one BGZF
+ * stream), so the bound FastaIndex is a pygg::fasta_source: a pool of faidx
+ * handles over the same file. Each fetch checks a handle out for its duration
+ * and opens another one only when every handle is busy, so one FastaIndex can
+ * be shared by any number of threads, and fetch_many(threads=n) splits its
+ * coalesced reads across n workers.
+ *
+ * For genomes that fit in RAM, FastaIndex(path, mode=...) swaps faidx's
+ * seek + read + newline strip per fetch for a memcpy out of a fasta_memory:
+ * "mmap" maps an uncompressed FASTA and finds a base via the .fai line
+ * geometry; "resident" loads every sequence, newline-free, into one buffer
+ * (works for bgzipped input too). The faidx pool stays for metadata.
  */
 #pragma once
 
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>  // std::vector<std::string> -> Python list
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <genogrove/data_type/genomic_coordinate.hpp>
+#include <genogrove/data_type/query_result.hpp>
+#include <genogrove/io/bed_reader.hpp>
 #include <genogrove/io/fasta_index.hpp>
+#include <genogrove/io/gff_reader.hpp>
+
+#include "../data_type/json_value.hpp"
+#include "../data_type/packed_sequence.hpp"
+#include "../data_type/variant_genotypes.hpp"
 
 namespace py = pybind11;
 namespace gio = genogrove::io;
+namespace gdt = genogrove::data_type;
+
+namespace pygg {
+
+// In-place reverse complement; IUPAC-aware and case-preserving, anything else
+// (e.g. '-', '*') is kept as is.
+inline void reverse_complement(std::string& s) {
+    static const std::array<char, 256> comp = [] {
+        std::array<char, 256> t{};
+        for (int i = 0; i < 256; ++i) t[i] = static_cast<char>(i);
+        const char* from = "ACGTRYKMBVDHacgtrykmbvdh";
+        const char* to = "TGCAYRMKVBHDtgcayrmkvbhd";
+        for (int i = 0; from[i]; ++i) t[static_cast<unsigned char>(from[i])] = to[i];
+        return t;
+    }();
+    std::reverse(s.begin(), s.end());
+    for (auto& c : s) c = comp[static_cast<unsigned char>(c)];
+}
+
+// htslib's fai_load() is not thread-safe, so concurrent opens race and abort
+// (issue #50): every faidx open in the process goes through this lock.
+inline std::mutex& fai_load_mutex() {
+    static std::mutex mu;
+    return mu;
+}
+
+// Whole FASTA sequences addressable in memory: a base pointer plus per-sequence
+// .fai geometry (offset of the first base, bases per line, bytes per line). For
+// a mapped file the geometry is the .fai's; for a resident copy each sequence
+// is one newline-free line. Read-only once built, so fetches need no lock.
+class fasta_memory {
+  public:
+    // Map `path` (uncompressed only) and index it with its .fai.
+    static std::unique_ptr<fasta_memory> map(const std::string& path) {
+        auto mem = std::unique_ptr<fasta_memory>(new fasta_memory());
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open FASTA file: " + path);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to stat FASTA file: " + path);
+        }
+        mem->map_len_ = static_cast<std::size_t>(st.st_size);
+        void* p = ::mmap(nullptr, mem->map_len_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            throw std::runtime_error("Failed to mmap FASTA file: " + path);
+        }
+        mem->map_ = p;
+        mem->base_ = static_cast<const char*>(p);
+        if (mem->map_len_ >= 2 && static_cast<unsigned char>(mem->base_[0]) == 0x1f &&
+            static_cast<unsigned char>(mem->base_[1]) == 0x8b) {
+            throw std::invalid_argument(
+                "mode='mmap' needs an uncompressed FASTA (use mode='resident' for "
+                "bgzipped input): " + path);
+        }
+        mem->read_fai(path + ".fai");
+        return mem;
+    }
+
+    // Copy every sequence of `idx` into one contiguous, newline-free buffer.
+    static std::unique_ptr<fasta_memory> load(const gio::fasta_index& idx) {
+        auto mem = std::unique_ptr<fasta_memory>(new fasta_memory());
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < idx.sequence_count(); ++i) {
+            total += idx.sequence_length(idx.sequence_name(i));
+        }
+        mem->resident_.reserve(total);
+        for (std::size_t i = 0; i < idx.sequence_count(); ++i) {
+            const std::string name = idx.sequence_name(i);
+            const std::size_t len = idx.sequence_length(name);
+            const std::size_t off = mem->resident_.size();
+            if (len > 0) mem->resident_ += idx.fetch(name);
+            mem->seqs_.emplace(name, geometry{len, off, std::max<std::size_t>(len, 1),
+                                              std::max<std::size_t>(len, 1)});
+        }
+        mem->base_ = mem->resident_.data();
+        return mem;
+    }
+
+    ~fasta_memory() {
+        if (map_) ::munmap(map_, map_len_);
+    }
+    fasta_memory(const fasta_memory&) = delete;
+    fasta_memory& operator=(const fasta_memory&) = delete;
+
+    // Same contract as faidx: [start, end) clipped to the sequence.
+    std::string fetch(const std::string& name, std::size_t start, std::size_t end) const {
+        const auto& g = find(name);
+        if (start >= end) {
+            throw std::out_of_range("Invalid region: start >= end for " + name);
+        }
+        end = std::min(end, g.length);
+        if (start >= end) return {};
+        std::string out(end - start, '\0');
+        char* dst = out.data();
+        for (std::size_t pos = start; pos < end;) {
+            const std::size_t col = pos % g.line_bases;
+            const std::size_t n = std::min(g.line_bases - col, end - pos);
+            std::memcpy(dst, base_ + g.offset + (pos / g.line_bases) * g.line_width + col, n);
+            dst += n;
+            pos += n;
+        }
+        return out;
+    }
+
+    std::string fetch(const std::string& name) const {
+        const auto& g = find(name);
+        return g.length == 0 ? std::string() : fetch(name, 0, g.length);
+    }
+
+    // Bytes held: the mapping or the resident buffer.
+    std::size_t byte_size() const { return map_ ? map_len_ : resident_.size(); }
+
+  private:
+    struct geometry {
+        std::size_t length;
+        std::size_t offset;
+        std::size_t line_bases;
+        std::size_t line_width;
+    };
+
+    fasta_memory() = default;
+
+    const geometry& find(const std::string& name) const {
+        auto it = seqs_.find(name);
+        if (it == seqs_.end()) {
+            throw std::out_of_range("Sequence not found in FASTA index: " + name);
+        }
+        return it->second;
+    }
+
+    // .fai: NAME LENGTH OFFSET LINEBASES LINEWIDTH (tab-separated).
+    void read_fai(const std::string& fai_path) {
+        std::ifstream in(fai_path);
+        if (!in) {
+            throw std::runtime_error("Failed to open FASTA index: " + fai_path);
+        }
+        std::string name;
+        geometry g{};
+        while (in >> name >> g.length >> g.offset >> g.line_bases >> g.line_width) {
+            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            if (g.length > 0) {
+                const std::size_t last = g.length - 1;
+                if (g.line_bases == 0 ||
+                    g.offset + (last / g.line_bases) * g.line_width +
+                            last % g.line_bases >= map_len_) {
+                    throw std::runtime_error("FASTA index does not match the file "
+                                             "(stale .fai?): " + fai_path);
+                }
+            } else if (g.line_bases == 0) {
+                g.line_bases = g.line_width = 1;
+            }
+            seqs_.emplace(std::move(name), g);
+        }
+    }
+
+    std::unordered_map<std::string, geometry> seqs_;
+    const char* base_ = nullptr;
+    void* map_ = nullptr;
+    std::size_t map_len_ = 0;
+    std::string resident_;
+};
+
+// A pool of faidx handles over one FASTA. Handles are checked out per fetch
+// (lease) and returned afterwards; the pool grows only when all handles are
+// busy, i.e. to the peak number of concurrent fetches. Metadata lookups are
+// read-only on the shared .fai table and go to the first handle. In "mmap" /
+// "resident" mode fetches are served from a fasta_memory instead.
+class fasta_source {
+  public:
+    explicit fasta_source(std::string path, const std::string& mode = "faidx")
+        : path_(std::move(path)), mode_(mode) {
+        if (mode_ != "faidx" && mode_ != "mmap" && mode_ != "resident") {
+            throw std::invalid_argument("FastaIndex mode must be 'faidx', 'mmap' or "
+                                        "'resident', got '" + mode_ + "'");
+        }
+        // The first open also builds a missing .fai, which mmap mode reads.
+        all_.push_back(open());
+        primary_ = all_.front().get();
+        free_.push_back(primary_);
+        if (mode_ == "mmap") {
+            memory_ = fasta_memory::map(path_);
+        } else if (mode_ == "resident") {
+            memory_ = fasta_memory::load(primary());
+        }
+    }
+
+    // RAII checkout of one handle; returns it to the pool on destruction.
+    class lease {
+      public:
+        lease(fasta_source& src, gio::fasta_index* h) : src_(&src), h_(h) {}
+        lease(lease&& o) noexcept : src_(o.src_), h_(std::exchange(o.h_, nullptr)) {}
+        lease(const lease&) = delete;
+        lease& operator=(const lease&) = delete;
+        lease& operator=(lease&&) = delete;
+        ~lease() {
+            if (h_) src_->release(h_);
+        }
+        gio::fasta_index* operator->() const { return h_; }
+
+      private:
+        fasta_source* src_;
+        gio::fasta_index* h_;
+    };
+
+    lease acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (!free_.empty()) {
+                auto* h = free_.back();
+                free_.pop_back();
+                return lease(*this, h);
+            }
+        }
+        // Open outside mu_ (it takes fai_load_mutex and reads the .fai).
+        auto fresh = open();
+        std::lock_guard<std::mutex> lock(mu_);
+        all_.push_back(std::move(fresh));
+        return lease(*this, all_.back().get());
+    }
+
+    // The first handle, cached: all_ may reallocate while another thread grows
+    // the pool, but the handle it points to never moves.
+    const gio::fasta_index& primary() const { return *primary_; }
+
+    std::string fetch(const std::string& name, std::size_t start, std::size_t end) {
+        if (memory_) return memory_->fetch(name, start, end);
+        return acquire()->fetch(name, start, end);
+    }
+    std::string fetch(const std::string& name) {
+        if (memory_) return memory_->fetch(name);
+        return acquire()->fetch(name);
+    }
+
+    const std::string& mode() const { return mode_; }
+    const fasta_memory* memory() const { return memory_.get(); }
+
+    std::size_t handle_count() const {
+        std::lock_guard<std::mutex> lock(mu_);
+        return all_.size();
+    }
+
+  private:
+    std::unique_ptr<gio::fasta_index> open() const {
+        // std::string -> std::filesystem::path; throws std::runtime_error
+        // (-> RuntimeError) if the file can't be opened or indexed.
+        std::lock_guard<std::mutex> lock(fai_load_mutex());
+        return std::make_unique<gio::fasta_index>(path_);
+    }
+
+    void release(gio::fasta_index* h) {
+        std::lock_guard<std::mutex> lock(mu_);
+        free_.push_back(h);
+    }
+
+    std::string path_;
+    std::string mode_;
+    std::unique_ptr<fasta_memory> memory_;
+    mutable std::mutex mu_;
+    std::vector<std::unique_ptr<gio::fasta_index>> all_;  // all_[0] is primary
+    gio::fasta_index* primary_ = nullptr;                 // all_[0], read without mu_
+    std::vector<gio::fasta_index*> free_;
+};
+
+// One fetch_many request: [start, end) on sequence `name`, '-' = revcomp.
+struct fetch_request {
+    const std::string* name;
+    std::size_t start;
+    std::size_t end;
+    char strand;
+};
+
+// Serve `reqs` with as few faidx reads as possible; results come back in
+// request order. Requests are visited in file order and a run of requests whose
+// gaps are all <= max_gap is read as one region and sliced. With threads > 1
+// the runs are dealt out in contiguous, roughly equal-length slices to workers
+// that each lease their own handle.
+inline std::vector<std::string> fetch_many(fasta_source& src,
+                                           const std::vector<fetch_request>& reqs,
+                                           std::size_t max_gap, std::size_t threads) {
+    const auto& idx = src.primary();
+    // Nothing to save by merging reads when each is already a memcpy.
+    if (src.memory()) max_gap = 0;
+    std::unordered_map<std::string, std::size_t> rank;
+    rank.reserve(idx.sequence_count());
+    for (std::size_t i = 0; i < idx.sequence_count(); ++i) {
+        rank.emplace(idx.sequence_name(i), i);
+    }
+    std::vector<std::size_t> seq_rank(reqs.size());
+    for (std::size_t i = 0; i < reqs.size(); ++i) {
+        auto it = rank.find(*reqs[i].name);
+        if (it == rank.end()) {
+            throw std::out_of_range("fetch_many: unknown sequence '" + *reqs[i].name +
+                                    "' (request " + std::to_string(i) + ")");
+        }
+        if (reqs[i].start >= reqs[i].end) {
+            throw std::out_of_range("fetch_many: empty or inverted region at request " +
+                                    std::to_string(i));
+        }
+        seq_rank[i] = it->second;
+    }
+
+    std::vector<std::size_t> order(reqs.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        if (seq_rank[a] != seq_rank[b]) return seq_rank[a] < seq_rank[b];
+        return reqs[a].start < reqs[b].start;
+    });
+
+    // Coalesced runs: order[runs[r] .. runs[r + 1]) is read as one region.
+    std::vector<std::size_t> runs{0};
+    std::vector<std::size_t> run_end;
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < order.size();) {
+        std::size_t end = reqs[order[i]].end;
+        std::size_t j = i + 1;
+        while (j < order.size() && seq_rank[order[j]] == seq_rank[order[i]] &&
+               reqs[order[j]].start <= end + max_gap) {
+            end = std::max(end, reqs[order[j]].end);
+            ++j;
+        }
+        total += end - reqs[order[i]].start;
+        run_end.push_back(end);
+        runs.push_back(j);
+        i = j;
+    }
+
+    std::vector<std::string> out(reqs.size());
+    auto serve = [&](std::size_t r_begin, std::size_t r_end) {
+        // In-memory sources are lock-free to read; only faidx needs a handle.
+        std::optional<fasta_source::lease> handle;
+        if (!src.memory()) handle.emplace(src.acquire());
+        for (std::size_t r = r_begin; r < r_end; ++r) {
+            const auto& first = reqs[order[runs[r]]];
+            // faidx clips a region running past the sequence end, so slices clip too.
+            const std::string block =
+                handle ? (*handle)->fetch(*first.name, first.start, run_end[r])
+                       : src.memory()->fetch(*first.name, first.start, run_end[r]);
+            for (std::size_t i = runs[r]; i < runs[r + 1]; ++i) {
+                const auto& q = reqs[order[i]];
+                const std::size_t off = std::min(q.start - first.start, block.size());
+                std::string& s = out[order[i]];
+                s.assign(block, off, q.end - q.start);
+                if (q.strand == '-') reverse_complement(s);
+            }
+        }
+    };
+
+    const std::size_t n_runs = run_end.size();
+    threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(n_runs, 1));
+    if (threads == 1) {
+        serve(0, n_runs);
+        return out;
+    }
+    // Cut the run list where the cumulative span crosses k * total / threads.
+    std::vector<std::size_t> cuts{0};
+    std::size_t acc = 0;
+    for (std::size_t r = 0; r < n_runs && cuts.size() < threads; ++r) {
+        acc += run_end[r] - reqs[order[runs[r]]].start;
+        if (acc * threads >= total * cuts.size()) cuts.push_back(r + 1);
+    }
+    cuts.push_back(n_runs);
+    std::vector<std::exception_ptr> errors(cuts.size() - 1);
+    std::vector<std::thread> workers;
+    for (std::size_t w = 0; w + 1 < cuts.size(); ++w) {
+        workers.emplace_back([&, w] {
+            try {
+                serve(cuts[w], cuts[w + 1]);
+            } catch (...) {
+                errors[w] = std::current_exception();
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return out;
+}
+
+// list[str], or (bytes, int64 offsets[n + 1]) when concat is set.
+inline py::object fetch_many_result(std::vector<std::string> seqs, bool concat) {
+    if (!concat) return py::cast(std::move(seqs));
+    py::array_t<int64_t> offsets(static_cast<py::ssize_t>(seqs.size() + 1));
+    auto* o = offsets.mutable_data();
+    std::size_t total = 0;
+    o[0] = 0;
+    for (std::size_t i = 0; i < seqs.size(); ++i) {
+        total += seqs[i].size();
+        o[i + 1] = static_cast<int64_t>(total);
+    }
+    std::string joined;
+    joined.reserve(total);
+    for (const auto& s : seqs) joined += s;
+    return py::make_tuple(py::bytes(joined), std::move(offsets));
+}
+
+}  // namespace pygg
+
+// fetch_many(result, index) for one genomic QueryResult type: each hit's
+// coordinate (0-based closed) becomes a [start, end + 1) request on `index`,
+// reverse-complemented when the key is on '-'.
+template <typename DataT>
+void bind_fetch_many_query_result(py::class_<pygg::fasta_source>& cls) {
+    using qr_t = gdt::query_result<gdt::genomic_coordinate, DataT>;
+    cls.def(
+        "fetch_many",
+        [](pygg::fasta_source& src, const qr_t& result, const std::string& index,
+           bool concat, std::size_t max_gap, std::size_t threads) {
+            std::vector<std::string> seqs;
+            {
+                py::gil_scoped_release release;
+                std::vector<pygg::fetch_request> reqs;
+                reqs.reserve(result.get_keys().size());
+                for (auto* k : result.get_keys()) {
+                    const auto& c = k->get_value();
+                    reqs.push_back({&index, c.get_start(), c.get_end() + 1,
+                                    c.get_strand()});
+                }
+                seqs = pygg::fetch_many(src, reqs, max_gap, threads);
+            }
+            return pygg::fetch_many_result(std::move(seqs), concat);
+        },
+        py::arg("result"), py::arg("index"), py::arg("concat") = false,
+        py::arg("max_gap") = 4096, py::arg("threads") = 1,
+        "fetch_many(result, index, concat=False, max_gap=4096, threads=1): the "
+        "bases of every hit in a genomic QueryResult, read from sequence "
+        "`index`; '-' strand hits are reverse-complemented.");
+}
 
 inline void bind_fasta_index(py::module_& m) {
-    py::class_<gio::fasta_index>(m, "FastaIndex", R"pbdoc(
+    using src_t = pygg::fasta_source;
+    auto cls = py::class_<src_t>(m, "FastaIndex", R"pbdoc(
         Random-access reader for a FASTA file, backed by an .fai index.
 
         Opening builds the index if it is missing (this writes a sibling
@@ -33,29 +513,36 @@ inline void bind_fasta_index(py::module_& m) {
         bases of a GenomicCoordinate (0-based closed ``[start, end]``), call
         ``idx.fetch(index, gc.start, gc.end + 1)``.
 
-        Non-copyable; the underlying htslib handle is closed when the object is
-        garbage-collected.
+        Thread-safe: fetches run with the GIL released, each on its own faidx
+        handle from an internal pool (grown on demand to the number of
+        concurrent fetches), so one FastaIndex can be shared across threads.
+
+        For genomes that fit in RAM, mode="mmap" (uncompressed FASTA) or
+        mode="resident" turns each fetch into a memcpy; see __init__.
+
+        Non-copyable; the underlying htslib handles are closed when the object
+        is garbage-collected.
     )pbdoc")
-        .def(py::init([](const std::string& path) {
-                 // std::string -> std::filesystem::path; throws std::runtime_error
-                 // (-> RuntimeError) if the file can't be opened or indexed.
-                 //
-                 // htslib's fai_load() is not thread-safe, so concurrent opens
-                 // race and abort (issue #50). Serialize construction with a
-                 // process-wide lock; the GIL stays released (below) so a long
-                 // multi-GB index build still won't freeze unrelated threads,
-                 // and fetch() on separate handles remains fully concurrent.
-                 static std::mutex fai_load_mutex;
-                 std::lock_guard<std::mutex> lock(fai_load_mutex);
-                 return std::make_unique<gio::fasta_index>(path);
+        .def(py::init([](const std::string& path, const std::string& mode) {
+                 return std::make_unique<src_t>(path, mode);
              }),
-             py::arg("path"),
-             // Building a missing .fai for a multi-GB genome is pure htslib I/O.
+             py::arg("path"), py::arg("mode") = "faidx",
+             // Building a missing .fai for a multi-GB genome is pure htslib I/O;
+             // opens are serialized by fai_load_mutex (issue #50), not the GIL.
              py::call_guard<py::gil_scoped_release>(),
-             "Open a FASTA file and load (or create) its .fai index.")
+             R"pbdoc(
+                 Open a FASTA file and load (or create) its .fai index.
+
+                 mode="faidx" (default) reads through htslib per fetch.
+                 mode="mmap" maps an uncompressed FASTA and slices it via the
+                 .fai line geometry (no syscalls per fetch; ValueError for a
+                 compressed file). mode="resident" loads every sequence into
+                 memory up front (bgzipped input allowed). In both, a fetch is
+                 a memcpy.
+             )pbdoc")
         .def("fetch",
              py::overload_cast<const std::string&, std::size_t, std::size_t>(
-                 &gio::fasta_index::fetch, py::const_),
+                 &src_t::fetch),
              py::arg("name"), py::arg("start"), py::arg("end"),
              // faidx disk read; returns a std::string converted after reacquire.
              py::call_guard<py::gil_scoped_release>(),
@@ -66,9 +553,7 @@ inline void bind_fasta_index(py::module_& m) {
                  [start, end). Raises IndexError if `name` is unknown or the
                  region is invalid (start >= end, or beyond htslib's limit).
              )pbdoc")
-        .def("fetch",
-             py::overload_cast<const std::string&>(&gio::fasta_index::fetch,
-                                                   py::const_),
+        .def("fetch", py::overload_cast<const std::string&>(&src_t::fetch),
              py::arg("name"),
              // Whole-sequence faidx read (can be very large); GIL released.
              py::call_guard<py::gil_scoped_release>(),
@@ -77,17 +562,46 @@ inline void bind_fasta_index(py::module_& m) {
 
                  The entire sequence named `name`. Raises IndexError if unknown.
              )pbdoc")
-        .def("sequence_count", &gio::fasta_index::sequence_count,
+        .def("fetch_packed",
+             [](src_t& src, const std::string& name, std::optional<std::size_t> start,
+                std::optional<std::size_t> end) {
+                 const std::string bases =
+                     start || end
+                         ? src.fetch(name, start.value_or(0),
+                                     end ? *end : src.primary().sequence_length(name))
+                         : src.fetch(name);
+                 return pygg::packed_sequence::encode(bases, name);
+             },
+             py::arg("name"), py::arg("start") = py::none(), py::arg("end") = py::none(),
+             py::call_guard<py::gil_scoped_release>(),
+             R"pbdoc(
+                 fetch_packed(name, start=None, end=None) -> PackedSequence
+
+                 fetch() straight into a PackedSequence (2 bits per base, N
+                 runs masked) — the bases never become a Python str. Omit
+                 start / end for the whole sequence.
+             )pbdoc")
+        .def("sequence_count",
+             [](const src_t& s) { return s.primary().sequence_count(); },
              "Number of sequences in the index.")
-        .def("sequence_name", &gio::fasta_index::sequence_name, py::arg("index"),
+        .def("sequence_name",
+             [](const src_t& s, std::size_t i) { return s.primary().sequence_name(i); },
+             py::arg("index"),
              "Name of the i-th sequence (0-based). Raises IndexError if out of range.")
-        .def("sequence_length", &gio::fasta_index::sequence_length,
+        .def("sequence_length",
+             [](const src_t& s, const std::string& name) {
+                 return s.primary().sequence_length(name);
+             },
              py::arg("name"),
              "Length in bases of sequence `name`. Raises IndexError if unknown.")
-        .def("has_sequence", &gio::fasta_index::has_sequence, py::arg("name"),
-             "Whether `name` is present in the index.")
+        .def("has_sequence",
+             [](const src_t& s, const std::string& name) {
+                 return s.primary().has_sequence(name);
+             },
+             py::arg("name"), "Whether `name` is present in the index.")
         .def("names",
-             [](const gio::fasta_index& idx) {
+             [](const src_t& s) {
+                 const auto& idx = s.primary();
                  std::vector<std::string> out;
                  out.reserve(idx.sequence_count());
                  for (std::size_t i = 0; i < idx.sequence_count(); ++i) {
@@ -96,6 +610,88 @@ inline void bind_fasta_index(py::module_& m) {
                  return out;
              },
              "List of all sequence names, in index order.")
-        .def("__len__", &gio::fasta_index::sequence_count)
-        .def("__contains__", &gio::fasta_index::has_sequence, py::arg("name"));
+        .def_property_readonly("mode", &src_t::mode,
+                               "Fetch backend: 'faidx', 'mmap' or 'resident'.")
+        .def("memory_bytes",
+             [](const src_t& s) -> std::size_t {
+                 return s.memory() ? s.memory()->byte_size() : 0;
+             },
+             "Bytes mapped / held resident by the mmap / resident backends "
+             "(0 for faidx).")
+        .def("handle_count", &src_t::handle_count,
+             "Number of faidx handles opened so far (the peak fetch concurrency).")
+        .def("__len__", [](const src_t& s) { return s.primary().sequence_count(); })
+        .def("__contains__",
+             [](const src_t& s, const std::string& name) {
+                 return s.primary().has_sequence(name);
+             },
+             py::arg("name"))
+        .def("fetch_many",
+             [](src_t& src, const std::vector<std::string>& names,
+                py::array_t<int64_t, py::array::c_style | py::array::forcecast> starts,
+                py::array_t<int64_t, py::array::c_style | py::array::forcecast> ends,
+                std::optional<std::vector<char>> strands, bool concat,
+                std::size_t max_gap, std::size_t threads) {
+                 const std::size_t n = names.size();
+                 if (starts.ndim() != 1 || ends.ndim() != 1 ||
+                     static_cast<std::size_t>(starts.size()) != n ||
+                     static_cast<std::size_t>(ends.size()) != n ||
+                     (strands && strands->size() != n)) {
+                     throw std::invalid_argument(
+                         "fetch_many: names, starts, ends (and strands) must be "
+                         "1-D and of equal length");
+                 }
+                 const int64_t* s = starts.data();
+                 const int64_t* e = ends.data();
+                 std::vector<std::string> seqs;
+                 {
+                     py::gil_scoped_release release;
+                     std::vector<pygg::fetch_request> reqs(n);
+                     for (std::size_t i = 0; i < n; ++i) {
+                         if (s[i] < 0 || e[i] < 0) {
+                             throw std::out_of_range(
+                                 "fetch_many: negative coordinate at request " +
+                                 std::to_string(i));
+                         }
+                         reqs[i] = {&names[i], static_cast<std::size_t>(s[i]),
+                                    static_cast<std::size_t>(e[i]),
+                                    strands ? (*strands)[i] : '+'};
+                     }
+                     seqs = pygg::fetch_many(src, reqs, max_gap, threads);
+                 }
+                 return pygg::fetch_many_result(std::move(seqs), concat);
+             },
+             py::arg("names"), py::arg("starts"), py::arg("ends"),
+             py::arg("strands") = py::none(), py::arg("concat") = false,
+             py::arg("max_gap") = 4096, py::arg("threads") = 1,
+             R"pbdoc(
+                 fetch_many(names, starts, ends, strands=None, concat=False,
+                            max_gap=4096, threads=1)
+                     -> list[str] | tuple[bytes, numpy.ndarray]
+
+                 Batch fetch of 0-based half-open regions [starts[i], ends[i])
+                 on sequences names[i], in one call with the GIL released.
+                 starts / ends may be lists or integer arrays. Requests are read
+                 in file order, and requests within max_gap bases of each other
+                 are served from a single faidx read. With strands (a list of
+                 '+' / '-' / '.'), '-' regions are reverse-complemented.
+                 threads > 1 splits the coalesced reads across that many
+                 worker threads, each on its own faidx handle.
+
+                 Results are in input order: a list of str, or with concat=True
+                 one bytes buffer plus an int64 offsets array of length n + 1
+                 (region i is buf[offsets[i]:offsets[i + 1]]). Raises IndexError
+                 for an unknown name or an empty/inverted region, ValueError for
+                 mismatched lengths.
+
+                 fetch_many(result, index, concat=False, max_gap=4096,
+                 threads=1) takes a genomic QueryResult instead (hits on
+                 sequence `index`).
+             )pbdoc");
+
+    // QueryResult overloads for every genomic_coordinate grove payload.
+    bind_fetch_many_query_result<pygg::json_value>(cls);
+    bind_fetch_many_query_result<gio::bed_entry>(cls);
+    bind_fetch_many_query_result<gio::gff_entry>(cls);
+    bind_fetch_many_query_result<pygg::variant_genotypes>(cls);
 }
\ No newline at end of file
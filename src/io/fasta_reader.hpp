@@ -5,21 +5,248 @@
  * FASTA records are named sequences, not genomic intervals, so this is a
  * standalone reader (no grove integration / coordinate derivation). The reader
  * handles both FASTA (`>` headers) and FASTQ (`@` headers + per-base quality),
- * auto-detected per file. Random-access (fasta_index) is deferred.
+ * auto-detected per file. Random-access lives in fasta_index.hpp.
+ *
+ * Sequence / quality are also exposed zero-copy (`sequence_view` /
+ * `quality_view`): a read-only memoryview onto the entry's own std::string, so
+ * a whole chromosome need not be decoded into a Python str; to_packed() encodes
+ * it straight to a PackedSequence. With
+ * `FastaReader(path, chunk_size=n)` the reader instead streams each record as
+ * FastaChunk windows of at most n bases, parsing the file itself (through
+ * htslib BGZF, so plain and gzip/BGZF input still work) so that a 250 Mb
+ * record never has to be held whole — genogrove's fasta_reader always
+ * materializes full records.
  */
 #pragma once
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>  // std::optional<std::string> quality -> str | None
 
+#include <htslib/bgzf.h>
+#include <htslib/kstring.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 
 #include <genogrove/io/fasta_reader.hpp>
 
+#include "../data_type/byte_view.hpp"
+#include "../data_type/packed_sequence.hpp"
+#include "../data_type/side_table.hpp"
+
 namespace py = pybind11;
 namespace gio = genogrove::io;
 
+namespace pygg {
+
+// One window of a (possibly much longer) FASTA/FASTQ record.
+struct fasta_chunk {
+    std::string name;
+    std::string comment;
+    std::size_t start = 0;  // 0-based offset of sequence[0] within the record
+    std::string sequence;
+    std::optional<std::string> quality;
+    bool last = false;  // this window ends the record
+};
+
+// Streaming FASTA/FASTQ parser yielding fasta_chunk windows of at most
+// chunk_size bases. A FASTA record is read line by line and never held in full;
+// FASTQ records (quality follows the whole sequence) are read whole and sliced,
+// which is fine for reads. An empty record yields one empty last chunk unless
+// skip_empty_sequences is set.
+class fasta_chunk_reader {
+  public:
+    fasta_chunk_reader(const std::string& path, std::size_t chunk_size,
+                       bool skip_empty_sequences)
+        : fp_(bgzf_open(path.c_str(), "r"), &bgzf_close),
+          chunk_size_(chunk_size),
+          skip_empty_(skip_empty_sequences) {
+        if (chunk_size_ == 0) {
+            throw std::invalid_argument("chunk_size must be positive");
+        }
+        if (!fp_) {
+            throw std::runtime_error("Failed to open FASTA/FASTQ file: " + path);
+        }
+    }
+
+    ~fasta_chunk_reader() { ks_free(&line_); }
+    fasta_chunk_reader(const fasta_chunk_reader&) = delete;
+    fasta_chunk_reader& operator=(const fasta_chunk_reader&) = delete;
+
+    bool read_next(fasta_chunk& out) {
+        while (true) {
+            if (!pending_.empty()) {
+                out = std::move(pending_.front());
+                pending_.pop_front();
+                return true;
+            }
+            if (in_record_) {
+                emit_fasta(out);
+                if (out.sequence.empty() && skip_empty_) continue;
+                return true;
+            }
+            if (!start_record()) return false;
+        }
+    }
+
+    const std::string& get_error_message() const { return error_; }
+    std::size_t get_current_line() const { return line_no_; }
+
+  private:
+    // Next physical line into line_ (CR stripped); false at EOF.
+    bool next_line() {
+        const int rc = bgzf_getline(fp_.get(), '\n', &line_);
+        if (rc == -1) return false;
+        if (rc < -1) {
+            fail("read error");
+        }
+        ++line_no_;
+        if (line_.l > 0 && line_.s[line_.l - 1] == '\r') line_.s[--line_.l] = '\0';
+        return true;
+    }
+
+    [[noreturn]] void fail(const std::string& what) {
+        error_ = what + " at line " + std::to_string(line_no_);
+        throw std::runtime_error("FASTA/FASTQ parse error: " + error_);
+    }
+
+    void parse_header(std::string_view h) {
+        h.remove_prefix(1);
+        const auto ws = h.find_first_of(" \t");
+        name_ = std::string(h.substr(0, ws));
+        comment_.clear();
+        if (ws != std::string_view::npos) {
+            auto rest = h.substr(ws);
+            const auto b = rest.find_first_not_of(" \t");
+            if (b != std::string_view::npos) comment_ = std::string(rest.substr(b));
+        }
+    }
+
+    // Position on the next header and set up the record; false at EOF.
+    bool start_record() {
+        if (!have_header_) {
+            do {
+                if (!next_line()) return false;
+            } while (line_.l == 0);
+            header_.assign(line_.s, line_.l);
+        }
+        have_header_ = false;
+        if (header_[0] != '>' && header_[0] != '@') {
+            fail("expected '>' or '@' header");
+        }
+        parse_header(header_);
+        if (header_[0] == '@') {
+            read_fastq();
+            return true;
+        }
+        in_record_ = true;
+        record_done_ = false;
+        offset_ = 0;
+        buf_.clear();
+        return true;
+    }
+
+    // Emit the next FASTA window; reads ahead one line past chunk_size so the
+    // window that exhausts the record is flagged `last`.
+    void emit_fasta(fasta_chunk& out) {
+        while (!record_done_ && buf_.size() <= chunk_size_) {
+            if (!next_line()) {
+                record_done_ = true;
+            } else if (line_.l > 0 && (line_.s[0] == '>' || line_.s[0] == '@')) {
+                header_.assign(line_.s, line_.l);
+                have_header_ = true;
+                record_done_ = true;
+            } else {
+                buf_.append(line_.s, line_.l);
+            }
+        }
+        const std::size_t n = std::min(chunk_size_, buf_.size());
+        out = fasta_chunk{name_, comment_, offset_, buf_.substr(0, n), std::nullopt, false};
+        buf_.erase(0, n);
+        offset_ += n;
+        out.last = record_done_ && buf_.empty();
+        if (out.last) in_record_ = false;
+    }
+
+    void read_fastq() {
+        std::string seq;
+        std::string qual;
+        while (true) {
+            if (!next_line()) fail("truncated FASTQ record");
+            if (line_.l > 0 && line_.s[0] == '+') break;
+            seq.append(line_.s, line_.l);
+        }
+        while (qual.size() < seq.size()) {
+            if (!next_line()) fail("truncated FASTQ quality");
+            qual.append(line_.s, line_.l);
+        }
+        if (qual.size() != seq.size()) fail("FASTQ quality length mismatch");
+        if (seq.empty()) {
+            if (!skip_empty_) {
+                pending_.push_back(fasta_chunk{name_, comment_, 0, {}, std::string{}, true});
+            }
+            return;
+        }
+        for (std::size_t at = 0; at < seq.size(); at += chunk_size_) {
+            const std::size_t n = std::min(chunk_size_, seq.size() - at);
+            pending_.push_back(fasta_chunk{name_, comment_, at, seq.substr(at, n),
+                                           qual.substr(at, n), at + n == seq.size()});
+        }
+    }
+
+    std::unique_ptr<BGZF, decltype(&bgzf_close)> fp_;
+    std::size_t chunk_size_;
+    bool skip_empty_;
+    kstring_t line_ = KS_INITIALIZE;
+    std::size_t line_no_ = 0;
+    std::string error_;
+
+    std::string header_;
+    bool have_header_ = false;  // header_ holds a look-ahead header line
+    std::string name_;
+    std::string comment_;
+    bool in_record_ = false;
+    bool record_done_ = false;
+    std::size_t offset_ = 0;
+    std::string buf_;
+    std::deque<fasta_chunk> pending_;  // FASTQ windows still to hand out
+};
+
+// One pin per FastaEntry with exported sequence_view / quality_view memoryviews;
+// each view holds a copy, so a use count above the table's own reference (plus
+// the caller's) means a view is alive and the bytes must not be reassigned.
+using entry_view_pins = object_side_table<const void, struct entry_view_pin_tag>;
+
+inline std::shared_ptr<const void> entry_view_pin(py::handle self, const void* entry) {
+    if (auto pin = entry_view_pins::instance().find(entry)) return pin;
+    return entry_view_pins::instance().try_attach(self, entry, std::make_shared<const int>(0));
+}
+
+inline void check_no_entry_views(const void* entry, const char* field) {
+    const auto pin = entry_view_pins::instance().find(entry);
+    if (pin && pin.use_count() > 2) {
+        throw py::buffer_error(std::string("cannot reassign ") + field +
+                               " while a memoryview over it exists");
+    }
+}
+
+// FastaReader: whole records through genogrove's fasta_reader, or windows
+// through fasta_chunk_reader when a chunk_size is given.
+struct fasta_reader_handle {
+    std::unique_ptr<gio::fasta_reader> whole;
+    std::unique_ptr<fasta_chunk_reader> chunked;
+};
+
+}  // namespace pygg
+
 inline void bind_fasta_entry(py::module_& m) {
     py::class_<gio::fasta_entry>(m, "FastaEntry", R"pbdoc(
         A single FASTA/FASTQ record: a named nucleotide sequence.
@@ -35,10 +262,49 @@ inline void bind_fasta_entry(py::module_& m) {
                        "Sequence name (header text up to the first whitespace).")
         .def_readwrite("comment", &gio::fasta_entry::comment,
                        "Optional description (rest of the header line).")
-        .def_readwrite("sequence", &gio::fasta_entry::sequence,
-                       "Nucleotide sequence.")
-        .def_readwrite("quality", &gio::fasta_entry::quality,
-                       "Per-base quality string (FASTQ only; None for FASTA).")
+        .def_property(
+            "sequence", [](const gio::fasta_entry& e) { return e.sequence; },
+            [](gio::fasta_entry& e, std::string sequence) {
+                pygg::check_no_entry_views(&e, "sequence");
+                e.sequence = std::move(sequence);
+            },
+            "Nucleotide sequence. Raises BufferError on assignment while a "
+            "sequence_view / quality_view is alive.")
+        .def_property(
+            "quality", [](const gio::fasta_entry& e) { return e.quality; },
+            [](gio::fasta_entry& e, std::optional<std::string> quality) {
+                pygg::check_no_entry_views(&e, "quality");
+                e.quality = std::move(quality);
+            },
+            "Per-base quality string (FASTQ only; None for FASTA).")
+        .def_property_readonly(
+            "sequence_view",
+            [](py::object self) {
+                auto& e = self.cast<gio::fasta_entry&>();
+                return pygg::make_byte_view(self, e.sequence, pygg::entry_view_pin(self, &e));
+            },
+            R"pbdoc(
+                Read-only memoryview (format 'B') over the sequence bytes — no
+                copy and no str decode; bytes(v) / numpy.frombuffer(v, "S1")
+                work on it. Keeps the entry alive; while it exists, assigning
+                `sequence` or `quality` raises BufferError.
+            )pbdoc")
+        .def_property_readonly(
+            "quality_view",
+            [](py::object self) -> py::object {
+                auto& e = self.cast<gio::fasta_entry&>();
+                if (!e.quality) return py::none();
+                return pygg::make_byte_view(self, *e.quality, pygg::entry_view_pin(self, &e));
+            },
+            "Read-only memoryview over the quality bytes (None for FASTA). "
+            "Same lifetime rules as sequence_view.")
+        .def("to_packed",
+             [](const gio::fasta_entry& e) {
+                 return pygg::packed_sequence::encode(e.sequence, e.name);
+             },
+             py::call_guard<py::gil_scoped_release>(),
+             "Encode the sequence as a PackedSequence named after the record, "
+             "without going through a Python str.")
         .def("is_fastq",
              [](const gio::fasta_entry& e) { return e.quality.has_value(); },
              "Whether this record carries quality scores (i.e. came from FASTQ).")
@@ -52,9 +318,61 @@ inline void bind_fasta_entry(py::module_& m) {
         });
 }
 
+inline void bind_fasta_chunk(py::module_& m) {
+    using chunk_t = pygg::fasta_chunk;
+    py::class_<chunk_t>(m, "FastaChunk", R"pbdoc(
+        A window of at most `chunk_size` bases from one FASTA/FASTQ record,
+        yielded by FastaReader(path, chunk_size=...).
+
+        `start` is the window's 0-based offset within the record, and `last`
+        marks the window that ends it. Sequence / quality are available as str
+        or zero-copy (sequence_view / quality_view), like FastaEntry.
+    )pbdoc")
+        .def_readonly("name", &chunk_t::name, "Record name.")
+        .def_readonly("comment", &chunk_t::comment, "Record header comment.")
+        .def_readonly("start", &chunk_t::start,
+                      "0-based offset of this window within the record.")
+        .def_readonly("sequence", &chunk_t::sequence, "Bases of this window.")
+        .def_readonly("quality", &chunk_t::quality,
+                      "Qualities of this window (FASTQ only; None for FASTA).")
+        .def_readonly("last", &chunk_t::last,
+                      "Whether this window is the record's final one.")
+        .def_property_readonly(
+            "end", [](const chunk_t& c) { return c.start + c.sequence.size(); },
+            "0-based exclusive end of this window within the record.")
+        .def_property_readonly(
+            "sequence_view",
+            [](py::object self) {
+                return pygg::make_byte_view(self, self.cast<chunk_t&>().sequence);
+            },
+            "Read-only memoryview over this window's bases (no copy).")
+        .def_property_readonly(
+            "quality_view",
+            [](py::object self) -> py::object {
+                const auto& q = self.cast<chunk_t&>().quality;
+                if (!q) return py::none();
+                return pygg::make_byte_view(self, *q);
+            },
+            "Read-only memoryview over this window's qualities (None for FASTA).")
+        .def("to_packed",
+             [](const chunk_t& c) { return pygg::packed_sequence::encode(c.sequence, c.name); },
+             py::call_guard<py::gil_scoped_release>(),
+             "Encode this window as a PackedSequence (named after the record).")
+        .def("__len__", [](const chunk_t& c) { return c.sequence.size(); })
+        .def("__repr__", [](const chunk_t& c) {
+            return "FastaChunk(name='" + c.name + "', start=" +
+                   std::to_string(c.start) + ", len=" +
+                   std::to_string(c.sequence.size()) +
+                   (c.last ? ", last=True)" : ")");
+        });
+}
+
 inline void bind_fasta_reader(py::module_& m) {
     // FastaEntry must already be registered (bind_fasta_entry).
-    py::class_<gio::fasta_reader>(m, "FastaReader", R"pbdoc(
+    bind_fasta_chunk(m);
+
+    using handle_t = pygg::fasta_reader_handle;
+    py::class_<handle_t>(m, "FastaReader", R"pbdoc(
         A single-pass iterator over the records of a FASTA or FASTQ file.
 
         Iterate it directly to get FastaEntry objects::
@@ -66,34 +384,71 @@ inline void bind_fasta_reader(py::module_& m) {
         gzip/BGZF-compressed (`.gz`) inputs are accepted. The reader owns an
         htslib handle and is single-pass — it cannot be restarted or iterated twice.
 
+        With chunk_size set, it yields FastaChunk windows of at most that many
+        bases instead, streaming long records with bounded memory::
+
+            for w in pygenogrove.FastaReader("genome.fa", chunk_size=1 << 20):
+                process(w.name, w.start, w.sequence_view)
+
         Parameters
         ----------
         path : str
             Path to the FASTA/FASTQ file. A missing/unreadable file raises.
         skip_empty_sequences : bool, optional
             Skip records whose sequence is empty (default False).
+        chunk_size : int, optional
+            Yield FastaChunk windows of at most this many bases (default None:
+            whole FastaEntry records). A malformed file raises RuntimeError.
     )pbdoc")
-        .def(py::init([](const std::string& path, bool skip_empty_sequences) {
-                 gio::fasta_reader_options opts;
-                 opts.skip_empty_sequences = skip_empty_sequences;
-                 return std::make_unique<gio::fasta_reader>(path, opts);
+        .def(py::init([](const std::string& path, bool skip_empty_sequences,
+                         std::optional<std::size_t> chunk_size) {
+                 auto h = std::make_unique<handle_t>();
+                 if (chunk_size) {
+                     h->chunked = std::make_unique<pygg::fasta_chunk_reader>(
+                         path, *chunk_size, skip_empty_sequences);
+                 } else {
+                     gio::fasta_reader_options opts;
+                     opts.skip_empty_sequences = skip_empty_sequences;
+                     h->whole = std::make_unique<gio::fasta_reader>(path, opts);
+                 }
+                 return h;
              }),
-             py::arg("path"), py::arg("skip_empty_sequences") = false)
-        .def("__iter__",
-             [](gio::fasta_reader& r) -> gio::fasta_reader& { return r; })
+             py::arg("path"), py::arg("skip_empty_sequences") = false,
+             py::arg("chunk_size") = py::none())
+        .def("__iter__", [](handle_t& r) -> handle_t& { return r; })
         .def("__next__",
-             [](gio::fasta_reader& r) {
+             [](handle_t& r) -> py::object {
+                 // Disk read / parse touches no Python objects; the GIL is
+                 // reacquired before the record is converted.
+                 if (r.chunked) {
+                     pygg::fasta_chunk chunk;
+                     bool ok;
+                     {
+                         py::gil_scoped_release release;
+                         ok = r.chunked->read_next(chunk);
+                     }
+                     if (!ok) throw py::stop_iteration();
+                     return py::cast(std::move(chunk));
+                 }
                  gio::fasta_entry entry;
-                 if (!r.read_next(entry)) {
-                     throw py::stop_iteration();
+                 bool ok;
+                 {
+                     py::gil_scoped_release release;
+                     ok = r.whole->read_next(entry);
                  }
-                 return entry;
+                 if (!ok) throw py::stop_iteration();
+                 return py::cast(std::move(entry));
+             })
+        .def("get_error_message",
+             [](const handle_t& r) {
+                 return r.chunked ? r.chunked->get_error_message()
+                                  : r.whole->get_error_message();
              },
-             // Disk read / parse touches no Python objects; the GIL is reacquired
-             // before the returned entry is converted.
-             py::call_guard<py::gil_scoped_release>())
-        .def("get_error_message", &gio::fasta_reader::get_error_message,
              "Error message from the most recent read; empty on clean EOF.")
-        .def("get_current_line", &gio::fasta_reader::get_current_line,
+        .def("get_current_line",
+             [](const handle_t& r) -> std::size_t {
+                 return r.chunked ? r.chunked->get_current_line()
+                                  : r.whole->get_current_line();
+             },
              "1-based physical line number consumed so far; 0 before the first read.");
-}
\ No newline at end of file
+}
@@ -0,0 +1,136 @@
+/*
+ * kmer_source — feeding k-mers from FASTA/FASTQ input into C++ consumers
+ * (KmerGrove.from_sequences, the k-mer counter and sketches) without building a
+ * Python object per sequence or per k-mer.
+ *
+ * for_each_reader_kmer drains a FastaReader in either mode: whole records go
+ * straight through the rolling ASCII encoder; chunked windows are stitched by
+ * carrying the previous window's last k-1 bases, so a k-mer spanning a window
+ * boundary is still seen exactly once. A bare path is read chunked, keeping
+ * memory bounded on chromosome-scale records. An optional Phred threshold masks
+ * low-quality FASTQ bases to 'N' on the way through.
+ *
+ * sort_unique is the parallel dedupe used before a sorted bulk build: slices
+ * are sorted on worker threads, merged pairwise in parallel rounds, then
+ * uniqued.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../data_type/packed_sequence.hpp"
+#include "fasta_reader.hpp"
+
+namespace pygg {
+
+// Chunk size used when a k-mer consumer is handed a path instead of a reader.
+inline constexpr std::size_t kmer_source_chunk = std::size_t{1} << 20;
+
+inline unsigned resolve_threads(unsigned threads) {
+    return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Replace every base whose Phred score (offset 33) is below min_quality by 'N',
+// so the k-mer encoders skip any k-mer covering it.
+inline void mask_low_quality(std::string& seq, std::string_view qual,
+                             unsigned min_quality) {
+    const std::size_t n = std::min(seq.size(), qual.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (static_cast<unsigned char>(qual[i]) < 33 + min_quality) seq[i] = 'N';
+    }
+}
+
+// fn(sequence, origin): one contiguous stretch of a record, `origin` being the
+// 0-based record offset of its first base. Stretches of one record arrive in
+// order and overlap by k-1 bases; fn must not double count those. With
+// min_quality > 0, FASTQ bases below it arrive masked to 'N'.
+template <typename Fn>
+void for_each_reader_stretch(fasta_reader_handle& reader, unsigned k, Fn&& fn,
+                             unsigned min_quality = 0) {
+    if (reader.whole) {
+        for (gio::fasta_entry e; reader.whole->read_next(e); e = gio::fasta_entry{}) {
+            if (min_quality && e.quality) {
+                mask_low_quality(e.sequence, *e.quality, min_quality);
+            }
+            fn(std::string_view(e.sequence), std::size_t{0});
+        }
+        return;
+    }
+    std::string tail;  // last k-1 bases of the previous window of this record
+    std::string joined;
+    for (fasta_chunk c; reader.chunked->read_next(c);) {
+        if (c.start == 0) tail.clear();
+        if (min_quality && c.quality) {
+            mask_low_quality(c.sequence, *c.quality, min_quality);
+        }
+        joined.assign(tail);
+        joined += c.sequence;
+        fn(std::string_view(joined), c.start - tail.size());
+        if (c.last) {
+            tail.clear();
+        } else {
+            const std::size_t keep = std::min<std::size_t>(k - 1, joined.size());
+            tail.assign(joined, joined.size() - keep, keep);
+        }
+    }
+}
+
+// Every k-mer of every record as fn(encoding). Window stitching never repeats a
+// k-mer: a stretch's first k-1 bases are the carried tail, which can only
+// complete k-mers that end in the new window.
+template <typename Fn>
+void for_each_reader_kmer(fasta_reader_handle& reader, unsigned k, bool canonical,
+                          std::size_t step, Fn&& fn) {
+    for_each_reader_stretch(reader, k, [&](std::string_view seq, std::size_t origin) {
+        for_each_kmer_ascii(seq, k, canonical, step,
+                            [&](std::size_t, uint64_t enc) { fn(enc); }, origin);
+    });
+}
+
+// A chunked reader over `path` for consumers given a file name.
+inline fasta_reader_handle open_kmer_source(const std::string& path) {
+    fasta_reader_handle h;
+    h.chunked = std::make_unique<fasta_chunk_reader>(path, kmer_source_chunk, false);
+    return h;
+}
+
+inline void sort_unique(std::vector<uint64_t>& v, unsigned threads) {
+    threads = resolve_threads(threads);
+    const std::size_t n = v.size();
+    if (threads <= 1 || n < (std::size_t{1} << 16)) {
+        std::sort(v.begin(), v.end());
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+        return;
+    }
+    std::vector<std::size_t> bounds(threads + 1);
+    for (unsigned t = 0; t <= threads; ++t) bounds[t] = n * t / threads;
+    auto at = [&](std::size_t slice) {
+        return v.begin() + static_cast<std::ptrdiff_t>(
+                               bounds[std::min<std::size_t>(slice, threads)]);
+    };
+    {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] { std::sort(at(t), at(t + 1)); });
+        }
+        for (auto& w : workers) w.join();
+    }
+    for (std::size_t width = 1; width < threads; width *= 2) {
+        std::vector<std::thread> workers;
+        for (std::size_t s = 0; s + width < threads; s += 2 * width) {
+            workers.emplace_back(
+                [&, s, width] { std::inplace_merge(at(s), at(s + width), at(s + 2 * width)); });
+        }
+        for (auto& w : workers) w.join();
+    }
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+
+}  // namespace pygg
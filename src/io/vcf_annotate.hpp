@@ -0,0 +1,317 @@
+/*
+ * annotate_vcf — stream a VCF/BCF, intersect every record against a BED/GFF
+ * grove (or a partial GroveView over one) in C++, and write the overlapping
+ * features' fields back out as INFO tags (VCF/BCF) or columns (TSV).
+ *
+ * genogrove's vcf_reader is read-only and decodes every record into a
+ * vcf_entry, so this drives htslib directly: records are read with bcf_read,
+ * only their position is looked at, the new INFO strings are attached with
+ * bcf_update_info_string and the record is written back untouched otherwise.
+ * Nothing crosses into Python per record.
+ *
+ * The annotation sources are the typed groves' payloads; annotation_field()
+ * names which payload fields a `fields=[...]` entry can refer to.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <htslib/hts.h>
+#include <htslib/vcf.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <genogrove/data_type/genomic_coordinate.hpp>
+#include <genogrove/io/bed_reader.hpp>
+#include <genogrove/io/gff_reader.hpp>
+#include <genogrove/structure/grove/grove.hpp>
+#include <genogrove/structure/grove/grove_view.hpp>
+
+namespace py = pybind11;
+namespace gio = genogrove::io;
+namespace gdt = genogrove::data_type;
+namespace ggs = genogrove::structure;
+
+// ---- Payload field lookup: one overload per annotatable payload type ----
+
+// BED: the named columns (chrom / name / score / strand).
+inline std::optional<std::string> annotation_field(const gio::bed_entry& e,
+                                                   const std::string& field) {
+    if (field == "chrom") return e.chrom;
+    if (field == "name") return e.name;
+    if (field == "score" && e.score) return std::to_string(*e.score);
+    if (field == "strand" && e.strand) return std::string(1, *e.strand);
+    return std::nullopt;
+}
+
+// GFF/GTF: the fixed columns (seqid / source / type / strand / score / phase),
+// else a column-9 attribute (gene_id, gene_name, ...).
+inline std::optional<std::string> annotation_field(const gio::gff_entry& e,
+                                                   const std::string& field) {
+    if (field == "seqid") return e.seqid;
+    if (field == "source") return e.source;
+    if (field == "type") return e.type;
+    if (field == "strand") {
+        return e.strand ? std::optional<std::string>(std::string(1, *e.strand))
+                        : std::nullopt;
+    }
+    if (field == "score") {
+        return e.score ? std::optional<std::string>(std::to_string(*e.score))
+                       : std::nullopt;
+    }
+    if (field == "phase") {
+        return e.phase ? std::optional<std::string>(std::to_string(*e.phase))
+                       : std::nullopt;
+    }
+    auto it = e.attributes.find(field);
+    if (it == e.attributes.end()) return std::nullopt;
+    return it->second;
+}
+
+template <typename DataT>
+std::vector<std::string> default_annotation_fields() {
+    if constexpr (std::is_same_v<DataT, gio::gff_entry>) {
+        return {"gene_id"};
+    } else {
+        return {"name"};
+    }
+}
+
+namespace pygg {
+
+struct vcf_annotate_options {
+    std::vector<std::string> fields;
+    std::string info_prefix;
+    bool tsv = false;
+    int threads = 1;
+};
+
+struct vcf_annotate_stats {
+    std::size_t records = 0;
+    std::size_t annotated = 0;
+};
+
+// INFO string values may not contain ';' '=' or whitespace (',' separates the
+// values of a Number=. tag, which is how multiple overlaps are listed).
+inline std::string info_safe(std::string v) {
+    std::replace_if(
+        v.begin(), v.end(),
+        [](char c) { return c == ';' || c == '=' || c == ' ' || c == '\t'; }, '_');
+    return v;
+}
+
+// Distinct values of `field` across the hits, in hit order, comma-joined.
+template <typename Keys>
+std::string join_field(const Keys& keys, const std::string& field) {
+    std::vector<std::string> seen;
+    for (auto* k : keys) {
+        auto v = annotation_field(k->get_data(), field);
+        if (v && !v->empty() && std::find(seen.begin(), seen.end(), *v) == seen.end()) {
+            seen.push_back(std::move(*v));
+        }
+    }
+    std::string out;
+    for (const auto& v : seen) {
+        if (!out.empty()) out += ',';
+        out += v;
+    }
+    return out;
+}
+
+// `Source` is a grove or grove_view: anything with intersect(key, index).
+template <typename Source>
+vcf_annotate_stats annotate_vcf(const std::string& vcf_path, Source& source,
+                                const std::string& out_path,
+                                const vcf_annotate_options& opts) {
+    using hts_ptr = std::unique_ptr<htsFile, decltype(&hts_close)>;
+    using hdr_ptr = std::unique_ptr<bcf_hdr_t, decltype(&bcf_hdr_destroy)>;
+    using rec_ptr = std::unique_ptr<bcf1_t, decltype(&bcf_destroy)>;
+
+    hts_ptr in(hts_open(vcf_path.c_str(), "r"), &hts_close);
+    if (!in) {
+        throw std::runtime_error("annotate_vcf: cannot open " + vcf_path);
+    }
+    hdr_ptr hdr(bcf_hdr_read(in.get()), &bcf_hdr_destroy);
+    if (!hdr) {
+        throw std::runtime_error("annotate_vcf: cannot read VCF header: " + vcf_path);
+    }
+    if (opts.threads > 1) {
+        hts_set_threads(in.get(), opts.threads);
+    }
+
+    std::vector<std::string> tags;
+    for (const auto& f : opts.fields) {
+        tags.push_back(opts.info_prefix + f);
+    }
+
+    hdr_ptr out_hdr(nullptr, &bcf_hdr_destroy);
+    hts_ptr out(nullptr, &hts_close);
+    std::ofstream tsv;
+    if (opts.tsv) {
+        tsv.open(out_path);
+        if (!tsv) {
+            throw std::runtime_error("Failed to open file for writing: " + out_path);
+        }
+        tsv << "#CHROM\tPOS\tID\tREF\tALT";
+        for (const auto& t : tags) tsv << '\t' << t;
+        tsv << '\n';
+    } else {
+        out_hdr.reset(bcf_hdr_dup(hdr.get()));
+        for (const auto& t : tags) {
+            const std::string line = "##INFO=<ID=" + t +
+                                     ",Number=.,Type=String,Description=\"" + t +
+                                     " of overlapping features (pygenogrove)\">";
+            if (bcf_hdr_append(out_hdr.get(), line.c_str()) < 0) {
+                throw std::runtime_error("annotate_vcf: bad INFO tag '" + t + "'");
+            }
+        }
+        if (bcf_hdr_sync(out_hdr.get()) < 0) {
+            throw std::runtime_error("annotate_vcf: cannot build output header");
+        }
+        // htslib picks the container from the mode: BCF, bgzipped or plain VCF.
+        const std::string_view p(out_path);
+        const char* mode = p.ends_with(".bcf") ? "wb"
+                           : p.ends_with(".gz") ? "wz"
+                                                : "w";
+        out.reset(hts_open(out_path.c_str(), mode));
+        if (!out) {
+            throw std::runtime_error("Failed to open file for writing: " + out_path);
+        }
+        if (opts.threads > 1) {
+            hts_set_threads(out.get(), opts.threads);
+        }
+        if (bcf_hdr_write(out.get(), out_hdr.get()) < 0) {
+            throw std::runtime_error("Failed to write VCF header: " + out_path);
+        }
+    }
+
+    vcf_annotate_stats stats;
+    rec_ptr rec(bcf_init(), &bcf_destroy);
+    std::vector<std::string> values(tags.size());
+    int rc = 0;
+    while ((rc = bcf_read(in.get(), hdr.get(), rec.get())) == 0) {
+        ++stats.records;
+        const std::string chrom = bcf_hdr_id2name(hdr.get(), rec->rid);
+        const auto start = static_cast<std::size_t>(rec->pos);
+        const auto span = static_cast<std::size_t>(std::max<hts_pos_t>(rec->rlen, 1));
+        // '*' matches features on either strand (VCF records have none).
+        gdt::genomic_coordinate query('*', start, start + span - 1);
+        auto result = source.intersect(query, chrom);
+        const auto& keys = result.get_keys();
+        if (!keys.empty()) {
+            ++stats.annotated;
+        }
+        for (std::size_t i = 0; i < tags.size(); ++i) {
+            values[i] = keys.empty() ? std::string() : join_field(keys, opts.fields[i]);
+        }
+
+        if (opts.tsv) {
+            bcf_unpack(rec.get(), BCF_UN_STR);
+            tsv << chrom << '\t' << (rec->pos + 1) << '\t' << rec->d.id << '\t'
+                << rec->d.allele[0] << '\t';
+            if (rec->n_allele < 2) tsv << '.';
+            for (int a = 1; a < rec->n_allele; ++a) {
+                tsv << (a > 1 ? "," : "") << rec->d.allele[a];
+            }
+            for (const auto& v : values) tsv << '\t' << (v.empty() ? "." : v);
+            tsv << '\n';
+        } else {
+            for (std::size_t i = 0; i < tags.size(); ++i) {
+                if (values[i].empty()) continue;
+                const std::string v = info_safe(values[i]);
+                bcf_update_info_string(out_hdr.get(), rec.get(), tags[i].c_str(),
+                                       v.c_str());
+            }
+            if (bcf_write(out.get(), out_hdr.get(), rec.get()) < 0) {
+                throw std::runtime_error("Failed to write VCF record: " + out_path);
+            }
+        }
+    }
+    if (rc < -1) {
+        throw std::runtime_error("annotate_vcf: malformed record after line " +
+                                 std::to_string(stats.records) + " in " + vcf_path);
+    }
+    if (opts.tsv && !tsv) {
+        throw std::runtime_error("Failed to write TSV to file: " + out_path);
+    }
+    return stats;
+}
+
+}  // namespace pygg
+
+// One annotate_vcf overload per annotation source (Grove or GroveView over a
+// BED/GFF payload); pybind resolves them by the `grove` argument's type.
+template <typename SourceT, typename DataT, bool release_gil>
+void bind_annotate_vcf_for(py::module_& m) {
+    m.def(
+        "annotate_vcf",
+        [](const std::string& vcf_path, SourceT& grove, const std::string& out_path,
+           std::optional<std::vector<std::string>> fields,
+           const std::string& info_prefix, const std::string& output, int threads) {
+            if (output != "vcf" && output != "tsv") {
+                throw std::invalid_argument(
+                    "annotate_vcf: output must be 'vcf' or 'tsv', got '" + output +
+                    "'");
+            }
+            pygg::vcf_annotate_options opts;
+            opts.fields = fields ? std::move(*fields)
+                                 : default_annotation_fields<DataT>();
+            opts.info_prefix = info_prefix;
+            opts.tsv = output == "tsv";
+            opts.threads = threads;
+            pygg::vcf_annotate_stats stats;
+            if constexpr (release_gil) {
+                py::gil_scoped_release rel;
+                stats = pygg::annotate_vcf(vcf_path, grove, out_path, opts);
+            } else {
+                stats = pygg::annotate_vcf(vcf_path, grove, out_path, opts);
+            }
+            return py::make_tuple(stats.records, stats.annotated);
+        },
+        py::arg("vcf_path"), py::arg("grove"), py::arg("out_path"),
+        py::arg("fields") = py::none(), py::arg("info_prefix") = "",
+        py::arg("output") = "vcf", py::arg("threads") = 1,
+        R"pbdoc(
+            annotate_vcf(vcf_path, grove, out_path, fields=None, info_prefix="",
+                         output="vcf", threads=1) -> tuple[int, int]
+
+            Stream the VCF/BCF at vcf_path, intersect each record's reference
+            span (any strand) with `grove` on the record's CHROM index, and write
+            the overlapping features' `fields` to out_path. Returns
+            (records, records_with_an_overlap).
+
+            `grove` is a BedGrove / GffGrove or a BedGroveView / GffGroveView, so
+            the annotation database need not be loaded whole. `fields` name
+            payload fields: BED chrom / name / score / strand; GFF seqid /
+            source / type / strand / score / phase or any column-9 attribute
+            (e.g. gene_id, gene_name). Default: ["name"] for BED, ["gene_id"]
+            for GFF. Distinct values are comma-joined in hit order.
+
+            output="vcf" copies every record and adds one Number=. String INFO
+            tag per field (named info_prefix + field); the container follows
+            out_path (.bcf -> BCF, .gz -> bgzip VCF, else plain VCF). output="tsv"
+            writes CHROM POS ID REF ALT plus one column per field ('.' when
+            nothing overlaps). threads > 1 adds htslib (de)compression threads.
+        )pbdoc");
+}
+
+inline void bind_annotate_vcf(py::module_& m) {
+    using gc = gdt::genomic_coordinate;
+    // A Grove query is read-only, so the GIL is dropped for the whole pass. A
+    // GroveView query pages blocks into its cache (not thread-safe), so — as
+    // for GroveView.intersect — the GIL stays held.
+    bind_annotate_vcf_for<ggs::grove<gc, gio::bed_entry>, gio::bed_entry, true>(m);
+    bind_annotate_vcf_for<ggs::grove<gc, gio::gff_entry>, gio::gff_entry, true>(m);
+    bind_annotate_vcf_for<ggs::grove_view<gc, gio::bed_entry>, gio::bed_entry, false>(m);
+    bind_annotate_vcf_for<ggs::grove_view<gc, gio::gff_entry>, gio::gff_entry, false>(m);
+}
@@ -4,32 +4,197 @@
  * and follows the BamReader binding's shape.
  *
  * vcf_entry is not serializable (it holds vectors / variant-valued maps / nested
- * sample genotypes), so there is no typed `VcfGrove`. The intended flow is to
- * load variants into the universal Grove as JSON: build the key with
- * VcfEntry.to_coordinate() and a payload with VcfEntry.to_dict() (or your own
- * dict from the full record).
+ * sample genotypes), so there is no VcfEntry-typed grove. Site-level fields go
+ * into the universal Grove as JSON (VcfEntry.to_coordinate() + to_dict());
+ * genotypes go into VariantGrove, whose packed payload lives in
+ * data_type/variant_genotypes.hpp.
  *
  * INFO and per-sample FORMAT values are htslib-typed variants
  * (bool / list[int] / list[float] / str), converted to native Python objects by
  * pybind11/stl.h's variant + map casters. Read-only — the reader yields fresh
  * copies, so there is nothing to mutate back.
+ *
+ * The Python VcfReader wraps gio::vcf_reader in a vcf_reader_handle that also
+ * carries the info_fields / samples / format_fields selectors. An empty
+ * selector turns off the matching parse_* option; the rest are applied in C++
+ * before the entry is converted — which is where a wide cohort's cost goes (one
+ * SampleGenotype + FORMAT dict per sample). genogrove's reader doesn't expose
+ * its bcf_hdr_t, so a sample selection switches to vcf_sample_reader.hpp, which
+ * reads through htslib with bcf_hdr_set_samples and never unpacks the other
+ * columns. read_genotypes() skips the per-record objects entirely and fills
+ * NumPy dosage / phase matrices.
  */
 #pragma once
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
-#include <pybind11/stl.h>  // vector / unordered_map / variant casters
+#include <pybind11/stl.h>  // vector / unordered_map / variant / optional casters
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <genogrove/data_type/genomic_coordinate.hpp>
 #include <genogrove/io/vcf_reader.hpp>
 
+#include "entry_interval.hpp"
+#include "vcf_sample_reader.hpp"
+
 namespace py = pybind11;
 namespace gio = genogrove::io;
 namespace gdt = genogrove::data_type;
 
+namespace pygg {
+
+// The Python VcfReader: gio::vcf_reader plus the field / sample selectors, or
+// vcf_sample_reader when samples are selected (htslib then decodes only those
+// columns). Every record goes through read_next(), so __next__ and
+// read_genotypes() see the same (already narrowed) view of the file.
+class vcf_reader_handle {
+  public:
+    vcf_reader_handle(const std::string& path, const gio::vcf_reader_options& opts,
+                      std::optional<std::vector<std::string>> info_fields,
+                      std::optional<std::vector<std::string>> samples,
+                      std::optional<std::vector<std::string>> format_fields)
+        : parse_samples_(opts.parse_samples) {
+        if (info_fields) {
+            info_fields_.emplace(info_fields->begin(), info_fields->end());
+        }
+        if (format_fields) {
+            format_fields_.emplace(format_fields->begin(), format_fields->end());
+        }
+        if (samples) {
+            std::unordered_set<std::string> given;
+            for (const auto& name : *samples) {
+                if (!given.insert(name).second) {
+                    throw std::invalid_argument("VcfReader: sample '" + name +
+                                                "' is selected twice");
+                }
+            }
+        }
+        if (samples && !samples->empty() && opts.parse_samples) {
+            // The order given is the order the samples (and genotype-matrix
+            // columns) come back in.
+            subset_ = std::make_unique<vcf_sample_reader>(path, opts, *samples,
+                                                          info_fields_, format_fields_);
+            sample_names_ = std::move(*samples);
+            return;
+        }
+        reader_.emplace(path, opts);
+        sample_names_ = reader_->get_sample_names();
+        if (samples) {
+            // Samples are not parsed here ([] or parse_samples=False), so the
+            // selection only narrows the reported names.
+            for (const auto& name : *samples) {
+                if (std::find(sample_names_.begin(), sample_names_.end(), name) ==
+                    sample_names_.end()) {
+                    throw std::invalid_argument("VcfReader: unknown sample '" +
+                                                name + "'");
+                }
+            }
+            sample_names_ = std::move(*samples);
+        }
+    }
+
+    bool read_next(gio::vcf_entry& e) {
+        if (subset_) {
+            return subset_->read_next(e);  // selectors applied while decoding
+        }
+        if (!reader_->read_next(e)) {
+            return false;
+        }
+        if (info_fields_) {
+            for (auto it = e.info.begin(); it != e.info.end();) {
+                it = info_fields_->count(it->first) ? std::next(it) : e.info.erase(it);
+            }
+        }
+        if (format_fields_) {
+            // GT is decoded into gt_alleles / phased regardless, so it stays in
+            // the FORMAT column list whenever it was present.
+            std::erase_if(e.format, [this](const std::string& tag) {
+                return tag != "GT" && !format_fields_->count(tag);
+            });
+            for (auto& s : e.samples) {
+                for (auto it = s.fields.begin(); it != s.fields.end();) {
+                    it = format_fields_->count(it->first) ? std::next(it)
+                                                          : s.fields.erase(it);
+                }
+            }
+        }
+        return true;
+    }
+
+    // Read up to n records into row-major (records x samples) buffers: dosage is
+    // the count of non-REF alleles (-1 if any allele is missing or the sample has
+    // no GT), phased mirrors SampleGenotype.phased. Returns the rows read.
+    std::size_t read_genotypes(std::size_t n, std::vector<int8_t>& dosage,
+                               std::vector<uint8_t>& phased) {
+        if (subset_) {
+            return subset_->read_genotypes(n, dosage, phased);
+        }
+        const std::size_t width = sample_names_.size();
+        dosage.reserve(n * width);
+        phased.reserve(n * width);
+        std::size_t rows = 0;
+        for (gio::vcf_entry e; rows < n && read_next(e); e = gio::vcf_entry{}) {
+            for (std::size_t j = 0; j < width; ++j) {
+                int8_t d = -1;
+                bool ph = false;
+                if (j < e.samples.size() && e.samples[j].has_gt &&
+                    !e.samples[j].gt_alleles.empty()) {
+                    const auto& s = e.samples[j];
+                    d = 0;
+                    for (auto a : s.gt_alleles) {
+                        if (a < 0) {
+                            d = -1;
+                            break;
+                        }
+                        d += a > 0 ? 1 : 0;
+                    }
+                    ph = s.phased;
+                }
+                dosage.push_back(d);
+                phased.push_back(ph ? 1 : 0);
+            }
+            ++rows;
+        }
+        return rows;
+    }
+
+    std::string header() {
+        return subset_ ? subset_->get_header() : reader_->get_header();
+    }
+    std::vector<std::string> contigs() {
+        return subset_ ? subset_->get_contigs() : reader_->get_contigs();
+    }
+    std::string error_message() {
+        return subset_ ? subset_->get_error_message() : reader_->get_error_message();
+    }
+    std::size_t current_line() {
+        return subset_ ? subset_->get_current_line() : reader_->get_current_line();
+    }
+    const std::vector<std::string>& sample_names() const { return sample_names_; }
+    bool parse_samples() const { return parse_samples_; }
+
+  private:
+    std::optional<gio::vcf_reader> reader_;
+    std::unique_ptr<vcf_sample_reader> subset_;
+    bool parse_samples_;
+    std::vector<std::string> sample_names_;
+    std::optional<std::unordered_set<std::string>> info_fields_;
+    std::optional<std::unordered_set<std::string>> format_fields_;
+};
+
+}  // namespace pygg
+
 inline void bind_vcf_reader(py::module_& m) {
     // ---- Per-sample genotype + FORMAT data ----
     py::class_<gio::sample_genotype>(m, "SampleGenotype", R"pbdoc(
@@ -104,14 +269,9 @@ inline void bind_vcf_reader(py::module_& m) {
                     "(<DEL>, *, ., breakends).")
         .def("to_coordinate",
              [](const gio::vcf_entry& e) {
-                 if (e.end <= e.start) {
-                     throw std::invalid_argument(
-                         "VcfEntry spans no reference bases; cannot derive a "
-                         "coordinate");
-                 }
                  // VCF has no strand -> '.'; half-open [start, end) -> closed
-                 // [start, end - 1].
-                 return gdt::genomic_coordinate('.', e.start, e.end - 1);
+                 // [start, end - 1] (entry_interval.hpp).
+                 return genomic_coordinate_from_entry(e);
              },
              R"pbdoc(
                  Derive the GenomicCoordinate key for this variant (unstranded
@@ -142,54 +302,127 @@ inline void bind_vcf_reader(py::module_& m) {
         });
 
     // ---- The reader ----
-    py::class_<gio::vcf_reader>(m, "VcfReader", R"pbdoc(
+    py::class_<pygg::vcf_reader_handle>(m, "VcfReader", R"pbdoc(
         Single-pass iterator over a VCF/BCF file (plain, bgzip-ed, or binary BCF;
         htslib auto-detects). Yields VcfEntry. Not thread-safe — drive one reader
         per thread.
 
             for v in pygenogrove.VcfReader("calls.vcf", skip_filtered=True):
                 ...
+
+        For wide cohorts, narrow what is parsed and converted with info_fields /
+        samples / format_fields, or skip per-record objects altogether with
+        read_genotypes():
+
+            r = pygenogrove.VcfReader("cohort.bcf", samples=["NA12878", "NA12891"])
+            dosage, phased = r.read_genotypes(10_000)
     )pbdoc")
         .def(py::init([](const std::string& path, bool parse_info,
                          bool parse_samples, bool skip_filtered,
-                         const std::string& region) {
+                         const std::string& region,
+                         std::optional<std::vector<std::string>> info_fields,
+                         std::optional<std::vector<std::string>> samples,
+                         std::optional<std::vector<std::string>> format_fields) {
                  gio::vcf_reader_options opts;
-                 opts.parse_info = parse_info;
-                 opts.parse_samples = parse_samples;
+                 // An empty selector means "none of them" — let the reader skip
+                 // that whole block rather than parse it and throw it away.
+                 opts.parse_info = parse_info && !(info_fields && info_fields->empty());
+                 opts.parse_samples = parse_samples && !(samples && samples->empty());
                  opts.skip_filtered = skip_filtered;
                  opts.region = region;
-                 return std::make_unique<gio::vcf_reader>(path, opts);
+                 return std::make_unique<pygg::vcf_reader_handle>(
+                     path, opts, std::move(info_fields), std::move(samples),
+                     std::move(format_fields));
              }),
              py::arg("path"), py::arg("parse_info") = true,
              py::arg("parse_samples") = true, py::arg("skip_filtered") = false,
-             py::arg("region") = "",
-             "Open a VCF/BCF file. parse_info / parse_samples toggle INFO and "
-             "per-sample parsing; skip_filtered drops non-PASS records. region "
-             "is an htslib region string (\"chr:start-end\", 1-based inclusive); "
-             "when set, only overlapping records are yielded and a CSI/TBI-indexed "
-             "bgzip VCF or a BCF is required. Empty (default) reads the whole file.")
+             py::arg("region") = "", py::arg("info_fields") = py::none(),
+             py::arg("samples") = py::none(), py::arg("format_fields") = py::none(),
+             R"pbdoc(
+                 Open a VCF/BCF file. parse_info / parse_samples toggle INFO and
+                 per-sample parsing; skip_filtered drops non-PASS records. region
+                 is an htslib region string ("chr:start-end", 1-based inclusive);
+                 when set, only overlapping records are yielded and a
+                 CSI/TBI-indexed bgzip VCF or a BCF is required. Empty (default)
+                 reads the whole file.
+
+                 Selectors (None = keep everything; [] = keep nothing and skip
+                 parsing that block):
+
+                 - info_fields: INFO tags kept in VcfEntry.info.
+                 - samples: sample names kept, in the order given — VcfEntry.samples,
+                   get_sample_names() and read_genotypes() columns follow it.
+                   Raises ValueError for a name not in the header or given twice.
+                 - format_fields: FORMAT tags kept in SampleGenotype.fields (GT is
+                   always decoded).
+             )pbdoc")
         .def("__iter__",
-             [](gio::vcf_reader& r) -> gio::vcf_reader& { return r; })
+             [](pygg::vcf_reader_handle& r) -> pygg::vcf_reader_handle& { return r; })
         .def("__next__",
-             [](gio::vcf_reader& r) {
+             [](pygg::vcf_reader_handle& r) {
                  gio::vcf_entry entry;
                  if (!r.read_next(entry)) {
                      throw py::stop_iteration();
                  }
                  return entry;
              },
-             // htslib decode / parse touches no Python objects; the GIL is
-             // reacquired before the returned entry is converted.
+             // htslib decode / parse / selection touches no Python objects; the
+             // GIL is reacquired before the returned entry is converted.
              py::call_guard<py::gil_scoped_release>())
-        .def("get_header", &gio::vcf_reader::get_header,
+        .def("read_genotypes",
+             [](pygg::vcf_reader_handle& r, std::size_t n) {
+                 if (!r.parse_samples()) {
+                     throw std::invalid_argument(
+                         "read_genotypes() needs per-sample parsing "
+                         "(parse_samples=True)");
+                 }
+                 std::vector<int8_t> dosage;
+                 std::vector<uint8_t> phased;
+                 std::size_t rows = 0;
+                 {
+                     py::gil_scoped_release rel;
+                     rows = r.read_genotypes(n, dosage, phased);
+                 }
+                 const auto width =
+                     static_cast<py::ssize_t>(r.sample_names().size());
+                 const auto height = static_cast<py::ssize_t>(rows);
+                 py::array_t<int8_t> d({height, width});
+                 py::array_t<bool> p({height, width});
+                 if (!dosage.empty()) {
+                     std::memcpy(d.mutable_data(), dosage.data(), dosage.size());
+                     std::memcpy(p.mutable_data(), phased.data(), phased.size());
+                 }
+                 return py::make_tuple(d, p);
+             },
+             py::arg("n"),
+             R"pbdoc(
+                 read_genotypes(n) -> tuple[numpy.ndarray, numpy.ndarray]
+
+                 Consume up to n records and return (dosage, phased), both shaped
+                 (records, samples) with columns in get_sample_names() order.
+                 dosage is int8: the number of non-REF alleles in the call (0 / 1 /
+                 2 for a diploid), or -1 if any allele is missing or the sample
+                 has no GT. phased is a bool mask of '|' genotypes. Fewer than n
+                 rows means the reader hit the end of the file (0 rows at EOF).
+                 Shares the reader's position with iteration and honours
+                 skip_filtered / region / samples. Raises ValueError when the
+                 reader was opened with parse_samples=False.
+             )pbdoc")
+        .def("get_header",
+             [](pygg::vcf_reader_handle& r) { return r.header(); },
              "Full VCF header text (## meta lines + the #CHROM column line).")
-        .def("get_sample_names", &gio::vcf_reader::get_sample_names,
-             "Sample names in column order (empty for sites-only VCFs).")
-        .def("get_contigs", &gio::vcf_reader::get_contigs,
+        .def("get_sample_names",
+             [](const pygg::vcf_reader_handle& r) { return r.sample_names(); },
+             "Sample names in column order (empty for sites-only VCFs); the "
+             "`samples` selection when one was given.")
+        .def("get_contigs",
+             [](pygg::vcf_reader_handle& r) { return r.contigs(); },
              "Contig names declared in the header.")
-        .def("get_error_message", &gio::vcf_reader::get_error_message,
+        .def("get_error_message",
+             [](pygg::vcf_reader_handle& r) { return r.error_message(); },
              "Error message from the most recent read; empty on clean EOF.")
-        .def("get_current_line", &gio::vcf_reader::get_current_line,
+        .def("get_current_line",
+             [](pygg::vcf_reader_handle& r) { return r.current_line(); },
              "1-based index of the most recently consumed record (counts records "
              "dropped by skip_filtered too); 0 before the first read.");
 }
\ No newline at end of file
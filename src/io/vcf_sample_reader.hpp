@@ -0,0 +1,336 @@
+/*
+ * vcf_sample_reader — the VcfReader backend used when a `samples` selection is
+ * given. genogrove's vcf_reader hides its bcf_hdr_t and decodes every sample
+ * column, so a selection of 2 out of 2,500 samples used to cost a full decode
+ * per record. This reader drives htslib itself (a synced reader, for the same
+ * plain / bgzip / BCF and region handling) and narrows the header with
+ * bcf_hdr_set_samples before the first record, so htslib only unpacks the
+ * selected columns. Records are converted into the same gio::vcf_entry the
+ * default backend yields, with the info / format selectors applied while
+ * decoding; read_genotypes() reads the dosage matrix straight from the GT
+ * array without building entries at all.
+ */
+#pragma once
+
+#include <htslib/synced_bcf_reader.h>
+#include <htslib/vcf.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <genogrove/io/vcf_reader.hpp>
+
+namespace gio = genogrove::io;
+
+namespace pygg {
+
+// htslib INT / REAL values up to the vector end, missing values dropped, as
+// the vector type `Value` (a variant of the vcf_entry value maps) holds.
+template <typename Value>
+Value vcf_ints(const int32_t* v, int n) {
+    using vec = std::conditional_t<std::is_constructible_v<Value, std::vector<int32_t>>,
+                                   std::vector<int32_t>, std::vector<int64_t>>;
+    vec out;
+    for (int i = 0; i < n && v[i] != bcf_int32_vector_end; ++i) {
+        if (v[i] != bcf_int32_missing) out.push_back(v[i]);
+    }
+    return Value(std::move(out));
+}
+
+template <typename Value>
+Value vcf_floats(const float* v, int n) {
+    using vec = std::conditional_t<std::is_constructible_v<Value, std::vector<float>>,
+                                   std::vector<float>, std::vector<double>>;
+    vec out;
+    for (int i = 0; i < n && !bcf_float_is_vector_end(v[i]); ++i) {
+        if (!bcf_float_is_missing(v[i])) out.push_back(v[i]);
+    }
+    return Value(std::move(out));
+}
+
+class vcf_sample_reader {
+  public:
+    using tag_set = std::optional<std::unordered_set<std::string>>;
+
+    // `samples` are already validated (known, distinct) header names, in the
+    // order the entries / genotype columns should follow.
+    vcf_sample_reader(const std::string& path, const gio::vcf_reader_options& opts,
+                      const std::vector<std::string>& samples, tag_set info_fields,
+                      tag_set format_fields)
+        : sr_(bcf_sr_init(), &bcf_sr_destroy),
+          opts_(opts),
+          info_fields_(std::move(info_fields)),
+          format_fields_(std::move(format_fields)) {
+        if (!sr_) throw std::bad_alloc();
+        if (!opts.region.empty() && bcf_sr_set_regions(sr_.get(), opts.region.c_str(), 0) < 0) {
+            throw std::invalid_argument("VcfReader: invalid region '" + opts.region + "'");
+        }
+        if (!bcf_sr_add_reader(sr_.get(), path.c_str())) {
+            throw std::runtime_error("VcfReader: cannot open " + path + ": " +
+                                     bcf_sr_strerror(sr_->errnum));
+        }
+        hdr_ = bcf_sr_get_header(sr_.get(), 0);
+        header_ = header_text();  // before the sample columns are narrowed
+        for (const auto& name : samples) {
+            if (bcf_hdr_id2int(hdr_, BCF_DT_SAMPLE, name.c_str()) < 0) {
+                throw std::invalid_argument("VcfReader: unknown sample '" + name + "'");
+            }
+        }
+        std::string list;
+        for (const auto& name : samples) {
+            if (!list.empty()) list += ',';
+            list += name;
+        }
+        if (bcf_hdr_set_samples(hdr_, list.c_str(), 0) != 0) {
+            throw std::invalid_argument("VcfReader: cannot select samples " + list);
+        }
+        // htslib keeps the selected columns in file order; map them back to the
+        // order asked for.
+        order_.reserve(samples.size());
+        for (const auto& name : samples) {
+            order_.push_back(bcf_hdr_id2int(hdr_, BCF_DT_SAMPLE, name.c_str()));
+        }
+    }
+
+    ~vcf_sample_reader() {
+        std::free(ints_);
+        std::free(floats_);
+        std::free(chars_);
+        if (strings_) std::free(strings_[0]);
+        std::free(strings_);
+    }
+
+    vcf_sample_reader(const vcf_sample_reader&) = delete;
+    vcf_sample_reader& operator=(const vcf_sample_reader&) = delete;
+
+    bool read_next(gio::vcf_entry& e) {
+        bcf1_t* rec = next_record();
+        if (!rec) return false;
+        to_entry(rec, e);
+        return true;
+    }
+
+    // As vcf_reader_handle::read_genotypes, from the GT array of each record.
+    std::size_t read_genotypes(std::size_t n, std::vector<int8_t>& dosage,
+                               std::vector<uint8_t>& phased) {
+        const std::size_t width = order_.size();
+        dosage.reserve(n * width);
+        phased.reserve(n * width);
+        std::size_t rows = 0;
+        for (bcf1_t* rec; rows < n && (rec = next_record());) {
+            const int ploidy = genotypes(rec);
+            for (int s : order_) {
+                int8_t d = -1;
+                bool ph = false;
+                if (ploidy > 0) {
+                    const int32_t* a = ints_ + static_cast<std::size_t>(s) * ploidy;
+                    int called = 0;
+                    d = 0;
+                    for (int k = 0; k < ploidy && a[k] != bcf_int32_vector_end; ++k, ++called) {
+                        if (k > 0 && bcf_gt_is_phased(a[k])) ph = true;
+                        if (bcf_gt_is_missing(a[k])) d = -1;
+                        if (d >= 0 && bcf_gt_allele(a[k]) > 0) ++d;
+                    }
+                    if (called == 0) d = -1;
+                }
+                dosage.push_back(d);
+                phased.push_back(ph ? 1 : 0);
+            }
+            ++rows;
+        }
+        return rows;
+    }
+
+    const std::string& get_header() const { return header_; }
+
+    std::vector<std::string> get_contigs() const {
+        int n = 0;
+        const char** names = bcf_hdr_seqnames(hdr_, &n);
+        std::vector<std::string> out(names, names + n);
+        std::free(names);
+        return out;
+    }
+
+    const std::string& get_error_message() const { return error_; }
+    std::size_t get_current_line() const { return line_; }
+
+  private:
+    // The next record passing skip_filtered, or null at the end / on error.
+    bcf1_t* next_record() {
+        while (bcf_sr_next_line(sr_.get())) {
+            bcf1_t* rec = bcf_sr_get_line(sr_.get(), 0);
+            ++line_;
+            int what = BCF_UN_STR | BCF_UN_FLT;
+            if (opts_.parse_info) what |= BCF_UN_INFO;
+            if (opts_.parse_samples) what |= BCF_UN_FMT;
+            bcf_unpack(rec, what);
+            if (opts_.skip_filtered && rec->d.n_flt > 0 &&
+                bcf_has_filter(hdr_, rec, const_cast<char*>("PASS")) != 1) {
+                continue;
+            }
+            return rec;
+        }
+        if (sr_->errnum) error_ = bcf_sr_strerror(sr_->errnum);
+        return nullptr;
+    }
+
+    // GT values into ints_ (all selected samples, file order); the ploidy, or
+    // 0 when the record has no GT.
+    int genotypes(bcf1_t* rec) {
+        const int total = bcf_get_genotypes(hdr_, rec, &ints_, &n_ints_);
+        const int samples = bcf_hdr_nsamples(hdr_);
+        return total > 0 && samples > 0 ? total / samples : 0;
+    }
+
+    void to_entry(bcf1_t* rec, gio::vcf_entry& e) {
+        e = gio::vcf_entry{};
+        e.chrom = bcf_seqname(hdr_, rec);
+        e.ref = rec->d.allele[0];
+        e.start = static_cast<decltype(e.start)>(rec->pos);
+        e.end = static_cast<decltype(e.end)>(rec->pos + static_cast<int64_t>(e.ref.size()));
+        if (std::string_view(rec->d.id) != ".") e.id = rec->d.id;
+        for (int a = 1; a < rec->n_allele; ++a) {
+            if (std::string_view(rec->d.allele[a]) != ".") e.alt.emplace_back(rec->d.allele[a]);
+        }
+        e.qual_missing = bcf_float_is_missing(rec->qual);
+        e.qual = static_cast<decltype(e.qual)>(rec->qual);
+        for (int i = 0; i < rec->d.n_flt; ++i) {
+            e.filter.emplace_back(bcf_hdr_int2id(hdr_, BCF_DT_ID, rec->d.flt[i]));
+        }
+        if (opts_.parse_info) decode_info(rec, e);
+        if (opts_.parse_samples) decode_samples(rec, e);
+    }
+
+    void decode_info(bcf1_t* rec, gio::vcf_entry& e) {
+        using value_t = decltype(gio::vcf_entry::info)::mapped_type;
+        for (int i = 0; i < rec->n_info; ++i) {
+            const bcf_info_t& info = rec->d.info[i];
+            const char* tag = bcf_hdr_int2id(hdr_, BCF_DT_ID, info.key);
+            if (info_fields_ && !info_fields_->count(tag)) continue;
+            switch (bcf_hdr_id2type(hdr_, BCF_HL_INFO, info.key)) {
+                case BCF_HT_FLAG: e.info.emplace(tag, value_t(true)); break;
+                case BCF_HT_INT: {
+                    const int n = bcf_get_info_int32(hdr_, rec, tag, &ints_, &n_ints_);
+                    if (n > 0) e.info.emplace(tag, vcf_ints<value_t>(ints_, n));
+                    break;
+                }
+                case BCF_HT_REAL: {
+                    const int n = bcf_get_info_float(hdr_, rec, tag, &floats_, &n_floats_);
+                    if (n > 0) e.info.emplace(tag, vcf_floats<value_t>(floats_, n));
+                    break;
+                }
+                default: {
+                    const int n = bcf_get_info_string(hdr_, rec, tag, &chars_, &n_chars_);
+                    if (n > 0) e.info.emplace(tag, value_t(std::string(chars_, std::strlen(chars_))));
+                }
+            }
+        }
+    }
+
+    void decode_samples(bcf1_t* rec, gio::vcf_entry& e) {
+        using value_t = decltype(gio::sample_genotype::fields)::mapped_type;
+        e.samples.resize(order_.size());
+        for (int i = 0; i < rec->n_fmt; ++i) {
+            const int id = rec->d.fmt[i].id;
+            const char* tag = bcf_hdr_int2id(hdr_, BCF_DT_ID, id);
+            const std::string_view name(tag);
+            // GT is decoded into gt_alleles / phased regardless, so it stays in
+            // the FORMAT column list whenever it was present.
+            if (name != "GT" && format_fields_ && !format_fields_->count(tag)) continue;
+            e.format.emplace_back(tag);
+            if (name == "GT") {
+                decode_gt(rec, e);
+                continue;
+            }
+            const int type = bcf_hdr_id2type(hdr_, BCF_HL_FMT, id);
+            const int samples = bcf_hdr_nsamples(hdr_);
+            if (type == BCF_HT_INT || type == BCF_HT_REAL) {
+                const int n = type == BCF_HT_INT
+                                  ? bcf_get_format_int32(hdr_, rec, tag, &ints_, &n_ints_)
+                                  : bcf_get_format_float(hdr_, rec, tag, &floats_, &n_floats_);
+                if (n <= 0) continue;
+                const int per = n / samples;
+                for (std::size_t j = 0; j < order_.size(); ++j) {
+                    const std::size_t at = static_cast<std::size_t>(order_[j]) * per;
+                    value_t v = type == BCF_HT_INT ? vcf_ints<value_t>(ints_ + at, per)
+                                                   : vcf_floats<value_t>(floats_ + at, per);
+                    // A sample whose values are all missing ('.') gets no entry.
+                    if (!std::visit([](const auto& x) { return empty_value(x); }, v)) {
+                        e.samples[j].fields.emplace(tag, std::move(v));
+                    }
+                }
+            } else if (bcf_get_format_string(hdr_, rec, tag, &strings_, &n_string_bytes_) > 0) {
+                for (std::size_t j = 0; j < order_.size(); ++j) {
+                    const std::string value = strings_[order_[j]];
+                    if (!value.empty() && value != ".") e.samples[j].fields.emplace(tag, value_t(value));
+                }
+            }
+        }
+    }
+
+    void decode_gt(bcf1_t* rec, gio::vcf_entry& e) {
+        const int ploidy = genotypes(rec);
+        for (std::size_t j = 0; j < order_.size(); ++j) {
+            auto& s = e.samples[j];
+            using allele_t = decltype(gio::sample_genotype::gt_alleles)::value_type;
+            s.has_gt = ploidy > 0;
+            const int32_t* a = ints_ + static_cast<std::size_t>(order_[j]) * ploidy;
+            for (int k = 0; k < ploidy && a[k] != bcf_int32_vector_end; ++k) {
+                s.gt_alleles.push_back(bcf_gt_is_missing(a[k])
+                                           ? allele_t(-1)
+                                           : static_cast<allele_t>(bcf_gt_allele(a[k])));
+                if (k > 0 && bcf_gt_is_phased(a[k])) s.phased = true;
+            }
+        }
+    }
+
+    template <typename T>
+    static bool empty_value(const T& x) {
+        if constexpr (std::is_same_v<T, bool>) {
+            return false;
+        } else {
+            return x.empty();
+        }
+    }
+
+    std::string header_text() const {
+        kstring_t s = {0, 0, nullptr};
+        bcf_hdr_format(hdr_, 0, &s);
+        std::string out = s.s ? std::string(s.s, s.l) : std::string();
+        std::free(s.s);
+        return out;
+    }
+
+    std::unique_ptr<bcf_srs_t, decltype(&bcf_sr_destroy)> sr_;
+    bcf_hdr_t* hdr_ = nullptr;  // owned by sr_
+    gio::vcf_reader_options opts_;
+    tag_set info_fields_;
+    tag_set format_fields_;
+    std::vector<int> order_;  // requested sample -> column in the narrowed header
+    std::string header_;
+    std::string error_;
+    std::size_t line_ = 0;
+    // htslib's reusable decode buffers.
+    int32_t* ints_ = nullptr;
+    int n_ints_ = 0;
+    float* floats_ = nullptr;
+    int n_floats_ = 0;
+    char* chars_ = nullptr;
+    int n_chars_ = 0;
+    char** strings_ = nullptr;
+    int n_string_bytes_ = 0;
+};
+
+}  // namespace pygg
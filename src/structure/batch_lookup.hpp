@@ -0,0 +1,249 @@
+/*
+ * Batch point lookups for the point-key groves — contains_many / lookup_many on
+ * KmerGrove and NumericGrove and their GroveView counterparts. One NumPy array
+ * of raw values (2-bit k-mer encodings, or ints) is answered in a single call
+ * instead of one intersect() round trip through Python per value.
+ *
+ * The batch is resolved in key order: input positions are sorted by value and
+ * a cursor — the first stored key at or after the current value, found with a
+ * flanking() successor query — advances across the distinct values. A value
+ * below the cursor is absent and one equal to it is a hit, both without a
+ * descent, so the tree is descended only when the batch passes the cursor: at
+ * most once per distinct value, and never for the duplicates typical of k-mer
+ * streams or for values that fall before the next stored key. Each hit is
+ * scattered back to every input position carrying its value; the descents run
+ * in key order, so on a view each block is paged in once and in file order.
+ *
+ * bind_batch_lookup registers the two methods on either class; the grove
+ * releases the GIL for the whole batch, a view keeps it (a query mutates its
+ * block cache, and views are not thread-safe).
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <genogrove/data_type/kmer.hpp>
+#include <genogrove/data_type/numeric.hpp>
+
+#include "../data_type/key_list.hpp"
+#include "../data_type/packed_sequence.hpp"
+#include "../data_type/payload_columns.hpp"
+
+namespace py = pybind11;
+namespace gdt = genogrove::data_type;
+
+namespace pygg {
+
+// Key types with point (exact-equality) overlap and a raw integer form.
+template <typename KeyT>
+inline constexpr bool batch_lookup_key =
+    std::is_same_v<KeyT, gdt::kmer> || std::is_same_v<KeyT, gdt::numeric>;
+
+// The raw value a batch carries for KeyT: a 2-bit encoding or an integer.
+template <typename KeyT>
+using batch_value_t =
+    std::conditional_t<std::is_same_v<KeyT, gdt::kmer>, uint64_t, int64_t>;
+
+template <typename KeyPtr>
+struct batch_hits {
+    std::vector<int64_t> slot;  // per input position: index into keys, or -1
+    std::vector<KeyPtr> keys;   // distinct hits, in key order
+};
+
+// lower_bound(value) -> the first key whose value is >= value, or nullptr;
+// value_of(key) -> that key's raw value. lower_bound is called in ascending
+// value order, and only when the batch moves past the current cursor.
+template <typename V, typename LowerBound, typename ValueOf>
+auto sorted_batch_lookup(const V* values, std::size_t n, LowerBound&& lower_bound,
+                         ValueOf&& value_of) {
+    using ptr_t = decltype(lower_bound(std::declval<V>()));
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(), [values](std::size_t a, std::size_t b) {
+        return values[a] < values[b];
+    });
+
+    batch_hits<ptr_t> out;
+    out.slot.assign(n, -1);
+    ptr_t cursor = nullptr;
+    bool started = false;  // cursor is lower_bound of some earlier value
+    for (std::size_t i = 0; i < n;) {
+        const V v = values[order[i]];
+        std::size_t j = i + 1;
+        while (j < n && values[order[j]] == v) ++j;
+        if (!started || (cursor && value_of(cursor) < v)) {
+            cursor = lower_bound(v);
+            started = true;
+        }
+        if (!cursor) break;  // no stored key at or after v: the rest miss
+        if (value_of(cursor) == v) {
+            const auto s = static_cast<int64_t>(out.keys.size());
+            out.keys.push_back(cursor);
+            for (std::size_t t = i; t < j; ++t) out.slot[order[t]] = s;
+        }
+        i = j;
+    }
+    return out;
+}
+
+inline gdt::kmer make_batch_key(uint64_t enc, unsigned k) {
+    if (k < 32 && (enc >> (2 * k)) != 0) {
+        throw std::invalid_argument("encoding " + std::to_string(enc) +
+                                    " does not fit k=" + std::to_string(k));
+    }
+    return gdt::kmer(enc, static_cast<uint8_t>(k));
+}
+
+inline gdt::numeric make_batch_key(int64_t value, unsigned) {
+    if (value < INT_MIN || value > INT_MAX) {
+        throw std::invalid_argument("value " + std::to_string(value) +
+                                    " is out of range for Numeric");
+    }
+    return gdt::numeric(static_cast<int>(value));
+}
+
+inline uint64_t batch_raw_value(const gdt::kmer& km) { return km.get_encoding(); }
+inline int64_t batch_raw_value(const gdt::numeric& num) { return num.get_value(); }
+
+// Owner is a grove or a grove_view: anything with intersect / flanking.
+template <typename KeyT, typename Owner>
+auto batch_lookup(Owner& owner, const batch_value_t<KeyT>* values, std::size_t n,
+                  std::string_view index, unsigned k, bool release_gil) {
+    using value_t = batch_value_t<KeyT>;
+    columns_scope scope(&owner);
+    std::optional<py::gil_scoped_release> release;
+    if (release_gil) release.emplace();
+    using ptr_t = std::decay_t<
+        decltype(owner.intersect(std::declval<KeyT>(), index).get_keys().front())>;
+    if (n == 0) return batch_hits<ptr_t>{};
+    // Values the cursor skips are never turned into keys; check the extremes so
+    // an out-of-range value still raises.
+    const auto [lo, hi] = std::minmax_element(values, values + n);
+    make_batch_key(*lo, k);
+    make_batch_key(*hi, k);
+    const std::string name(index);
+    // Point keys overlap only their own value, so the flanking() successor of
+    // v - 1 is the first key at or after v; the smallest value needs a point
+    // query of its own.
+    auto lower_bound = [&](value_t v) -> ptr_t {
+        const value_t lowest = std::is_same_v<KeyT, gdt::kmer> ? value_t(0) : value_t(INT_MIN);
+        if (v > lowest) return owner.flanking(make_batch_key(v - 1, k), name).get_successor();
+        const auto key = make_batch_key(v, k);
+        auto result = owner.intersect(key, index);
+        auto&& keys = result.get_keys();
+        return keys.empty() ? owner.flanking(key, name).get_successor() : keys.front();
+    };
+    return sorted_batch_lookup(values, n, lower_bound, [](const auto* key) {
+        return static_cast<value_t>(batch_raw_value(key->get_value()));
+    });
+}
+
+template <typename KeyT, typename Owner, typename Class>
+void bind_batch_lookup(Class& cls, bool release_gil) {
+    using value_t = batch_value_t<KeyT>;
+    using array_t = py::array_t<value_t, py::array::c_style | py::array::forcecast>;
+    constexpr bool is_kmer = std::is_same_v<KeyT, gdt::kmer>;
+
+    auto contains = [release_gil](Owner& owner, const array_t& values,
+                                  std::string_view index, unsigned k) {
+        const auto n = static_cast<std::size_t>(values.size());
+        auto hits = batch_lookup<KeyT>(owner, values.data(), n, index, k, release_gil);
+        py::array_t<bool> out(static_cast<py::ssize_t>(n));
+        bool* o = out.mutable_data();
+        for (std::size_t i = 0; i < n; ++i) o[i] = hits.slot[i] >= 0;
+        return out;
+    };
+    auto lookup = [release_gil](py::object self, const array_t& values,
+                                std::string_view index, unsigned k) {
+        const auto n = static_cast<std::size_t>(values.size());
+        auto hits = batch_lookup<KeyT>(self.cast<Owner&>(), values.data(), n, index, k,
+                                       release_gil);
+        py::array_t<int64_t> slot(static_cast<py::ssize_t>(n));
+        std::copy(hits.slot.begin(), hits.slot.end(), slot.mutable_data());
+        return py::make_tuple(slot, pinned_key_list(hits.keys, self));
+    };
+
+    if constexpr (is_kmer) {
+        cls.def(
+            "contains_many",
+            [contains](Owner& owner, const array_t& encodings, std::string_view index,
+                       unsigned k) {
+                check_kmer_k(k);
+                return contains(owner, encodings, index, k);
+            },
+            py::arg("encodings"), py::arg("index"), py::arg("k"),
+            R"pbdoc(
+                contains_many(encodings, index, k) -> numpy.ndarray[bool]
+
+                Batch membership: out[i] is True when the k-mer with 2-bit
+                encoding encodings[i] (as Kmer.encoding / PackedSequence.kmers,
+                A=0 C=1 G=2 T=3, first base most significant) is stored in
+                `index`. The batch is resolved in sorted order by one cursor
+                that descends the tree only to move past a stored k-mer —
+                repeats, and encodings before the next stored one, cost none. Raises
+                ValueError for an encoding wider than k.
+            )pbdoc");
+        cls.def(
+            "lookup_many",
+            [lookup](py::object self, const array_t& encodings, std::string_view index,
+                     unsigned k) {
+                check_kmer_k(k);
+                return lookup(std::move(self), encodings, index, k);
+            },
+            py::arg("encodings"), py::arg("index"), py::arg("k"),
+            R"pbdoc(
+                lookup_many(encodings, index, k) -> tuple[numpy.ndarray, list[Key]]
+
+                Batch lookup: returns (slots, keys), where keys are the distinct
+                matching Keys in k-mer order and slots[i] (int64) is the position
+                of encodings[i]'s Key in that list, or -1 when absent — so
+                keys[slots[i]].data is its payload.
+            )pbdoc");
+    } else {
+        cls.def(
+            "contains_many",
+            [contains](Owner& owner, const array_t& values, std::string_view index) {
+                return contains(owner, values, index, 0);
+            },
+            py::arg("values"), py::arg("index"),
+            R"pbdoc(
+                contains_many(values, index) -> numpy.ndarray[bool]
+
+                Batch membership: out[i] is True when Numeric(values[i]) is
+                stored in `index`. The batch is resolved in sorted order by one
+                cursor that descends the tree only to move past a stored value —
+                repeats, and values before the next stored one, cost none. Raises
+                ValueError for a value outside the 32-bit Numeric range.
+            )pbdoc");
+        cls.def(
+            "lookup_many",
+            [lookup](py::object self, const array_t& values, std::string_view index) {
+                return lookup(std::move(self), values, index, 0);
+            },
+            py::arg("values"), py::arg("index"),
+            R"pbdoc(
+                lookup_many(values, index) -> tuple[numpy.ndarray, list[Key]]
+
+                Batch lookup: returns (slots, keys), where keys are the distinct
+                matching Keys in value order and slots[i] (int64) is the position
+                of values[i]'s Key in that list, or -1 when absent — so
+                keys[slots[i]].data is its payload.
+            )pbdoc");
+    }
+}
+
+}  // namespace pygg
@@ -0,0 +1,260 @@
+/*
+ * add_edges — bulk graph-overlay linking. Sources and targets arrive as
+ * parallel sequences, either of Keys or of integer positions into a `keys` list
+ * (e.g. the one insert_bulk returned, given as a NumPy integer array), and every
+ * edge is added in one C++ loop with the GIL released.
+ *
+ * On the groves with JSON edge metadata, `data` is either one value per edge
+ * (each JSON-encoded once, up front) or a columnar dict {name: column}, where
+ * each column is a NumPy numeric / bool array or a list; edge i then carries
+ * {name: column[i], …}. Numeric and str columns are formatted in C++, so the
+ * columnar form never builds a Python object per edge.
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../data_type/json_value.hpp"
+#include "../data_type/payload_columns.hpp"
+#include "frozen_graph.hpp"
+
+namespace py = pybind11;
+
+namespace pygg {
+
+// Key pointers for a sequence of Keys, or for integer positions into `keys`.
+template <typename key_t>
+std::vector<key_t*> resolve_keys(py::handle seq, const std::vector<key_t*>* keys,
+                                 const char* what) {
+    std::vector<key_t*> out;
+    auto by_position = [&](int64_t i) {
+        if (!keys) {
+            throw std::invalid_argument(std::string(what) +
+                                        ": integer ids need the `keys` list they index");
+        }
+        if (i < 0 || static_cast<std::size_t>(i) >= keys->size()) {
+            throw std::out_of_range(std::string(what) + ": key id " + std::to_string(i) +
+                                    " is out of range");
+        }
+        key_t* key = (*keys)[static_cast<std::size_t>(i)];
+        if (!key) throw py::type_error("keys must not contain None");
+        return key;
+    };
+    if (py::isinstance<py::array>(seq)) {
+        const auto kind = py::reinterpret_borrow<py::array>(seq).dtype().kind();
+        if (kind == 'i' || kind == 'u') {
+            auto ids = py::array_t<int64_t, py::array::c_style | py::array::forcecast>::ensure(seq);
+            if (!ids || ids.ndim() != 1) {
+                throw std::invalid_argument(std::string(what) + " must be 1-D");
+            }
+            out.reserve(static_cast<std::size_t>(ids.size()));
+            for (py::ssize_t i = 0; i < ids.size(); ++i) out.push_back(by_position(ids.data()[i]));
+            return out;
+        }
+    }
+    for (py::handle item : seq) {
+        if (item.is_none()) throw py::type_error(std::string(what) + " must not contain None");
+        if (py::isinstance<py::int_>(item)) {
+            out.push_back(by_position(item.cast<int64_t>()));
+        } else {
+            out.push_back(item.cast<key_t*>());
+        }
+    }
+    return out;
+}
+
+inline void append_json_number(std::string& out, double v) {
+    if (std::isnan(v)) {
+        out += "NaN";
+    } else if (std::isinf(v)) {
+        out += v > 0 ? "Infinity" : "-Infinity";  // as json.dumps writes them
+    } else {
+        char buf[32];
+        auto end = std::to_chars(buf, buf + sizeof buf, v).ptr;
+        std::string_view text(buf, static_cast<std::size_t>(end - buf));
+        out += text;
+        // Keep floats floats on the way back through json.loads.
+        if (text.find_first_of(".eE") == std::string_view::npos) out += ".0";
+    }
+}
+
+// One JSON fragment per row of a column: a NumPy numeric / bool array, or a list
+// (str items quoted directly, anything else through json.dumps).
+inline std::vector<std::string> json_column(py::handle column, std::size_t n,
+                                            const std::string& name) {
+    std::vector<std::string> out;
+    out.reserve(n);
+    auto check = [&](std::size_t len) {
+        if (len != n) {
+            throw std::invalid_argument("edge metadata column '" + name + "' has " +
+                                        std::to_string(len) + " rows, expected " +
+                                        std::to_string(n));
+        }
+    };
+    if (py::isinstance<py::array>(column)) {
+        auto arr = py::reinterpret_borrow<py::array>(column);
+        const char kind = arr.dtype().kind();
+        if (kind == 'b') {
+            auto a = py::array_t<bool, py::array::c_style | py::array::forcecast>::ensure(arr);
+            check(static_cast<std::size_t>(a.size()));
+            for (py::ssize_t i = 0; i < a.size(); ++i) out.emplace_back(a.data()[i] ? "true" : "false");
+            return out;
+        }
+        if (kind == 'i' || kind == 'u') {
+            auto a = py::array_t<int64_t, py::array::c_style | py::array::forcecast>::ensure(arr);
+            check(static_cast<std::size_t>(a.size()));
+            for (py::ssize_t i = 0; i < a.size(); ++i) out.push_back(std::to_string(a.data()[i]));
+            return out;
+        }
+        if (kind == 'f') {
+            auto a = py::array_t<double, py::array::c_style | py::array::forcecast>::ensure(arr);
+            check(static_cast<std::size_t>(a.size()));
+            for (py::ssize_t i = 0; i < a.size(); ++i) {
+                out.emplace_back();
+                append_json_number(out.back(), a.data()[i]);
+            }
+            return out;
+        }
+    }
+    check(static_cast<std::size_t>(py::len(column)));
+    for (py::handle item : column) {
+        if (py::isinstance<py::str>(item)) {
+            out.push_back(json_quote(item.cast<std::string>()).json);
+        } else {
+            out.push_back(item.cast<json_value>().json);
+        }
+    }
+    return out;
+}
+
+// Per-edge metadata for `data`: a per-edge sequence, or a dict of columns.
+// Columns are formatted up front; row(i) assembles edge i's JSON object.
+struct edge_metadata {
+    std::vector<json_value> rows;                         // per-edge form
+    std::vector<std::string> names;                       // columnar form: quoted names
+    std::vector<std::vector<std::string>> columns;
+
+    static edge_metadata from(py::handle data, std::size_t n) {
+        edge_metadata md;
+        if (data.is_none()) return md;
+        if (py::isinstance<py::dict>(data)) {
+            for (auto [name, column] : py::reinterpret_borrow<py::dict>(data)) {
+                const auto key = name.cast<std::string>();
+                md.names.push_back(json_quote(key).json);
+                md.columns.push_back(json_column(column, n, key));
+            }
+            return md;
+        }
+        if (static_cast<std::size_t>(py::len(data)) != n) {
+            throw std::invalid_argument("data must have one entry per edge");
+        }
+        md.rows.reserve(n);
+        for (py::handle item : data) md.rows.push_back(item.cast<json_value>());
+        return md;
+    }
+
+    bool empty() const { return rows.empty() && names.empty(); }
+
+    json_value row(std::size_t i) {
+        if (!rows.empty()) return std::move(rows[i]);
+        json_value v;
+        v.json = "{";
+        for (std::size_t c = 0; c < names.size(); ++c) {
+            if (c) v.json += ", ";
+            v.json += names[c];
+            v.json += ": ";
+            v.json += columns[c][i];
+        }
+        v.json += '}';
+        return v;
+    }
+};
+
+}  // namespace pygg
+
+template <typename grove_t, typename key_t, typename EdgeT, typename Class>
+void bind_bulk_edges(Class& cls) {
+    using keys_arg = std::optional<std::vector<key_t*>>;
+    auto endpoints = [](py::handle sources, py::handle targets, const keys_arg& keys) {
+        const auto* pool = keys ? &*keys : nullptr;
+        auto src = pygg::resolve_keys<key_t>(sources, pool, "sources");
+        auto tgt = pygg::resolve_keys<key_t>(targets, pool, "targets");
+        if (src.size() != tgt.size()) {
+            throw std::invalid_argument("sources and targets differ in length");
+        }
+        return std::make_pair(std::move(src), std::move(tgt));
+    };
+
+    if constexpr (std::is_same_v<EdgeT, pygg::json_value>) {
+        cls.def(
+            "add_edges",
+            [endpoints](grove_t& g, py::handle sources, py::handle targets,
+                        py::handle data, const keys_arg& keys) {
+                auto [src, tgt] = endpoints(sources, targets, keys);
+                pygg::thaw_graph(&g);
+                const std::size_t n = src.size();
+                auto md = pygg::edge_metadata::from(data, n);
+                py::gil_scoped_release release;
+                if (md.empty()) {
+                    for (std::size_t i = 0; i < n; ++i) g.add_edge(src[i], tgt[i]);
+                    return n;
+                }
+                const auto cols = pygg::grove_columns(&g);
+                for (std::size_t i = 0; i < n; ++i) {
+                    auto row = md.row(i);
+                    if (cols) pygg::encode_columns(*cols, row);
+                    g.add_edge(src[i], tgt[i], std::move(row));
+                }
+                return n;
+            },
+            py::arg("sources"), py::arg("targets"), py::arg("data") = py::none(),
+            py::arg("keys") = py::none(),
+            R"pbdoc(
+                add_edges(sources, targets, data=None, keys=None) -> int
+
+                Add the directed edges sources[i] -> targets[i] in one call, with
+                the GIL released for the linking loop. sources / targets are
+                parallel sequences of Keys, or of integer positions into `keys`
+                (a list of Keys such as insert_bulk's result; NumPy integer
+                arrays are read directly). `data` is None, one metadata value per
+                edge, or a columnar dict {name: column} — NumPy numeric / bool
+                arrays or lists — giving edge i the metadata
+                {name: column[i], …}. Returns the number of edges added.
+            )pbdoc");
+    } else {
+        cls.def(
+            "add_edges",
+            [endpoints](grove_t& g, py::handle sources, py::handle targets,
+                        const keys_arg& keys) {
+                auto [src, tgt] = endpoints(sources, targets, keys);
+                pygg::thaw_graph(&g);
+                py::gil_scoped_release release;
+                for (std::size_t i = 0; i < src.size(); ++i) g.add_edge(src[i], tgt[i]);
+                return src.size();
+            },
+            py::arg("sources"), py::arg("targets"), py::arg("keys") = py::none(),
+            R"pbdoc(
+                add_edges(sources, targets, keys=None) -> int
+
+                Add the directed edges sources[i] -> targets[i] in one call, with
+                the GIL released for the linking loop. sources / targets are
+                parallel sequences of Keys, or of integer positions into `keys`
+                (a list of Keys such as insert_bulk's result; NumPy integer
+                arrays are read directly). Returns the number of edges added.
+            )pbdoc");
+    }
+}
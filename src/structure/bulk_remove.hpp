@@ -0,0 +1,132 @@
+/*
+ * Batch key removal — remove_keys(index, keys) and remove_range(index, query)
+ * on every grove, optionally compacting afterwards.
+ *
+ * remove_key() cleans each key's incident edges itself, and finding the incoming
+ * ones means a scan of the whole overlay per key. The batch forms clear the
+ * edges of every doomed key first, in one remove_edges_if sweep (plus each
+ * key's own out-list), so the per-key removals that follow find no edges left.
+ * The whole batch runs with the GIL released; the KeyHandles of removed keys are
+ * cleared, and the graph snapshot thawed, as for remove_key().
+ *
+ * The tree side is not batched: each key is a genogrove remove_key() with its
+ * own leaf rebalance, so a batch of k costs O(k log n) on top of the O(E) edge
+ * sweep. Deleting from the leaves directly and repairing once bottom-up would
+ * have to redo what remove_key() keeps private — retiring the key's storage
+ * slot and the grove's counts, and recomputing the internal keys, whose rule
+ * genogrove does not expose (index_walk.hpp reads only leaf order). Rebuilding
+ * the survivors with a sorted bulk insert would be O(n), but it moves every
+ * surviving key, which would orphan their edges and every Key Python holds;
+ * dropping and re-inserting an index is the caller's call.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "frozen_graph.hpp"
+#include "key_handles.hpp"
+
+namespace py = pybind11;
+
+namespace pygg {
+
+// Remove `keys` (deduplicated; those not live in `index` are skipped) from
+// `index`, their edges first in one sweep. Returns the keys removed.
+template <typename grove_t, typename key_t>
+std::vector<key_t*> remove_keys_batch(grove_t& g, const std::string& index,
+                                      std::vector<key_t*> keys, bool check_membership) {
+    keys.erase(std::remove(keys.begin(), keys.end(), nullptr), keys.end());
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    if (check_membership) {
+        // A key belongs to the index iff a query for its own value finds it;
+        // removed (dead) slots and other indices' keys are dropped.
+        keys.erase(std::remove_if(keys.begin(), keys.end(),
+                                  [&](key_t* k) {
+                                      auto hits = g.intersect(k->get_value(), index);
+                                      const auto& found = hits.get_keys();
+                                      return std::find(found.begin(), found.end(), k) ==
+                                             found.end();
+                                  }),
+                   keys.end());
+    }
+    if (keys.empty()) return keys;
+    const std::unordered_set<const key_t*> doomed(keys.begin(), keys.end());
+    g.remove_edges_if([&doomed](const auto& e) { return doomed.count(e.target) != 0; });
+    for (key_t* k : keys) g.remove_edges_from(k);
+    std::vector<key_t*> removed;
+    removed.reserve(keys.size());
+    for (key_t* k : keys) {
+        if (g.remove_key(index, k)) removed.push_back(k);
+    }
+    return removed;
+}
+
+}  // namespace pygg
+
+template <typename grove_t, typename key_t, typename KeyT, typename Class>
+void bind_bulk_remove(Class& cls) {
+    // Bookkeeping shared with remove_key(), then the optional compaction.
+    auto finish = [](grove_t& g, const std::vector<key_t*>& removed, bool compact) {
+        for (key_t* k : removed) pygg::forget_key_handles(&g, k);
+        if (compact) pygg::compact_with_handles<key_t>(g);
+        return removed.size();
+    };
+    cls.def(
+        "remove_keys",
+        [finish](grove_t& g, const std::string& index, std::vector<key_t*> keys, bool compact) {
+            pygg::thaw_graph(&g);
+            std::vector<key_t*> removed;
+            {
+                py::gil_scoped_release release;
+                removed = pygg::remove_keys_batch(g, index, std::move(keys), true);
+            }
+            return finish(g, removed, compact);
+        },
+        py::arg("index"), py::arg("keys"), py::arg("compact") = false,
+        R"pbdoc(
+            remove_keys(index, keys, compact=False) -> int
+
+            Remove every Key in `keys` from `index` in one batch with the GIL
+            released, clearing all their incident edges in a single sweep of
+            the overlay first. None entries, duplicates and keys not live in
+            `index` are skipped. compact=True runs compact() afterwards (live
+            KeyHandles follow their keys; plain Keys are invalidated, see
+            compact()). Returns the number of keys removed.
+
+            The edges go in one O(E) pass, but each key still leaves the tree
+            through its own remove_key() and rebalance, O(k log n) for k keys —
+            not O(n). To drop most of an index, rebuilding it with
+            insert_bulk(presorted=True) from the keys to keep is faster.
+        )pbdoc");
+    cls.def(
+        "remove_range",
+        [finish](grove_t& g, const std::string& index, const KeyT& query, bool compact) {
+            pygg::thaw_graph(&g);
+            std::vector<key_t*> removed;
+            {
+                py::gil_scoped_release release;
+                auto hits = g.intersect(query, std::string_view(index));
+                std::vector<key_t*> keys(hits.get_keys().begin(), hits.get_keys().end());
+                removed = pygg::remove_keys_batch(g, index, std::move(keys), false);
+            }
+            return finish(g, removed, compact);
+        },
+        py::arg("index"), py::arg("query"), py::arg("compact") = false,
+        R"pbdoc(
+            remove_range(index, query, compact=False) -> int
+
+            Remove every key of `index` that intersect(query, index) returns —
+            e.g. all intervals overlapping a region — as one remove_keys()
+            batch, at the same O(k log n) per-key tree cost. Returns the number
+            of keys removed.
+        )pbdoc");
+}
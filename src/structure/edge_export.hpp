@@ -0,0 +1,86 @@
+/*
+ * Edge export for graph libraries — edges_to_numpy / to_csr_matrix on every
+ * grove and grove view. Both read a CSR graph (frozen_graph.hpp): one built for
+ * the call over the given keys and their reachable closure — on a view, that
+ * build pages the closure's blocks in once, as it reaches them — or without
+ * keys, the freeze_graph() snapshot, else every index (a grove walks its leaf
+ * chains, a view reads each index block by block). Vertex ids index the
+ * returned Key list, so the arrays feed networkx / igraph / scipy directly,
+ * with no per-edge Python.
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "../data_type/key_list.hpp"
+#include "frozen_graph.hpp"
+
+namespace py = pybind11;
+
+template <typename Owner, typename key_t, typename EdgeT, typename Class>
+void bind_edge_export(Class& cls, bool release_gil) {
+    using keys_arg = std::optional<std::vector<key_t*>>;
+    cls.def(
+        "edges_to_numpy",
+        [release_gil](py::object self, const keys_arg& keys) {
+            auto g = pygg::csr_for<Owner, key_t, EdgeT>(self.cast<Owner&>(), keys, release_gil);
+            const auto m = static_cast<py::ssize_t>(g->targets.size());
+            py::array_t<int64_t> sources(m), targets(m);
+            {
+                int64_t* src = sources.mutable_data();
+                int64_t* tgt = targets.mutable_data();
+                py::gil_scoped_release release;
+                for (std::size_t v = 0; v + 1 < g->offsets.size(); ++v) {
+                    std::fill(src + g->offsets[v], src + g->offsets[v + 1], static_cast<int64_t>(v));
+                }
+                std::copy(g->targets.begin(), g->targets.end(), tgt);
+            }
+            return py::make_tuple(sources, targets, pinned_key_list(g->vertices, self));
+        },
+        py::arg("keys") = py::none(),
+        R"pbdoc(
+            edges_to_numpy(keys=None) -> tuple[numpy.ndarray, numpy.ndarray, list[Key]]
+
+            The overlay over `keys` and every Key reachable from them as an edge
+            list: int64 arrays (source_ids, target_ids), one entry per edge,
+            grouped by source, plus the Keys the ids index (`keys` first, then
+            the rest in BFS order). keys=None exports the freeze_graph()
+            snapshot, or when nothing is frozen every index (sorted by name) in
+            index order; a KmerGroveView cannot enumerate an index and needs
+            `keys` or a snapshot. E.g. networkx.DiGraph(zip(source_ids, target_ids)).
+        )pbdoc");
+    cls.def(
+        "to_csr_matrix",
+        [release_gil](py::object self, const keys_arg& keys) {
+            auto g = pygg::csr_for<Owner, key_t, EdgeT>(self.cast<Owner&>(), keys, release_gil);
+            auto sparse = py::module_::import("scipy.sparse");
+            const auto n = static_cast<py::ssize_t>(g->vertices.size());
+            const auto m = static_cast<py::ssize_t>(g->targets.size());
+            py::array_t<int64_t> indptr(n + 1);
+            py::array_t<int32_t> indices(m);
+            py::array_t<double> data(m);
+            std::copy(g->offsets.begin(), g->offsets.end(), indptr.mutable_data());
+            std::copy(g->targets.begin(), g->targets.end(), indices.mutable_data());
+            std::fill(data.mutable_data(), data.mutable_data() + m, 1.0);
+            py::object matrix = sparse.attr("csr_matrix")(py::make_tuple(data, indices, indptr),
+                                                          py::arg("shape") = py::make_tuple(n, n));
+            return py::make_tuple(matrix, pinned_key_list(g->vertices, self));
+        },
+        py::arg("keys") = py::none(),
+        R"pbdoc(
+            to_csr_matrix(keys=None) -> tuple[scipy.sparse.csr_matrix, list[Key]]
+
+            The overlay (as in edges_to_numpy) as an n x n scipy.sparse adjacency
+            matrix built straight from the CSR arrays: entry (i, j) is the number
+            of edges keys[i] -> keys[j]. Returns the matrix and the Keys its rows
+            and columns index. Requires scipy.
+        )pbdoc");
+}
@@ -0,0 +1,385 @@
+/*
+ * freeze_graph — a compressed-sparse-row snapshot of the graph overlay for
+ * read-mostly, traversal-heavy graphs. genogrove keeps adjacency per source key,
+ * tuned for mutation; a frozen snapshot numbers the vertices (the given keys,
+ * then everything reachable from them, in BFS order) and stores every vertex's
+ * out-edges as one contiguous run of a shared target-index array, with the edge
+ * metadata in a parallel array. get_neighbors and the traversals
+ * (graph_traversal.hpp) then read the runs instead of the per-key lists.
+ *
+ * The snapshot lives beside the grove object (address-keyed, like the interned
+ * payload fields, and dropped when the Python object is collected). Every graph
+ * mutation of a grove thaws it; a view is immutable, so its snapshot — built by
+ * paging the closure in once — holds for the view's lifetime. serialize() writes
+ * a frozen grove's snapshot to "<path>.csr"; deserialize() loads it back frozen,
+ * and GroveView.open(path, frozen=True) defers reading it to the view's first
+ * graph access, so opening a view still reads only the block directory.
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <genogrove/data_type/serialization_traits.hpp>
+
+#include "../data_type/key_list.hpp"
+#include "../data_type/payload_columns.hpp"
+#include "../data_type/side_table.hpp"
+#include "index_keys.hpp"
+
+namespace py = pybind11;
+
+namespace pygg {
+
+template <typename key_t, typename EdgeT>
+struct csr_graph {
+    struct no_metadata {};
+    using metadata_t = std::conditional_t<std::is_void_v<EdgeT>, no_metadata, EdgeT>;
+
+    std::vector<key_t*> vertices;                          // vertex id -> key
+    std::unordered_map<const key_t*, uint32_t> index;      // key -> vertex id
+    std::vector<uint64_t> offsets{0};                      // vertex i's edges: [offsets[i], offsets[i+1])
+    std::vector<uint32_t> targets;                         // target vertex ids
+    std::vector<metadata_t> metadata;                      // parallel to targets; empty on void edges
+
+    std::optional<uint32_t> find(const key_t* key) const {
+        auto it = index.find(key);
+        if (it == index.end()) return std::nullopt;
+        return it->second;
+    }
+
+    std::vector<key_t*> neighbors(uint32_t v) const {
+        std::vector<key_t*> out;
+        out.reserve(static_cast<std::size_t>(offsets[v + 1] - offsets[v]));
+        for (uint64_t e = offsets[v]; e < offsets[v + 1]; ++e) out.push_back(vertices[targets[e]]);
+        return out;
+    }
+
+    // Snapshot `keys` and every vertex reachable from them.
+    template <typename Owner>
+    static csr_graph build(Owner& owner, const std::vector<key_t*>& keys) {
+        columns_scope scope(&owner);
+        csr_graph g;
+        auto id_of = [&g](key_t* key) {
+            auto [it, fresh] = g.index.emplace(key, static_cast<uint32_t>(g.vertices.size()));
+            if (fresh) {
+                if (g.vertices.size() == std::numeric_limits<uint32_t>::max()) {
+                    throw std::length_error("graph has too many vertices to freeze");
+                }
+                g.vertices.push_back(key);
+            }
+            return it->second;
+        };
+        for (key_t* key : keys) id_of(key);
+        // Vertices appended while scanning are scanned in turn.
+        for (std::size_t v = 0; v < g.vertices.size(); ++v) {
+            key_t* source = g.vertices[v];
+            for (auto* target : owner.get_neighbors(source)) g.targets.push_back(id_of(target));
+            if constexpr (!std::is_void_v<EdgeT>) {
+                for (auto& m : owner.get_edges(source)) g.metadata.push_back(std::move(m));
+            }
+            g.offsets.push_back(g.targets.size());
+        }
+        return g;
+    }
+};
+
+// ---- Snapshots held per grove / view object ----
+
+using frozen_graph_table = object_side_table<const void, struct frozen_graph_tag>;
+
+// A "<path>.csr" a view was opened with, read on first use: resolving its
+// vertices reads every index they lie in.
+struct deferred_csr {
+    std::string path;
+    std::shared_ptr<const void> graph;  // the snapshot, once read
+};
+
+using deferred_csr_table = object_side_table<deferred_csr, struct deferred_csr_tag>;
+
+template <typename key_t, typename EdgeT, typename Owner>
+std::shared_ptr<const csr_graph<key_t, EdgeT>> read_csr(const std::string& gg_path,
+                                                        Owner& owner);
+
+// owner's snapshot: one freeze_graph() built, or the deferred one, read now.
+template <typename key_t, typename EdgeT, typename Owner>
+std::shared_ptr<const csr_graph<key_t, EdgeT>> frozen_graph(Owner* owner) {
+    using csr_t = csr_graph<key_t, EdgeT>;
+    if (auto csr = frozen_graph_table::instance().find(owner)) {
+        return std::static_pointer_cast<const csr_t>(csr);
+    }
+    auto deferred = deferred_csr_table::instance().find(owner);
+    if (!deferred) return nullptr;
+    if (!deferred->graph) deferred->graph = read_csr<key_t, EdgeT>(deferred->path, *owner);
+    return std::static_pointer_cast<const csr_t>(deferred->graph);
+}
+
+// get_neighbors(key), from owner's snapshot when key is in one.
+template <typename key_t, typename EdgeT, typename Owner>
+std::vector<key_t*> neighbors_of(Owner& owner, key_t* key) {
+    if (auto csr = frozen_graph<key_t, EdgeT>(&owner)) {
+        if (auto v = csr->find(key)) return csr->neighbors(*v);
+    }
+    columns_scope scope(&owner);
+    auto&& targets = owner.get_neighbors(key);
+    return std::vector<key_t*>(targets.begin(), targets.end());
+}
+
+// Called by every graph mutation of a grove, and by thaw_graph() on a view.
+inline void thaw_graph(const void* owner) {
+    frozen_graph_table::instance().reset(owner);
+    deferred_csr_table::instance().reset(owner);
+}
+
+// The CSR graph a whole-graph operation runs on: one built over keys and their
+// closure (with the GIL released when release_gil is set), or when keys is
+// nullopt, owner's freeze_graph() snapshot — failing that, one built over every
+// index, which a view pages in block by block (index_keys.hpp).
+template <typename Owner, typename key_t, typename EdgeT>
+std::shared_ptr<const csr_graph<key_t, EdgeT>> csr_for(
+    Owner& owner, const std::optional<std::vector<key_t*>>& keys, bool release_gil) {
+    using csr_t = csr_graph<key_t, EdgeT>;
+    if (!keys) {
+        if (auto frozen = frozen_graph<key_t, EdgeT>(&owner)) return frozen;
+        if constexpr (!can_enumerate<key_t, Owner>) {
+            throw std::invalid_argument("pass keys, or call freeze_graph() first");
+        } else {
+            return csr_for<Owner, key_t, EdgeT>(owner, index_keys<key_t>(owner, std::nullopt),
+                                                release_gil);
+        }
+    }
+    if (std::find(keys->begin(), keys->end(), nullptr) != keys->end()) {
+        throw py::type_error("keys must not contain None");
+    }
+    std::optional<py::gil_scoped_release> release;
+    if (release_gil) release.emplace();
+    return std::make_shared<const csr_t>(csr_t::build(owner, *keys));
+}
+
+// ---- The "<path>.csr" file written beside a .gg ----
+//
+// A vertex is stored as (index, position in that index's key order), which a
+// grove reads from its leaf chain and a view from one in-order pass per index,
+// instead of paging the closure in edge by edge. Native little-endian:
+//
+//   magic "PGGCSR\0\1" | index count, then per index its name and key count
+//   vertex count | per vertex: uint32 index, uint64 position
+//   offsets[n + 1] uint64 | edge count | targets uint32 | edge metadata
+
+inline constexpr char csr_file_magic[8] = {'P', 'G', 'G', 'C', 'S', 'R', '\0', '\1'};
+
+inline std::string csr_path(const std::string& gg_path) { return gg_path + ".csr"; }
+
+template <typename T>
+void write_pod(std::ostream& os, const T& v) {
+    os.write(reinterpret_cast<const char*>(&v), sizeof v);
+}
+template <typename T>
+T read_pod(std::istream& is) {
+    T v{};
+    if (!is.read(reinterpret_cast<char*>(&v), sizeof v)) {
+        throw std::runtime_error("truncated frozen-graph file");
+    }
+    return v;
+}
+
+template <typename grove_t, typename key_t, typename EdgeT>
+void write_csr(const std::string& path, grove_t& g, const csr_graph<key_t, EdgeT>& csr) {
+    using traits = genogrove::data_type::serialization_traits<std::string>;
+    const auto names = index_names(g);
+    std::vector<std::pair<uint32_t, uint64_t>> at(csr.vertices.size());
+    std::vector<uint64_t> sizes;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        uint64_t pos = 0;
+        for_each_index_key(g, names[i], [&](const key_t* key) {
+            if (auto v = csr.find(key)) at[*v] = {static_cast<uint32_t>(i), pos};
+            ++pos;
+        });
+        sizes.push_back(pos);
+    }
+    std::ofstream os(path, std::ios::binary);
+    if (!os) throw std::runtime_error("Failed to open file for writing: " + path);
+    os.write(csr_file_magic, sizeof csr_file_magic);
+    write_pod<uint64_t>(os, names.size());
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        traits::serialize(os, names[i]);
+        write_pod<uint64_t>(os, sizes[i]);
+    }
+    write_pod<uint64_t>(os, csr.vertices.size());
+    for (const auto& [index, pos] : at) {
+        write_pod(os, index);
+        write_pod(os, pos);
+    }
+    os.write(reinterpret_cast<const char*>(csr.offsets.data()),
+             static_cast<std::streamsize>(csr.offsets.size() * sizeof(uint64_t)));
+    write_pod<uint64_t>(os, csr.targets.size());
+    os.write(reinterpret_cast<const char*>(csr.targets.data()),
+             static_cast<std::streamsize>(csr.targets.size() * sizeof(uint32_t)));
+    if constexpr (!std::is_void_v<EdgeT>) {
+        for (const auto& m : csr.metadata) m.serialize(os);
+    }
+    if (!os) throw std::runtime_error("Failed to write frozen graph to file: " + path);
+}
+
+// The snapshot stored beside `gg_path`, resolved against `owner`, or null when
+// there is none (or owner cannot enumerate its indices, as a KmerGroveView).
+template <typename key_t, typename EdgeT, typename Owner>
+std::shared_ptr<const csr_graph<key_t, EdgeT>> read_csr(const std::string& gg_path,
+                                                        Owner& owner) {
+    using traits = genogrove::data_type::serialization_traits<std::string>;
+    using csr_t = csr_graph<key_t, EdgeT>;
+    if constexpr (!can_enumerate<key_t, Owner>) {
+        return nullptr;
+    } else {
+        const std::string path = csr_path(gg_path);
+        std::ifstream is(path, std::ios::binary);
+        if (!is) return nullptr;
+        char magic[sizeof csr_file_magic];
+        if (!is.read(magic, sizeof magic) ||
+            std::memcmp(magic, csr_file_magic, sizeof magic) != 0) {
+            throw std::runtime_error("not a pygenogrove frozen-graph file: " + path);
+        }
+        auto stale = [&path] {
+            return std::runtime_error(path + " does not match the grove it was written with");
+        };
+        const auto index_count = read_pod<uint64_t>(is);
+        std::vector<std::string> names;
+        std::vector<uint64_t> sizes;
+        for (uint64_t i = 0; i < index_count; ++i) {
+            names.push_back(traits::deserialize(is));
+            sizes.push_back(read_pod<uint64_t>(is));
+        }
+        const auto n = read_pod<uint64_t>(is);
+        if (n > std::numeric_limits<uint32_t>::max()) throw stale();
+        std::vector<std::pair<uint32_t, uint64_t>> at(n);
+        std::vector<bool> used(names.size());
+        for (auto& [index, pos] : at) {
+            index = read_pod<uint32_t>(is);
+            pos = read_pod<uint64_t>(is);
+            if (index >= names.size() || pos >= sizes[index]) throw stale();
+            used[index] = true;
+        }
+        // Only the indices holding a vertex are read, each once, in key order.
+        std::vector<std::vector<key_t*>> keys(names.size());
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (!used[i]) continue;
+            for_each_owner_key<key_t>(owner, names[i],
+                                      [&](key_t* key) { keys[i].push_back(key); });
+            if (keys[i].size() != sizes[i]) throw stale();
+        }
+        csr_t g;
+        g.vertices.reserve(n);
+        for (const auto& [index, pos] : at) {
+            key_t* key = keys[index][pos];
+            g.index.emplace(key, static_cast<uint32_t>(g.vertices.size()));
+            g.vertices.push_back(key);
+        }
+        g.offsets.resize(n + 1);
+        is.read(reinterpret_cast<char*>(g.offsets.data()),
+                static_cast<std::streamsize>(g.offsets.size() * sizeof(uint64_t)));
+        const auto m = read_pod<uint64_t>(is);
+        if (g.offsets.front() != 0 || g.offsets.back() != m ||
+            !std::is_sorted(g.offsets.begin(), g.offsets.end())) {
+            throw stale();
+        }
+        g.targets.resize(m);
+        is.read(reinterpret_cast<char*>(g.targets.data()),
+                static_cast<std::streamsize>(m * sizeof(uint32_t)));
+        if constexpr (!std::is_void_v<EdgeT>) {
+            columns_scope scope(&owner);
+            g.metadata.reserve(m);
+            for (uint64_t e = 0; e < m; ++e) g.metadata.push_back(EdgeT::deserialize(is));
+        }
+        if (!is) throw std::runtime_error("truncated frozen-graph file: " + path);
+        for (uint32_t t : g.targets) {
+            if (t >= n) throw stale();
+        }
+        return std::make_shared<const csr_t>(std::move(g));
+    }
+}
+
+}  // namespace pygg
+
+template <typename Owner, typename key_t, typename EdgeT, typename Class>
+void bind_frozen_graph(Class& cls, bool release_gil) {
+    using csr_t = pygg::csr_graph<key_t, EdgeT>;
+    cls.def(
+        "freeze_graph",
+        [release_gil](py::object self, std::optional<std::vector<key_t*>> seeds,
+                      std::optional<std::string> index) {
+            Owner& owner = self.cast<Owner&>();
+            if (seeds && index) throw std::invalid_argument("pass keys or index, not both");
+            if (seeds && std::find(seeds->begin(), seeds->end(), nullptr) != seeds->end()) {
+                throw py::type_error("keys must not contain None");
+            }
+            std::shared_ptr<const csr_t> graph;
+            {
+                std::optional<py::gil_scoped_release> release;
+                if (release_gil) release.emplace();
+                if (!seeds) seeds = pygg::index_keys<key_t>(owner, index);
+                graph = std::make_shared<const csr_t>(csr_t::build(owner, *seeds));
+            }
+            const std::size_t n = graph->vertices.size();
+            pygg::frozen_graph_table::instance().attach(self, &owner, std::move(graph));
+            return n;
+        },
+        py::arg("keys") = py::none(), py::arg("index") = py::none(),
+        R"pbdoc(
+            freeze_graph(keys=None, index=None) -> int
+
+            Snapshot the graph overlay over `keys` (a list of Keys, e.g. an
+            insert_bulk or intersect result) and every Key reachable from them
+            into a compressed-sparse-row layout: the vertices numbered in that
+            order, each vertex's out-edges one contiguous run of target ids, the
+            edge metadata in a parallel array. Without keys, every Key of
+            `index` is frozen, or of every index when index is None too (in
+            index order, indices sorted by name; a KmerGroveView cannot
+            enumerate its indices and needs keys). get_neighbors and the
+            traversals read the snapshot from then on. Any edge mutation (or
+            remove_key / compact) thaws it; freezing again replaces it. Returns
+            the number of vertices frozen.
+        )pbdoc");
+    cls.def(
+        "thaw_graph",
+        [](const Owner& owner) { pygg::thaw_graph(&owner); },
+        "Drop the freeze_graph() snapshot, if any.");
+    cls.def(
+        "graph_frozen",
+        [](Owner& owner) { return pygg::frozen_graph<key_t, EdgeT>(&owner) != nullptr; },
+        "Return True while a freeze_graph() snapshot is in effect.");
+    cls.def(
+        "frozen_csr",
+        [](py::object self) {
+            auto graph = pygg::frozen_graph<key_t, EdgeT>(&self.cast<Owner&>());
+            if (!graph) throw std::invalid_argument("graph is not frozen; call freeze_graph()");
+            py::array_t<int64_t> indptr(static_cast<py::ssize_t>(graph->offsets.size()));
+            std::copy(graph->offsets.begin(), graph->offsets.end(), indptr.mutable_data());
+            py::array_t<int32_t> indices(static_cast<py::ssize_t>(graph->targets.size()));
+            std::copy(graph->targets.begin(), graph->targets.end(), indices.mutable_data());
+            return py::make_tuple(indptr, indices, pinned_key_list(graph->vertices, self));
+        },
+        R"pbdoc(
+            frozen_csr() -> tuple[numpy.ndarray, numpy.ndarray, list[Key]]
+
+            The frozen snapshot as (indptr, indices, keys): vertex i's targets
+            are indices[indptr[i]:indptr[i+1]] (int64 / int32 arrays), and
+            keys[i] is vertex i's Key. Raises ValueError when the graph is not
+            frozen.
+        )pbdoc");
+}
@@ -0,0 +1,304 @@
+/*
+ * Graph clustering over the overlay — connected_components /
+ * strongly_connected_components / topological_order on every grove and grove
+ * view. Each runs on a CSR graph (frozen_graph.hpp): the freeze_graph()
+ * snapshot (else every index), or one built for the call over the given keys
+ * and everything reachable from them — for weak components, over every index,
+ * since an in-edge from outside that closure still joins two keys. Component
+ * ids are int32, aligned with the given keys (or the graph's vertex order) and
+ * numbered by first appearance, so the result is deterministic.
+ *
+ * Weak components use a concurrent union-find: worker threads each take a slice
+ * of the vertices and unite every edge's endpoints, linking by CAS (a root is
+ * always linked under a smaller vertex id, so no cycle can form) with path
+ * halving on find. Strong components are an iterative Tarjan; topological_order
+ * is Kahn's algorithm, FIFO by vertex id. Only building the graph for a view
+ * holds the GIL (paging mutates its block cache); the algorithms release it.
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../data_type/key_list.hpp"
+#include "../io/kmer_source.hpp"
+#include "frozen_graph.hpp"
+#include "index_keys.hpp"
+
+namespace py = pybind11;
+
+namespace pygg {
+
+class concurrent_union_find {
+  public:
+    explicit concurrent_union_find(std::size_t n) : parent_(n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            parent_[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t find(uint32_t x) {
+        for (;;) {
+            uint32_t p = parent_[x].load(std::memory_order_acquire);
+            if (p == x) return x;
+            const uint32_t gp = parent_[p].load(std::memory_order_acquire);
+            if (p != gp) parent_[x].compare_exchange_weak(p, gp, std::memory_order_acq_rel);
+            x = gp;
+        }
+    }
+
+    void unite(uint32_t a, uint32_t b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (a < b) std::swap(a, b);
+            uint32_t expected = a;
+            if (parent_[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) return;
+        }
+    }
+
+  private:
+    std::vector<std::atomic<uint32_t>> parent_;
+};
+
+// Below this many vertices the threads cost more than they save.
+inline constexpr std::size_t parallel_components_min = std::size_t{1} << 15;
+
+// Renumber per-vertex labels densely by first appearance in vertex order.
+inline std::vector<int32_t> dense_labels(const std::vector<uint32_t>& label) {
+    std::vector<int32_t> id(label.size(), -1);
+    std::vector<int32_t> out(label.size());
+    int32_t next = 0;
+    for (std::size_t v = 0; v < label.size(); ++v) {
+        int32_t& c = id[label[v]];
+        if (c < 0) c = next++;
+        out[v] = c;
+    }
+    return out;
+}
+
+template <typename key_t, typename EdgeT>
+std::vector<int32_t> weak_components(const csr_graph<key_t, EdgeT>& g, unsigned threads) {
+    const std::size_t n = g.vertices.size();
+    concurrent_union_find uf(n);
+    auto unite_slice = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t v = begin; v < end; ++v) {
+            for (uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                uf.unite(static_cast<uint32_t>(v), g.targets[e]);
+            }
+        }
+    };
+    threads = n < parallel_components_min ? 1 : resolve_threads(threads);
+    if (threads == 1) {
+        unite_slice(0, n);
+    } else {
+        std::vector<std::thread> workers;
+        const std::size_t step = (n + threads - 1) / threads;
+        for (std::size_t begin = 0; begin < n; begin += step) {
+            workers.emplace_back(unite_slice, begin, std::min(n, begin + step));
+        }
+        for (auto& w : workers) w.join();
+    }
+    std::vector<uint32_t> root(n);
+    for (std::size_t v = 0; v < n; ++v) root[v] = uf.find(static_cast<uint32_t>(v));
+    return dense_labels(root);
+}
+
+template <typename key_t, typename EdgeT>
+std::vector<int32_t> strong_components(const csr_graph<key_t, EdgeT>& g) {
+    constexpr uint32_t unvisited = std::numeric_limits<uint32_t>::max();
+    const std::size_t n = g.vertices.size();
+    std::vector<uint32_t> order(n, unvisited), low(n), scc(n);
+    std::vector<bool> on_stack(n, false);
+    std::vector<uint32_t> stack;
+    std::vector<std::pair<uint32_t, uint64_t>> calls;  // (vertex, next edge)
+    uint32_t counter = 0, components = 0;
+    for (uint32_t root = 0; root < n; ++root) {
+        if (order[root] != unvisited) continue;
+        calls.emplace_back(root, g.offsets[root]);
+        order[root] = low[root] = counter++;
+        stack.push_back(root);
+        on_stack[root] = true;
+        while (!calls.empty()) {
+            auto& [v, e] = calls.back();
+            if (e < g.offsets[v + 1]) {
+                const uint32_t w = g.targets[e++];
+                if (order[w] == unvisited) {
+                    order[w] = low[w] = counter++;
+                    stack.push_back(w);
+                    on_stack[w] = true;
+                    calls.emplace_back(w, g.offsets[w]);
+                } else if (on_stack[w]) {
+                    low[v] = std::min(low[v], order[w]);
+                }
+                continue;
+            }
+            const uint32_t done = v;
+            calls.pop_back();
+            if (!calls.empty()) {
+                const uint32_t parent = calls.back().first;
+                low[parent] = std::min(low[parent], low[done]);
+            }
+            if (low[done] == order[done]) {
+                uint32_t w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    on_stack[w] = false;
+                    scc[w] = components;
+                } while (w != done);
+                ++components;
+            }
+        }
+    }
+    return dense_labels(scc);
+}
+
+// The component ids of `keys` (each a vertex of g) from g's per-vertex ids,
+// renumbered 0.. by first appearance in `keys`.
+template <typename key_t, typename EdgeT>
+std::vector<int32_t> ids_of_keys(const csr_graph<key_t, EdgeT>& g,
+                                 const std::vector<int32_t>& per_vertex,
+                                 const std::vector<key_t*>& keys) {
+    std::vector<int32_t> id(g.vertices.size(), -1);
+    std::vector<int32_t> out;
+    out.reserve(keys.size());
+    int32_t next = 0;
+    for (auto* key : keys) {
+        int32_t& c = id[per_vertex[*g.find(key)]];
+        if (c < 0) c = next++;
+        out.push_back(c);
+    }
+    return out;
+}
+
+// Kahn's algorithm; nullopt when the graph has a cycle.
+template <typename key_t, typename EdgeT>
+std::optional<std::vector<uint32_t>> topological_sort(const csr_graph<key_t, EdgeT>& g) {
+    const std::size_t n = g.vertices.size();
+    std::vector<uint32_t> indegree(n, 0);
+    for (uint32_t t : g.targets) ++indegree[t];
+    std::vector<uint32_t> out;
+    out.reserve(n);
+    for (uint32_t v = 0; v < n; ++v) {
+        if (indegree[v] == 0) out.push_back(v);
+    }
+    for (std::size_t head = 0; head < out.size(); ++head) {
+        const uint32_t v = out[head];
+        for (uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+            if (--indegree[g.targets[e]] == 0) out.push_back(g.targets[e]);
+        }
+    }
+    if (out.size() != n) return std::nullopt;
+    return out;
+}
+
+}  // namespace pygg
+
+template <typename Owner, typename key_t, typename EdgeT, typename Class>
+void bind_graph_components(Class& cls, bool release_gil) {
+    using csr_t = pygg::csr_graph<key_t, EdgeT>;
+    auto graph_of = [release_gil](py::object self,
+                                  const std::optional<std::vector<key_t*>>& keys) {
+        return pygg::csr_for<Owner, key_t, EdgeT>(self.cast<Owner&>(), keys, release_gil);
+    };
+    auto keys_and_ids = [](const std::vector<key_t*>& keys, const std::vector<int32_t>& ids,
+                           py::handle self) {
+        py::array_t<int32_t> out(static_cast<py::ssize_t>(ids.size()));
+        std::copy(ids.begin(), ids.end(), out.mutable_data());
+        return py::make_tuple(pinned_key_list(keys, self), out);
+    };
+    // With keys: their ids alone, aligned with `keys`. Weak components join
+    // through in-edges too, so they run over every index of the owner (plus
+    // the closure of `keys`) rather than over the closure alone; a view that
+    // cannot enumerate its indices falls back to the closure.
+    auto components = [=](py::object self, const std::optional<std::vector<key_t*>>& keys,
+                          bool weak, unsigned threads) {
+        std::shared_ptr<const csr_t> g;
+        if (keys && weak) {
+            if constexpr (pygg::can_enumerate<key_t, Owner>) {
+                auto& owner = self.cast<Owner&>();
+                auto all = pygg::index_keys<key_t>(owner, std::nullopt);
+                all.insert(all.end(), keys->begin(), keys->end());
+                g = graph_of(self, all);
+            }
+        }
+        if (!g) g = graph_of(self, keys);
+        std::vector<int32_t> ids;
+        {
+            py::gil_scoped_release release;
+            ids = weak ? pygg::weak_components(*g, threads) : pygg::strong_components(*g);
+            if (keys) ids = pygg::ids_of_keys(*g, ids, *keys);
+        }
+        return keys_and_ids(keys ? *keys : g->vertices, ids, self);
+    };
+    cls.def(
+        "connected_components",
+        [=](py::object self, const std::optional<std::vector<key_t*>>& keys, bool weak,
+            unsigned threads) { return components(self, keys, weak, threads); },
+        py::arg("keys") = py::none(), py::arg("weak") = true, py::arg("threads") = 0,
+        R"pbdoc(
+            connected_components(keys=None, weak=True, threads=0) -> tuple[list[Key], numpy.ndarray]
+
+            Component ids of `keys`: returns `keys` and an int32 array aligned
+            with them, numbered 0.. by first appearance. keys=None labels every
+            vertex of the freeze_graph() snapshot in its vertex order, or when
+            nothing is frozen every Key of every index in index order.
+            weak=True ignores edge direction (a parallel union-find over
+            `threads` workers; 0: all cores) and counts in-edges from anywhere
+            in the grove, so it walks every index; a KmerGroveView cannot
+            enumerate its indices and only sees the edges reachable from
+            `keys`. weak=False gives the strongly connected components, which
+            the reachable closure of `keys` decides exactly.
+        )pbdoc");
+    cls.def(
+        "strongly_connected_components",
+        [=](py::object self, const std::optional<std::vector<key_t*>>& keys) {
+            return components(self, keys, false, 0);
+        },
+        py::arg("keys") = py::none(),
+        R"pbdoc(
+            strongly_connected_components(keys=None) -> tuple[list[Key], numpy.ndarray]
+
+            Strongly connected components, as connected_components(keys,
+            weak=False): `keys` and an int32 array of their component ids.
+        )pbdoc");
+    cls.def(
+        "topological_order",
+        [=](py::object self, const std::optional<std::vector<key_t*>>& keys) {
+            auto g = graph_of(self, keys);
+            std::optional<std::vector<uint32_t>> order;
+            {
+                py::gil_scoped_release release;
+                order = pygg::topological_sort(*g);
+            }
+            if (!order) throw std::invalid_argument("graph has a cycle; topological_order needs a DAG");
+            std::vector<key_t*> out;
+            out.reserve(order->size());
+            for (uint32_t v : *order) out.push_back(g->vertices[v]);
+            return pinned_key_list(out, self);
+        },
+        py::arg("keys") = py::none(),
+        R"pbdoc(
+            topological_order(keys=None) -> list[Key]
+
+            The vertices of the overlay over `keys` and everything reachable
+            from them (keys=None: the freeze_graph() snapshot, else every
+            index) ordered so every edge points forward; ties keep vertex
+            order. Raises ValueError when the graph has a cycle.
+        )pbdoc");
+}
@@ -0,0 +1,347 @@
+/*
+ * Native traversals over the graph overlay — bfs / reachable / shortest_path /
+ * k_hop_neighborhood on every grove and grove view. The walk runs in C++ and
+ * returns the visited Keys with an int32 depth array in one call, instead of one
+ * get_neighbors() round trip (and pinned Key list) per vertex.
+ *
+ * The walk is a plain breadth-first search over out-edges, level by level, with
+ * a visited set keyed by key pointer; shortest_path keeps each vertex's BFS
+ * parent and stops at the target. An optional edge_filter restricts which edges
+ * are followed: on JSON-edge groves it receives the edge metadata (as
+ * get_neighbors_if), on void-edge groves the target Key.
+ *
+ * After freeze_graph(), a walk whose sources are all in the CSR snapshot
+ * (frozen_graph.hpp) runs on vertex ids alone — each vertex's out-edges one
+ * contiguous run of target ids, a bitmap for the visited set, no key lookups
+ * — and maps ids back to Keys once at the end; a view pages nothing further.
+ * The snapshot is closed under reachability, so the walk never leaves it.
+ * Sources outside it walk get_neighbors.
+ *
+ * A grove walks with the GIL released unless an edge_filter has to call into
+ * Python. A view keeps the GIL (paging mutates its block cache) and pages a
+ * target's block in when get_neighbors resolves it; the cache never evicts, so
+ * no block is read twice. There is no per-level prefetch: a view exposes no
+ * block ids, so a frontier's blocks cannot be collected and sorted up front.
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../data_type/key_list.hpp"
+#include "../data_type/payload_columns.hpp"
+#include "bulk_edges.hpp"
+#include "frozen_graph.hpp"
+
+namespace py = pybind11;
+
+namespace pygg {
+
+template <typename key_t>
+struct traversal {
+    std::vector<key_t*> keys;      // visit order; seeds first
+    std::vector<int32_t> depth;    // hops from the nearest seed
+    std::vector<int64_t> parent;   // index into keys of the BFS parent, -1 for a seed
+};
+
+template <typename key_t>
+using neighbor_fn = std::function<void(key_t*, std::vector<key_t*>&)>;
+
+// Breadth-first walk from `seeds` up to max_depth hops (< 0: unbounded). Stops
+// early once `stop` (if non-null) is reached.
+template <typename key_t>
+traversal<key_t> bfs_walk(const std::vector<key_t*>& seeds, int max_depth,
+                          const neighbor_fn<key_t>& neighbors, const key_t* stop = nullptr) {
+    traversal<key_t> out;
+    std::unordered_map<const key_t*, std::size_t> seen;
+    for (key_t* s : seeds) {
+        if (seen.emplace(s, out.keys.size()).second) {
+            out.keys.push_back(s);
+            out.depth.push_back(0);
+            out.parent.push_back(-1);
+        }
+    }
+    if (stop && seen.count(stop)) return out;
+    std::vector<key_t*> next;
+    std::size_t level_begin = 0;
+    for (int32_t d = 1; max_depth < 0 || d <= max_depth; ++d) {
+        const std::size_t level_end = out.keys.size();
+        if (level_begin == level_end) break;
+        for (std::size_t i = level_begin; i < level_end; ++i) {
+            next.clear();
+            neighbors(out.keys[i], next);
+            for (key_t* t : next) {
+                if (!seen.emplace(t, out.keys.size()).second) continue;
+                out.keys.push_back(t);
+                out.depth.push_back(d);
+                out.parent.push_back(static_cast<int64_t>(i));
+                if (t == stop) return out;
+            }
+        }
+        level_begin = level_end;
+    }
+    return out;
+}
+
+// bfs_walk over a CSR snapshot by vertex id; keep(e) decides whether edge e is
+// followed.
+template <typename key_t, typename EdgeT, typename Keep>
+traversal<key_t> bfs_walk_csr(const csr_graph<key_t, EdgeT>& g, const std::vector<uint32_t>& seeds,
+                              int max_depth, Keep&& keep,
+                              std::optional<uint32_t> stop = std::nullopt) {
+    traversal<key_t> out;
+    std::vector<uint32_t> order;
+    std::vector<bool> visited(g.vertices.size());
+    auto finish = [&] {
+        out.keys.reserve(order.size());
+        for (uint32_t v : order) out.keys.push_back(g.vertices[v]);
+        return std::move(out);
+    };
+    for (uint32_t s : seeds) {
+        if (visited[s]) continue;
+        visited[s] = true;
+        order.push_back(s);
+        out.depth.push_back(0);
+        out.parent.push_back(-1);
+    }
+    if (stop && visited[*stop]) return finish();
+    std::size_t level_begin = 0;
+    for (int32_t d = 1; max_depth < 0 || d <= max_depth; ++d) {
+        const std::size_t level_end = order.size();
+        if (level_begin == level_end) break;
+        for (std::size_t i = level_begin; i < level_end; ++i) {
+            const uint32_t v = order[i];
+            for (uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                const uint32_t t = g.targets[e];
+                if (visited[t] || !keep(e)) continue;
+                visited[t] = true;
+                order.push_back(t);
+                out.depth.push_back(d);
+                out.parent.push_back(static_cast<int64_t>(i));
+                if (stop && t == *stop) return finish();
+            }
+        }
+        level_begin = level_end;
+    }
+    return finish();
+}
+
+// Drop the depth-0 (seed) entries, keeping order.
+template <typename key_t>
+void drop_seeds(traversal<key_t>& t) {
+    std::size_t w = 0;
+    for (std::size_t r = 0; r < t.keys.size(); ++r) {
+        if (t.depth[r] == 0) continue;
+        t.keys[w] = t.keys[r];
+        t.depth[w] = t.depth[r];
+        ++w;
+    }
+    t.keys.resize(w);
+    t.depth.resize(w);
+    t.parent.clear();
+}
+
+}  // namespace pygg
+
+template <typename Owner, typename key_t, typename EdgeT, typename Class>
+void bind_graph_traversal(Class& cls, bool release_gil) {
+    // A Key or a sequence of Keys.
+    auto seeds_of = [](py::handle source) {
+        if (py::isinstance<py::list>(source) || py::isinstance<py::tuple>(source)) {
+            return pygg::resolve_keys<key_t>(source, nullptr, "source");
+        }
+        if (source.is_none()) throw py::type_error("source must not be None");
+        return std::vector<key_t*>{source.cast<key_t*>()};
+    };
+    // Out-neighbours, restricted by the optional Python edge_filter; read from
+    // the freeze_graph() snapshot when there is one.
+    auto neighbors_of = [](py::object self, py::object edge_filter) -> pygg::neighbor_fn<key_t> {
+        Owner* owner = &self.cast<Owner&>();
+        // Views page blocks in per lookup; their payloads need the columns.
+        std::shared_ptr<const pygg::payload_columns> cols = pygg::grove_columns(owner);
+        if (auto csr = pygg::frozen_graph<key_t, EdgeT>(owner)) {
+            return [owner, cols, csr, self, edge_filter](key_t* k, std::vector<key_t*>& out) {
+                pygg::columns_scope scope(cols.get());
+                auto v = csr->find(k);
+                if (!v) {
+                    for (auto* t : owner->get_neighbors(k)) out.push_back(t);
+                    return;
+                }
+                for (uint64_t e = csr->offsets[*v]; e < csr->offsets[*v + 1]; ++e) {
+                    key_t* t = csr->vertices[csr->targets[e]];
+                    if (!edge_filter.is_none()) {
+                        py::object arg;
+                        if constexpr (std::is_void_v<EdgeT>) {
+                            arg = py::cast(t, py::return_value_policy::reference_internal, self);
+                        } else {
+                            arg = py::cast(csr->metadata[e]);
+                        }
+                        if (!edge_filter(arg).template cast<bool>()) continue;
+                    }
+                    out.push_back(t);
+                }
+            };
+        }
+        if (edge_filter.is_none()) {
+            return [owner, cols](key_t* k, std::vector<key_t*>& out) {
+                pygg::columns_scope scope(cols.get());
+                for (auto* t : owner->get_neighbors(k)) out.push_back(t);
+            };
+        }
+        if constexpr (!std::is_void_v<EdgeT>) {
+            return [owner, cols, edge_filter](key_t* k, std::vector<key_t*>& out) {
+                pygg::columns_scope scope(cols.get());
+                auto keep = [&](const EdgeT& m) { return edge_filter(m).template cast<bool>(); };
+                for (auto* t : owner->get_neighbors_if(k, std::function<bool(const EdgeT&)>(keep))) {
+                    out.push_back(t);
+                }
+            };
+        } else {
+            return [owner, cols, self, edge_filter](key_t* k, std::vector<key_t*>& out) {
+                pygg::columns_scope scope(cols.get());
+                for (auto* t : owner->get_neighbors(k)) {
+                    py::object key = py::cast(t, py::return_value_policy::reference_internal, self);
+                    if (edge_filter(key).template cast<bool>()) out.push_back(t);
+                }
+            };
+        }
+    };
+    // Run fn with the GIL released when nothing in it calls back into Python.
+    auto run = [release_gil](const py::object& edge_filter, auto&& fn) {
+        std::optional<py::gil_scoped_release> release;
+        if (release_gil && edge_filter.is_none()) release.emplace();
+        return fn();
+    };
+    // One walk: by vertex id when every source is in the freeze_graph()
+    // snapshot, otherwise over get_neighbors.
+    auto walk = [neighbors_of, run](py::object self, const std::vector<key_t*>& seeds,
+                                    int max_depth, py::object edge_filter,
+                                    const key_t* stop = nullptr) {
+        if (auto csr = pygg::frozen_graph<key_t, EdgeT>(&self.cast<Owner&>())) {
+            std::vector<uint32_t> ids;
+            ids.reserve(seeds.size());
+            for (key_t* s : seeds) {
+                auto v = csr->find(s);
+                if (!v) break;
+                ids.push_back(*v);
+            }
+            if (ids.size() == seeds.size()) {
+                std::optional<uint32_t> stop_id;
+                if (stop) {
+                    stop_id = csr->find(stop);
+                    if (!stop_id) max_depth = 0;  // outside the closure: unreachable
+                }
+                if (edge_filter.is_none()) {
+                    return run(edge_filter, [&] {
+                        return pygg::bfs_walk_csr(
+                            *csr, ids, max_depth, [](uint64_t) { return true; }, stop_id);
+                    });
+                }
+                auto keep = [&](uint64_t e) {
+                    py::object arg;
+                    if constexpr (std::is_void_v<EdgeT>) {
+                        arg = py::cast(csr->vertices[csr->targets[e]],
+                                       py::return_value_policy::reference_internal, self);
+                    } else {
+                        arg = py::cast(csr->metadata[e]);
+                    }
+                    return edge_filter(arg).template cast<bool>();
+                };
+                return pygg::bfs_walk_csr(*csr, ids, max_depth, keep, stop_id);
+            }
+        }
+        auto next = neighbors_of(self, edge_filter);
+        return run(edge_filter,
+                   [&] { return pygg::bfs_walk<key_t>(seeds, max_depth, next, stop); });
+    };
+    auto keys_and_depths = [](pygg::traversal<key_t>& t, py::handle self) {
+        py::array_t<int32_t> depth(static_cast<py::ssize_t>(t.depth.size()));
+        std::copy(t.depth.begin(), t.depth.end(), depth.mutable_data());
+        return py::make_tuple(pinned_key_list(t.keys, self), depth);
+    };
+    cls.def(
+        "bfs",
+        [=](py::object self, py::handle source, int max_depth, py::object edge_filter) {
+            auto seeds = seeds_of(source);
+            auto t = walk(self, seeds, max_depth, edge_filter);
+            return keys_and_depths(t, self);
+        },
+        py::arg("source"), py::arg("max_depth") = -1, py::arg("edge_filter") = py::none(),
+        R"pbdoc(
+            bfs(source, max_depth=-1, edge_filter=None) -> tuple[list[Key], numpy.ndarray]
+
+            Breadth-first walk over out-edges from `source` (a Key, or a list of
+            Keys walked together), up to max_depth hops (-1: unbounded). Returns
+            the visited Keys in BFS order — the sources first — and an int32
+            array of their depths. edge_filter restricts the edges followed: it
+            receives the edge metadata on JSON-edge groves, the target Key on
+            void-edge groves.
+        )pbdoc");
+    cls.def(
+        "reachable",
+        [=](py::object self, py::handle source, py::object edge_filter) {
+            auto seeds = seeds_of(source);
+            auto t = walk(self, seeds, -1, edge_filter);
+            pygg::drop_seeds(t);
+            return pinned_key_list(t.keys, self);
+        },
+        py::arg("source"), py::arg("edge_filter") = py::none(),
+        R"pbdoc(
+            reachable(source, edge_filter=None) -> list[Key]
+
+            Every Key reachable from `source` (a Key or a list of Keys) along one
+            or more edges, in BFS order, excluding the sources themselves.
+        )pbdoc");
+    cls.def(
+        "shortest_path",
+        [=](py::object self, py::handle source, key_t* target,
+            py::object edge_filter) -> py::object {
+            auto seeds = seeds_of(source);
+            auto t = walk(self, seeds, -1, edge_filter, target);
+            auto it = std::find(t.keys.begin(), t.keys.end(), target);
+            if (it == t.keys.end()) return py::none();
+            std::vector<key_t*> path;
+            for (int64_t i = it - t.keys.begin(); i >= 0; i = t.parent[static_cast<std::size_t>(i)]) {
+                path.push_back(t.keys[static_cast<std::size_t>(i)]);
+            }
+            std::reverse(path.begin(), path.end());
+            return pinned_key_list(path, self);
+        },
+        py::arg("source"), py::arg("target").none(false), py::arg("edge_filter") = py::none(),
+        R"pbdoc(
+            shortest_path(source, target, edge_filter=None) -> list[Key] | None
+
+            The fewest-hop path from `source` (a Key or a list of Keys) to
+            `target`, as the Keys along it (both ends included), or None when
+            target is unreachable. The search stops as soon as target is found.
+        )pbdoc");
+    cls.def(
+        "k_hop_neighborhood",
+        [=](py::object self, py::handle source, int k, py::object edge_filter) {
+            if (k < 0) throw std::invalid_argument("k must be non-negative");
+            auto seeds = seeds_of(source);
+            auto t = walk(self, seeds, k, edge_filter);
+            pygg::drop_seeds(t);
+            return keys_and_depths(t, self);
+        },
+        py::arg("source"), py::arg("k"), py::arg("edge_filter") = py::none(),
+        R"pbdoc(
+            k_hop_neighborhood(source, k, edge_filter=None) -> tuple[list[Key], numpy.ndarray]
+
+            The Keys within k out-edge hops of `source` (a Key or a list of
+            Keys), excluding the sources, with an int32 array of their hop
+            distances (1..k), in BFS order.
+        )pbdoc");
+}
@@ -7,12 +7,20 @@
  * grove<genomic_coordinate, json_value, json_value>, BedGrove =
  * grove<genomic_coordinate, bed_entry>, …).
  *
- * Every grove carries a payload. Three type-dependent variations are switched
+ * Every grove carries a payload. Nine type-dependent variations are switched
  * with `if constexpr`: the insert/add_external_key `data` argument defaults to
  * None for the JSON payload (grove_data_optional); the entry-deriving
  * insert(index, entry) overloads exist only for the genomic_coordinate key with
- * a derivable entry type; and the labelled-edge methods (add_edge with a payload,
- * get_edges, get_neighbors_if, link_with) exist only when EdgeT is non-void.
+ * a derivable entry type; insert_vcf exists only for the packed-genotype payload
+ * (VariantGrove); from_sequences exists only for the kmer key (KmerGrove);
+ * contains_many / lookup_many exist only for the point keys (KmerGrove,
+ * NumericGrove); range / range_count exist only for the numeric key;
+ * link_overlaps exists only for the genomic_coordinate key; interned
+ * payload fields (intern_fields, intersect_where, the "<path>.columns" file)
+ * and in-place payload updates (set_data, set_data_many, update) exist only
+ * for the JSON payload; and the labelled-edge methods (add_edge with a
+ * payload, get_edges, get_neighbors_if, link_with) exist only when EdgeT is
+ * non-void.
  */
 #pragma once
 
@@ -20,25 +28,46 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <cstdio>
 #include <functional>
 #include <fstream>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <genogrove/data_type/interval.hpp>
 #include <genogrove/data_type/key.hpp>
+#include <genogrove/data_type/kmer.hpp>
 #include <genogrove/structure/grove/grove.hpp>
 
 #include "../data_type/key.hpp"
+#include "../data_type/json_value.hpp"
 #include "../data_type/key_list.hpp"
+#include "../data_type/payload_columns.hpp"
 #include "../data_type/query_result.hpp"
 #include "../data_type/flanking_query_result.hpp"
+#include "../data_type/variant_genotypes.hpp"
 #include "../io/entry_interval.hpp"
+#include "../io/kmer_source.hpp"
+#include "../io/vcf_reader.hpp"
+#include "batch_lookup.hpp"
+#include "edge_export.hpp"
+#include "bulk_edges.hpp"
+#include "bulk_remove.hpp"
+#include "frozen_graph.hpp"
+#include "graph_components.hpp"
+#include "graph_traversal.hpp"
+#include "interned_fields.hpp"
+#include "key_handles.hpp"
+#include "numeric_range.hpp"
+#include "overlap_links.hpp"
+#include "payload_update.hpp"
 
 namespace py = pybind11;
 namespace ggs = genogrove::structure;
@@ -99,6 +128,7 @@ void bind_grove(py::module_& m, const char* grove_name,
     {
         auto insert_fn = [](grove_t& g, const std::string& index,
                             const KeyT& key, DataT data) {
+            pygg::apply_columns(&g, data);
             return g.insert_data(index, key, std::move(data));
         };
         const char* insert_doc = R"pbdoc(
@@ -135,6 +165,7 @@ void bind_grove(py::module_& m, const char* grove_name,
         cls.def("insert_sorted",
                 [](grove_t& g, const std::string& index,
                    const KeyT& interval, DataT data) {
+                    pygg::apply_columns(&g, data);
                     return g.insert_data(index, interval, std::move(data),
                                          ggs::sorted);
                 },
@@ -161,6 +192,7 @@ void bind_grove(py::module_& m, const char* grove_name,
                     std::vector<key_t*> keys;
                     {
                         py::gil_scoped_release rel;
+                        pygg::apply_columns(&g, items);
                         keys = presorted
                                    ? g.insert_data(index, items, ggs::sorted, ggs::bulk)
                                    : g.insert_data(index, std::move(items), ggs::bulk);
@@ -258,6 +290,113 @@ void bind_grove(py::module_& m, const char* grove_name,
                         + strand. Same append precondition as the explicit form.
                     )pbdoc");
         }
+
+        // ---- VCF bulk load (VariantGrove: packed-genotype payload) ----
+        if constexpr (std::is_same_v<KeyT, gdt::genomic_coordinate> &&
+                      has_packed_genotypes<DataT>) {
+            cls.def("insert_vcf",
+                    [](grove_t& g, pygg::vcf_reader_handle& reader, bool gq,
+                       bool dp) {
+                        // Buffer per contig, then bulk-build each index once: a
+                        // VCF is position-sorted but not (start, end)-sorted, so
+                        // the sorting bulk path is used rather than the append one.
+                        std::unordered_map<std::string,
+                                           std::vector<std::pair<KeyT, DataT>>>
+                            by_chrom;
+                        std::size_t n = 0;
+                        for (gio::vcf_entry e; reader.read_next(e);
+                             e = gio::vcf_entry{}) {
+                            by_chrom[e.chrom].emplace_back(
+                                genomic_coordinate_from_entry(e),
+                                DataT::from_entry(e, gq, dp));
+                            ++n;
+                        }
+                        for (auto& [chrom, items] : by_chrom) {
+                            g.insert_data(chrom, std::move(items), ggs::bulk);
+                        }
+                        return n;
+                    },
+                    py::arg("reader"), py::arg("gq") = false,
+                    py::arg("dp") = false,
+                    // htslib read + packing + tree build touch no Python objects.
+                    py::call_guard<py::gil_scoped_release>(),
+                    R"pbdoc(
+                        insert_vcf(reader, gq=False, dp=False) -> int
+
+                        Drain a VcfReader into the grove: each record is keyed by
+                        its unstranded reference span (as VcfEntry.to_coordinate())
+                        on its CHROM index, with a VariantGenotypes payload packed
+                        from its samples (gq / dp also store those FORMAT fields).
+                        The reader's samples / skip_filtered / region options apply.
+                        Returns the number of records inserted.
+
+                        PRECONDITION: like insert_bulk, each CHROM index must be
+                        empty or hold only keys before the file's records.
+                    )pbdoc");
+        }
+
+        // ---- Bulk build from sequences (KmerGrove) ----
+        if constexpr (std::is_same_v<KeyT, gdt::kmer> && grove_data_optional<DataT>) {
+            auto build = [](pygg::fasta_reader_handle& reader, unsigned k,
+                            bool canonical, std::size_t step, const std::string& index,
+                            std::optional<int> order, unsigned threads) {
+                std::vector<uint64_t> enc;
+                pygg::for_each_reader_kmer(reader, k, canonical, step,
+                                           [&](uint64_t e) { enc.push_back(e); });
+                pygg::sort_unique(enc, threads);
+                // One k, so encoding order is Kmer order: the sorted bulk path.
+                std::vector<std::pair<KeyT, DataT>> items;
+                items.reserve(enc.size());
+                for (uint64_t e : enc) {
+                    items.emplace_back(KeyT(e, static_cast<uint8_t>(k)), DataT{});
+                }
+                grove_t g = order ? grove_t(*order) : grove_t();
+                if (!items.empty()) {
+                    g.insert_data(index, items, ggs::sorted, ggs::bulk);
+                }
+                return g;
+            };
+            const char* from_sequences_doc = R"pbdoc(
+                from_sequences(source, k, canonical=True, step=1, index="kmers",
+                               order=None, threads=0) -> KmerGrove
+
+                Build a k-mer dictionary from every k-mer (1 <= k <= 32) of a
+                FASTA/FASTQ source — a FastaReader (whole or chunk_size mode) or
+                a path, which is streamed in 1 Mb windows. A rolling 2-bit
+                encoder skips k-mers containing non-A/C/G/T bases; canonical=True
+                keeps min(k-mer, reverse complement); step=s keeps k-mers
+                starting at multiples of s. The distinct k-mers are deduplicated
+                with a parallel sort (threads=0: all cores) and bulk-built into
+                `index` with None payloads, all with the GIL released.
+            )pbdoc";
+            cls.def_static(
+                "from_sequences",
+                [build](pygg::fasta_reader_handle& reader, unsigned k, bool canonical,
+                        std::size_t step, const std::string& index,
+                        std::optional<int> order, unsigned threads) {
+                    pygg::check_kmer_k(k);
+                    if (step == 0) throw std::invalid_argument("step must be positive");
+                    return build(reader, k, canonical, step, index, order, threads);
+                },
+                py::arg("source"), py::arg("k"), py::arg("canonical") = true,
+                py::arg("step") = 1, py::arg("index") = "kmers",
+                py::arg("order") = py::none(), py::arg("threads") = 0,
+                py::call_guard<py::gil_scoped_release>(), from_sequences_doc);
+            cls.def_static(
+                "from_sequences",
+                [build](const std::string& path, unsigned k, bool canonical,
+                        std::size_t step, const std::string& index,
+                        std::optional<int> order, unsigned threads) {
+                    pygg::check_kmer_k(k);
+                    if (step == 0) throw std::invalid_argument("step must be positive");
+                    auto reader = pygg::open_kmer_source(path);
+                    return build(reader, k, canonical, step, index, order, threads);
+                },
+                py::arg("source"), py::arg("k"), py::arg("canonical") = true,
+                py::arg("step") = 1, py::arg("index") = "kmers",
+                py::arg("order") = py::none(), py::arg("threads") = 0,
+                py::call_guard<py::gil_scoped_release>(), from_sequences_doc);
+        }
     }
 
     // ---- Queries (identical for both cases) ----
@@ -329,6 +468,7 @@ void bind_grove(py::module_& m, const char* grove_name,
         // ---- Graph overlay (directed edges between keys) ----
         .def("add_edge",
              [](grove_t& g, key_t* source, key_t* target) {
+                 pygg::thaw_graph(&g);
                  g.add_edge(source, target);
              },
              py::arg("source").none(false), py::arg("target").none(false),
@@ -341,6 +481,7 @@ void bind_grove(py::module_& m, const char* grove_name,
              )pbdoc")
         .def("remove_edge",
              [](grove_t& g, key_t* source, key_t* target) {
+                 pygg::thaw_graph(&g);
                  return g.remove_edge(source, target);
              },
              py::arg("source").none(false), py::arg("target").none(false),
@@ -357,7 +498,8 @@ void bind_grove(py::module_& m, const char* grove_name,
                  // Pin each Key to the Grove so an extracted neighbor can't
                  // dangle after the list is dropped — issue #37.
                  return pinned_key_list(
-                     self.cast<grove_t&>().get_neighbors(source), self);
+                     pygg::neighbors_of<key_t, EdgeT>(self.cast<grove_t&>(), source),
+                     self);
              },
              py::arg("source").none(false),
              R"pbdoc(
@@ -380,23 +522,32 @@ void bind_grove(py::module_& m, const char* grove_name,
         // ---- Graph edge removal / bulk linking ----
         .def("remove_edges_from",
              [](grove_t& g, key_t* source) {
+                 pygg::thaw_graph(&g);
                  return g.remove_edges_from(source);
              },
              py::arg("source").none(false),
              "Remove all outgoing edges from source. Returns the number removed.")
         .def("remove_edges_to",
              [](grove_t& g, key_t* target) {
+                 pygg::thaw_graph(&g);
                  return g.remove_edges_to(target);
              },
              py::arg("target").none(false),
              "Remove all incoming edges to target (O(E) scan over the graph). "
              "Returns the number removed.")
         .def("remove_all_edges",
-             [](grove_t& g, key_t* key) { return g.remove_all_edges(key); },
+             [](grove_t& g, key_t* key) {
+                 pygg::thaw_graph(&g);
+                 return g.remove_all_edges(key);
+             },
              py::arg("key").none(false),
              "Remove every edge touching key, incoming and outgoing. Returns the "
              "total number removed.")
-        .def("clear_graph", &grove_t::clear_graph,
+        .def("clear_graph",
+             [](grove_t& g) {
+                 pygg::thaw_graph(&g);
+                 g.clear_graph();
+             },
              "Remove all edges from the graph overlay. The keys themselves are "
              "left intact.")
         .def("graph_empty", &grove_t::graph_empty,
@@ -405,6 +556,7 @@ void bind_grove(py::module_& m, const char* grove_name,
              [](grove_t& g, const std::vector<key_t*>& keys,
                 std::function<bool(key_t*, key_t*)> predicate) {
                  // The predicate calls back into Python — keep the GIL held.
+                 pygg::thaw_graph(&g);
                  g.link_if(keys, std::move(predicate));
              },
              py::arg("keys"), py::arg("predicate"),
@@ -433,6 +585,39 @@ void bind_grove(py::module_& m, const char* grove_name,
                  reclaims the dead slots — so it is >= indexed_vertex_count().
              )pbdoc");
 
+    // ---- Bulk edge creation (every grove; columnar metadata on JSON edges) ----
+    bind_bulk_edges<grove_t, key_t, EdgeT>(cls);
+
+    // ---- Graph traversals (every grove; GIL released unless an edge_filter
+    //      calls back into Python) ----
+    bind_graph_traversal<grove_t, key_t, EdgeT>(cls, true);
+
+    // ---- CSR snapshot of the overlay (every grove; the graph mutations above
+    //      and below thaw it) ----
+    bind_frozen_graph<grove_t, key_t, EdgeT>(cls, true);
+
+    // ---- Components / topological order (every grove; GIL released) ----
+    bind_graph_components<grove_t, key_t, EdgeT>(cls, true);
+
+    // ---- Edge export to NumPy / scipy.sparse (every grove) ----
+    bind_edge_export<grove_t, key_t, EdgeT>(cls, true);
+
+    // ---- Batch point lookups (KmerGrove / NumericGrove) ----
+    // Pure C++ once the arrays are read, so the GIL is released for the batch.
+    if constexpr (pygg::batch_lookup_key<KeyT>) {
+        pygg::bind_batch_lookup<KeyT, grove_t>(cls, true);
+    }
+
+    // ---- Overlap-graph construction (genomic_coordinate groves) ----
+    if constexpr (std::is_same_v<KeyT, gdt::genomic_coordinate>) {
+        bind_link_overlaps<grove_t, key_t, EdgeT>(cls);
+    }
+
+    // ---- Range scans (NumericGrove) ----
+    if constexpr (std::is_same_v<KeyT, gdt::numeric>) {
+        pygg::bind_numeric_range<grove_t, key_t>(cls, true);
+    }
+
     // ---- Predicate-filtered edge removal (every grove; #33) ----
     // genogrove's remove_edges_if takes a generic predicate over `const edge&`
     // ({ target, metadata }); we adapt it to a Python callable. The predicate
@@ -441,6 +626,7 @@ void bind_grove(py::module_& m, const char* grove_name,
     if constexpr (std::is_void_v<EdgeT>) {
         cls.def("remove_edges_if",
                 [](grove_t& g, std::function<bool(key_t*)> predicate) {
+                    pygg::thaw_graph(&g);
                     return g.remove_edges_if([&predicate](const auto& e) -> bool {
                         return predicate(e.target);
                     });
@@ -459,6 +645,7 @@ void bind_grove(py::module_& m, const char* grove_name,
         cls.def("remove_edges_if",
                 [](grove_t& g,
                    std::function<bool(key_t*, const EdgeT&)> predicate) {
+                    pygg::thaw_graph(&g);
                     return g.remove_edges_if([&predicate](const auto& e) -> bool {
                         return predicate(e.target, e.metadata);
                     });
@@ -478,7 +665,10 @@ void bind_grove(py::module_& m, const char* grove_name,
     // ---- Key removal + storage compaction ----
     cls.def("remove_key",
             [](grove_t& g, const std::string& index, key_t* key) {
-                return g.remove_key(index, key);
+                pygg::thaw_graph(&g);
+                const bool removed = g.remove_key(index, key);
+                if (removed) pygg::forget_key_handles(&g, key);
+                return removed;
             },
             py::arg("index"), py::arg("key").none(true),
             R"pbdoc(
@@ -491,7 +681,11 @@ void bind_grove(py::module_& m, const char* grove_name,
                 their pointers; only compact() reclaims the slot (and invalidates
                 pointers — see its warning).
             )pbdoc")
-       .def("compact", &grove_t::compact,
+       .def("compact",
+            [](grove_t& g) {
+                pygg::thaw_graph(&g);
+                pygg::compact_with_handles<key_t>(g);
+            },
             R"pbdoc(
                 Reclaim the dead storage slots left by remove_key() (storage
                 shrinks to exactly the live key count).
@@ -500,13 +694,25 @@ void bind_grove(py::module_& m, const char* grove_name,
                 grove's indexed keys (by insert(), insert_bulk(), or yielded from
                 intersect()/flanking()) — they become dangling and must NOT be
                 used afterward (doing so is undefined behaviour). After compact(),
-                re-discover keys via a fresh intersect()/flanking() query. Keys
-                from add_external_key() are NOT affected.
+                re-discover keys via a fresh intersect()/flanking() query, or
+                hold KeyHandles (handle()) instead: compact() moves every live
+                handle to its key's new slot. Keys from add_external_key() are
+                NOT affected.
             )pbdoc");
 
+    // ---- Batch / range removal (edges cleared in one sweep) ----
+    bind_bulk_remove<grove_t, key_t, KeyT>(cls);
+
+    // ---- Stable key handles (survive compact()) ----
+    {
+        static const std::string handle_name = std::string(key_name) + "Handle";
+        bind_key_handles<grove_t, key_t>(m, cls, handle_name.c_str());
+    }
+
     // ---- External (graph-only) key (coordinate + data payload) ----
     {
         auto ext_fn = [](grove_t& g, const KeyT& key, DataT data) {
+            pygg::apply_columns(&g, data);
             return g.add_external_key(key, std::move(data));
         };
         const char* ext_doc = R"pbdoc(
@@ -534,6 +740,8 @@ void bind_grove(py::module_& m, const char* grove_name,
     if constexpr (!std::is_void_v<EdgeT>) {
         cls.def("add_edge",
                 [](grove_t& g, key_t* source, key_t* target, EdgeT data) {
+                    pygg::apply_columns(&g, data);
+                    pygg::thaw_graph(&g);
                     g.add_edge(source, target, std::move(data));
                 },
                 py::arg("source").none(false), py::arg("target").none(false),
@@ -607,7 +815,12 @@ void bind_grove(py::module_& m, const char* grove_name,
                 [](grove_t& g, const std::vector<key_t*>& keys,
                    std::function<std::optional<EdgeT>(key_t*, key_t*)> predicate) {
                     // The predicate calls back into Python — keep the GIL held.
-                    g.link_if(keys, std::move(predicate));
+                    pygg::thaw_graph(&g);
+                    g.link_if(keys, [&](key_t* a, key_t* b) {
+                        auto data = predicate(a, b);
+                        if (data) pygg::apply_columns(&g, *data);
+                        return data;
+                    });
                 },
                 py::arg("keys"), py::arg("predicate"),
                 R"pbdoc(
@@ -620,9 +833,15 @@ void bind_grove(py::module_& m, const char* grove_name,
                 )pbdoc");
     }
 
+    // ---- Interned payload fields and in-place updates (JSON payload groves) ----
+    if constexpr (std::is_same_v<DataT, pygg::json_value>) {
+        bind_interned_fields<grove_t, key_t, KeyT>(cls);
+        bind_payload_update<grove_t, key_t, KeyT>(cls);
+    }
+
     // ---- Serialization (zlib-compressed .gg binary) ----
     cls.def("serialize",
-            [](const grove_t& g, const std::string& path) {
+            [](grove_t& g, const std::string& path) {
                 std::ofstream os(path, std::ios::binary);
                 if (!os) {
                     throw std::runtime_error(
@@ -633,6 +852,20 @@ void bind_grove(py::module_& m, const char* grove_name,
                     throw std::runtime_error(
                         "Failed to write grove to file: " + path);
                 }
+                // Interned fields travel in "<path>.columns"; drop a stale one.
+                if constexpr (std::is_same_v<DataT, pygg::json_value>) {
+                    if (auto cols = pygg::grove_columns(&g)) {
+                        pygg::write_columns(pygg::columns_path(path), *cols);
+                    } else {
+                        std::remove(pygg::columns_path(path).c_str());
+                    }
+                }
+                // So does a freeze_graph() snapshot, in "<path>.csr".
+                if (auto csr = pygg::frozen_graph<key_t, EdgeT>(&g)) {
+                    pygg::write_csr(pygg::csr_path(path), g, *csr);
+                } else {
+                    std::remove(pygg::csr_path(path).c_str());
+                }
             },
             py::arg("path"),
             // File write + zlib touches no Python objects (JSON payloads are
@@ -640,7 +873,10 @@ void bind_grove(py::module_& m, const char* grove_name,
             py::call_guard<py::gil_scoped_release>(),
             R"pbdoc(
                 Serialize the Grove (intervals + associated data + graph overlay)
-                to a zlib-compressed binary file at the given path.
+                to a zlib-compressed binary file at the given path. A grove with
+                interned fields also writes them, with their registry table, to
+                "<path>.columns", and a frozen graph (freeze_graph()) writes its
+                snapshot to "<path>.csr".
             )pbdoc")
        .def("to_sif",
             [](const grove_t& g, const std::string& path) {
@@ -669,20 +905,43 @@ void bind_grove(py::module_& m, const char* grove_name,
             )pbdoc")
        .def_static("deserialize",
             [](const std::string& path) {
-                std::ifstream is(path, std::ios::binary);
-                if (!is) {
-                    throw std::runtime_error(
-                        "Failed to open file for reading: " + path);
+                std::shared_ptr<pygg::payload_columns> cols;
+                std::optional<grove_t> g;
+                {
+                    // File read + zlib + tree rebuild is pure C++ (payloads stay
+                    // encoded strings, decoded lazily on key.data); the returned
+                    // Grove is wrapped after the GIL is reacquired.
+                    py::gil_scoped_release release;
+                    std::ifstream is(path, std::ios::binary);
+                    if (!is) {
+                        throw std::runtime_error(
+                            "Failed to open file for reading: " + path);
+                    }
+                    if constexpr (std::is_same_v<DataT, pygg::json_value>) {
+                        cols = pygg::read_columns(path);
+                    }
+                    // Payloads loaded meanwhile index the grove's columns.
+                    pygg::columns_scope scope(
+                        static_cast<const pygg::payload_columns*>(cols.get()));
+                    g.emplace(grove_t::deserialize(is));
+                }
+                py::object self = py::cast(std::move(*g));
+                auto& loaded = self.cast<grove_t&>();
+                if (cols) {
+                    pygg::grove_columns_table::instance().attach(self, &loaded,
+                                                                 std::move(cols));
                 }
-                return grove_t::deserialize(is);
+                if (auto csr = pygg::read_csr<key_t, EdgeT>(path, loaded)) {
+                    pygg::frozen_graph_table::instance().attach(self, &loaded, std::move(csr));
+                }
+                return self;
             },
             py::arg("path"),
-            // File read + zlib + tree rebuild is pure C++ (payloads stay encoded
-            // strings, decoded lazily on key.data); the returned Grove is wrapped
-            // after the GIL is reacquired.
-            py::call_guard<py::gil_scoped_release>(),
             R"pbdoc(
                 Load a Grove previously written with serialize(). Returns a new
-                Grove with the same intervals, associated data, and graph edges.
+                Grove with the same intervals, associated data, and graph edges
+                (and its interned fields, from "<path>.columns" when present,
+                with a private copy of their registry table; and frozen, when
+                "<path>.csr" holds the snapshot it was serialized with).
             )pbdoc");
 }
\ No newline at end of file
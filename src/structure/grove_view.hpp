@@ -13,15 +13,20 @@
  *
  * The surface is query-only: open / intersect / flanking / get_neighbors (plus,
  * when the edge type is non-void, get_edges / get_edge_list / get_neighbors_if to
- * read edge payloads), the get_order / get_index_names directory accessors, and
- * the blocks_loaded / block_count partial-load counters. There is no insert or
- * serialize — a view never mutates the grove.
+ * read edge payloads; bfs / reachable / shortest_path / k_hop_neighborhood
+ * traversals; the freeze_graph CSR snapshot; connected / strongly connected
+ * components and topological_order; edges_to_numpy / to_csr_matrix export; for
+ * the point keys, contains_many / lookup_many batch lookups; for the numeric
+ * key, range / range_count), the get_order / get_index_names directory
+ * accessors, and the blocks_loaded / block_count partial-load counters. There
+ * is no insert or serialize — a view never mutates the grove.
  */
 #pragma once
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <fstream>
 #include <functional>
 #include <memory>
 #include <string>
@@ -31,8 +36,16 @@
 #include <genogrove/data_type/key.hpp>
 #include <genogrove/structure/grove/grove_view.hpp>
 
+#include "../data_type/json_value.hpp"
 #include "../data_type/key_list.hpp"
+#include "../data_type/payload_columns.hpp"
 #include "../data_type/query_result.hpp"
+#include "batch_lookup.hpp"
+#include "edge_export.hpp"
+#include "frozen_graph.hpp"
+#include "graph_components.hpp"
+#include "graph_traversal.hpp"
+#include "numeric_range.hpp"
 
 namespace py = pybind11;
 namespace ggs = genogrove::structure;
@@ -77,20 +90,44 @@ void bind_grove_view(py::module_& m, const char* view_name) {
         // it.
         .def_static(
             "open",
-            [](const std::string& path, std::streamoff data_offset) {
-                return std::unique_ptr<view_t>(
-                    new view_t(view_t::open(path, data_offset)));
+            [](const std::string& path, std::streamoff data_offset, bool frozen) {
+                py::object self = py::cast(std::unique_ptr<view_t>(
+                    new view_t(view_t::open(path, data_offset))));
+                if constexpr (std::is_same_v<DataT, pygg::json_value>) {
+                    // Interned fields: attached like Grove.deserialize() does;
+                    // each paging call below runs in a columns_scope.
+                    if (auto cols = pygg::read_columns(path)) {
+                        pygg::grove_columns_table::instance().attach(
+                            self, &self.cast<view_t&>(), std::move(cols));
+                    }
+                }
+                // A serialized freeze_graph() snapshot, on request: read by the
+                // first graph access, not here.
+                if (frozen && std::ifstream(pygg::csr_path(path), std::ios::binary)) {
+                    pygg::deferred_csr_table::instance().attach(
+                        self, &self.cast<view_t&>(),
+                        std::make_shared<pygg::deferred_csr>(pygg::deferred_csr{path, nullptr}));
+                }
+                return self;
             },
-            py::arg("path"), py::arg("data_offset") = 0,
+            py::arg("path"), py::arg("data_offset") = 0, py::arg("frozen") = false,
             R"pbdoc(
-                open(path, data_offset=0) -> GroveView
+                open(path, data_offset=0, frozen=False) -> GroveView
 
                 Open a serialized grove for partial reading. `path` is a file
                 written by Grove.serialize() (a bare grove stream; data_offset=0).
                 Pass a non-zero data_offset only for a .gg embedded after a
                 leading header (e.g. a genogrove CLI index). Raises RuntimeError
                 if the file cannot be opened, the magic is wrong, the source is
-                not seekable, or the directory is malformed.
+                not seekable, or the directory is malformed. Interned payload
+                fields are read from "<path>.columns", as Grove.deserialize()
+                does; without that file they read as their integer ids. With
+                frozen=True and a frozen graph in "<path>.csr", the view opens
+                frozen; the snapshot is read on the first graph call
+                (get_neighbors, a traversal, graph_frozen()), which resolves
+                its vertices with one in-order read of each index they lie in
+                (genomic and numeric views). By default the file is ignored and
+                open() reads only the block directory.
             )pbdoc")
 
         // keep_alive<0, 1>: the returned QueryResult (and the Keys it yields)
@@ -99,7 +136,10 @@ void bind_grove_view(py::module_& m, const char* view_name) {
         // and the view is not thread-safe, so the GIL stays held.
         .def(
             "intersect",
-            [](view_t& v, const KeyT& query) { return v.intersect(query); },
+            [](view_t& v, const KeyT& query) {
+                pygg::columns_scope scope(&v);
+                return v.intersect(query);
+            },
             py::arg("query"), py::keep_alive<0, 1>(),
             R"pbdoc(
                 Find all intervals overlapping the query across all indices,
@@ -108,6 +148,7 @@ void bind_grove_view(py::module_& m, const char* view_name) {
         .def(
             "intersect",
             [](view_t& v, const KeyT& query, std::string_view index) {
+                pygg::columns_scope scope(&v);
                 return v.intersect(query, index);
             },
             py::arg("query"), py::arg("index"), py::keep_alive<0, 1>(),
@@ -124,7 +165,8 @@ void bind_grove_view(py::module_& m, const char* view_name) {
                 // after the list is dropped — issue #37. Loads each target's
                 // block on demand (the cross-chromosome hop).
                 return pinned_key_list(
-                    self.cast<view_t&>().get_neighbors(source), self);
+                    pygg::neighbors_of<key_t, EdgeT>(self.cast<view_t&>(), source),
+                    self);
             },
             py::arg("source").none(false),
             R"pbdoc(
@@ -144,6 +186,7 @@ void bind_grove_view(py::module_& m, const char* view_name) {
         .def(
             "flanking",
             [](view_t& v, const KeyT& query, std::string_view index) {
+                pygg::columns_scope scope(&v);
                 return v.flanking(query, index);
             },
             py::arg("query"), py::arg("index"), py::keep_alive<0, 1>(),
@@ -164,6 +207,7 @@ void bind_grove_view(py::module_& m, const char* view_name) {
                std::function<bool(const KeyT&, const KeyT&)> is_compatible) {
                 // The predicate calls back into Python, so the GIL must be held
                 // for the whole query — do NOT release it here.
+                pygg::columns_scope scope(&v);
                 return v.flanking(query, index, std::move(is_compatible));
             },
             py::arg("query"), py::arg("index"), py::arg("is_compatible"),
@@ -203,6 +247,29 @@ void bind_grove_view(py::module_& m, const char* view_name) {
                 nothing extra (the directory is already loaded by open()).
             )pbdoc");
 
+    // ---- Graph traversals (GIL held; targets are paged in on demand) ----
+    bind_graph_traversal<view_t, key_t, EdgeT>(cls, false);
+
+    // ---- CSR snapshot (pages the frozen closure in once; the GIL stays held) ----
+    bind_frozen_graph<view_t, key_t, EdgeT>(cls, false);
+
+    // ---- Components / topological order (graph built with the GIL held) ----
+    bind_graph_components<view_t, key_t, EdgeT>(cls, false);
+
+    // ---- Edge export (the closure is paged in with the GIL held) ----
+    bind_edge_export<view_t, key_t, EdgeT>(cls, false);
+
+    // ---- Batch point lookups (KmerGroveView / NumericGroveView) ----
+    // The GIL stays held: each lookup may page blocks into the view's cache.
+    if constexpr (pygg::batch_lookup_key<KeyT>) {
+        pygg::bind_batch_lookup<KeyT, view_t>(cls, false);
+    }
+
+    // ---- Range scans (NumericGroveView; GIL held, like every view query) ----
+    if constexpr (std::is_same_v<KeyT, gdt::numeric>) {
+        pygg::bind_numeric_range<view_t, key_t>(cls, false);
+    }
+
     // ---- Labelled-edge reads (only when the edge type is non-void; on the
     //      universal GroveView the metadata is any JSON-serializable value).
     //      Mirrors the same methods on the mutable Grove, but query-only: a view
@@ -232,7 +299,9 @@ void bind_grove_view(py::module_& m, const char* view_name) {
                 // unlike the metadata-only get_edges. Pin each target Key to the
                 // view so it can't dangle after the list is dropped — issue #37.
                 py::list out;
-                for (auto& e : self.cast<view_t&>().get_edge_list(source)) {
+                auto& v = self.cast<view_t&>();
+                pygg::columns_scope scope(&v);
+                for (auto& e : v.get_edge_list(source)) {
                     out.append(py::make_tuple(
                         py::cast(e.first,
                                  py::return_value_policy::reference_internal,
@@ -259,10 +328,10 @@ void bind_grove_view(py::module_& m, const char* view_name) {
                 // each Key to the view so an extracted neighbor can't dangle
                 // after the list is dropped — issue #37. Resolves each surviving
                 // target's block on demand, like get_neighbors.
-                return pinned_key_list(
-                    self.cast<view_t&>().get_neighbors_if(source,
-                                                          std::move(predicate)),
-                    self);
+                auto& v = self.cast<view_t&>();
+                pygg::columns_scope scope(&v);
+                return pinned_key_list(v.get_neighbors_if(source, std::move(predicate)),
+                                       self);
             },
             py::arg("source").none(false), py::arg("predicate"),
             R"pbdoc(
@@ -0,0 +1,94 @@
+/*
+ * index_keys — every key of one index (or of every index) of a grove or view,
+ * in index order: what freeze_graph, the components and the edge export run
+ * over when no keys are given.
+ *
+ * A grove walks each index's leaf chain (index_walk.hpp). A view pages the
+ * index in, block by block in leaf order: a whole-index '*' intersect on the
+ * genomic_coordinate views (as link_overlaps reads an index), a full-range
+ * scan on NumericGroveView (numeric_range.hpp). A k-mer's overlap is exact
+ * equality and no query spans a KmerGroveView's keys, so it cannot enumerate
+ * an index and raises; pass keys there.
+ */
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <genogrove/data_type/genomic_coordinate.hpp>
+#include <genogrove/data_type/kmer.hpp>
+#include <genogrove/data_type/numeric.hpp>
+
+#include "../data_type/payload_columns.hpp"
+#include "index_walk.hpp"
+#include "numeric_range.hpp"
+
+namespace gdt = genogrove::data_type;
+
+namespace pygg {
+
+template <typename key_t>
+using key_value_t = std::decay_t<decltype(std::declval<const key_t&>().get_value())>;
+
+// Whether for_each_owner_key can enumerate an index of Owner.
+template <typename key_t, typename Owner>
+inline constexpr bool can_enumerate =
+    has_leaf_chain<Owner> || std::is_same_v<key_value_t<key_t>, gdt::genomic_coordinate> ||
+    std::is_same_v<key_value_t<key_t>, gdt::numeric>;
+
+// Every index name of a grove or view, sorted.
+template <typename Owner>
+std::vector<std::string> owner_index_names(Owner& owner) {
+    if constexpr (has_leaf_chain<Owner>) {
+        return index_names(owner);
+    } else {
+        std::vector<std::string> out;
+        for (auto&& name : owner.get_index_names()) out.emplace_back(name);
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+}
+
+// fn(key*) for every key of `index`, in index order.
+template <typename key_t, typename Owner, typename Fn>
+void for_each_owner_key(Owner& owner, const std::string& index, Fn&& fn) {
+    using value_t = key_value_t<key_t>;
+    if constexpr (!can_enumerate<key_t, Owner>) {
+        throw std::invalid_argument(
+            "this view cannot enumerate an index; pass keys explicitly");
+    } else if constexpr (has_leaf_chain<Owner>) {
+        for_each_index_key(owner, index, fn);
+    } else if constexpr (std::is_same_v<value_t, gdt::genomic_coordinate>) {
+        columns_scope scope(&owner);
+        const gdt::genomic_coordinate everything('*', 0, std::numeric_limits<std::size_t>::max());
+        auto hits = owner.intersect(everything, index);
+        for (auto* key : hits.get_keys()) fn(key);
+    } else {
+        numeric_range_scan(owner, INT_MIN, INT_MAX, index, fn);
+    }
+}
+
+// The keys of `index`, or of every index when it is nullopt, in index order
+// (indices sorted by name).
+template <typename key_t, typename Owner>
+std::vector<key_t*> index_keys(Owner& owner, const std::optional<std::string>& index) {
+    std::vector<key_t*> out;
+    auto push = [&out](key_t* key) { out.push_back(key); };
+    if (index) {
+        for_each_owner_key<key_t>(owner, *index, push);
+        return out;
+    }
+    for (const auto& name : owner_index_names(owner)) {
+        for_each_owner_key<key_t>(owner, name, push);
+    }
+    return out;
+}
+
+}  // namespace pygg
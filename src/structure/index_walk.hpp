@@ -0,0 +1,109 @@
+/*
+ * Ordered walks over the indices of an in-memory grove. genogrove links each
+ * index's B+ tree leaves left to right (the `leaflink` lines grove_to_sif
+ * writes), so an ordered scan costs one descent to its first leaf and then
+ * follows node::get_next() — no per-key or per-value descents. The descent
+ * binary-searches each level's children by their last key, so it needs only
+ * the leaves' order, not how internal keys summarize a subtree.
+ *
+ * grove_views page blocks and have no node access, so they keep to intersect /
+ * flanking; has_leaf_chain tells the two apart at compile time.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace pygg {
+
+template <typename Owner>
+concept has_leaf_chain = requires(Owner& g) { g.get_root_nodes(); };
+
+template <typename T>
+T* raw_ptr(T* p) { return p; }
+template <typename P>
+auto* raw_ptr(const P& p) { return p.get(); }  // smart-pointer nodes
+
+template <typename K>
+K* as_key_ptr(K* k) { return k; }
+template <typename K>
+K* as_key_ptr(K& k) { return &k; }
+
+// The root node of `index`, or null when the grove has no such index.
+template <typename grove_t>
+auto index_root(grove_t& g, const std::string& index) {
+    auto&& roots = g.get_root_nodes();
+    auto it = roots.find(index);
+    using node_t = std::remove_reference_t<decltype(*raw_ptr(it->second))>;
+    return it == roots.end() ? static_cast<node_t*>(nullptr) : raw_ptr(it->second);
+}
+
+// Every index name of the grove, sorted.
+template <typename grove_t>
+std::vector<std::string> index_names(grove_t& g) {
+    std::vector<std::string> out;
+    for (auto&& entry : g.get_root_nodes()) out.push_back(entry.first);
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// The leftmost leaf that can hold a key with !before(key); `before` must hold
+// for a prefix of the index's keys in leaf order.
+template <typename Node, typename Before>
+Node* leaf_from(Node* n, Before&& before) {
+    auto last_key = [](Node* c) {
+        while (!c->get_is_leaf()) c = raw_ptr(c->get_children().back());
+        auto& keys = c->get_keys();
+        return keys.empty() ? nullptr : as_key_ptr(keys.back());
+    };
+    while (n && !n->get_is_leaf()) {
+        auto& children = n->get_children();
+        std::size_t lo = 0, hi = children.size() - 1;
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            auto* k = last_key(raw_ptr(children[mid]));
+            if (!k || before(*k)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        n = raw_ptr(children[lo]);
+    }
+    return n;
+}
+
+// fn(key*) -> bool for the keys of `index` in leaf order, starting at the first
+// with !before(key), until fn returns false.
+template <typename grove_t, typename Before, typename Fn>
+void walk_index(grove_t& g, const std::string& index, Before&& before, Fn&& fn) {
+    bool skipping = true;
+    for (auto* leaf = leaf_from(index_root(g, index), before); leaf;
+         leaf = raw_ptr(leaf->get_next())) {
+        for (auto&& k : leaf->get_keys()) {
+            auto* key = as_key_ptr(k);
+            if (skipping) {
+                if (before(*key)) continue;
+                skipping = false;
+            }
+            if (!fn(key)) return;
+        }
+    }
+}
+
+// fn(key*) for every key of `index`, in order.
+template <typename grove_t, typename Fn>
+void for_each_index_key(grove_t& g, const std::string& index, Fn&& fn) {
+    walk_index(
+        g, index, [](const auto&) { return false; },
+        [&fn](auto* key) {
+            fn(key);
+            return true;
+        });
+}
+
+}  // namespace pygg
@@ -0,0 +1,126 @@
+/*
+ * Interned payload fields on the JSON-payload groves (Grove, NumericGrove,
+ * KmerGrove): intern_fields() declares the fields, interned_fields /
+ * interned_registry report them, and intersect_where() filters a query's hits
+ * on a field by comparing stored registry ids — read from each hit's payload
+ * header by position, so the payload is neither scanned nor decoded.
+ * The encoding itself (and its expansion on key.data) is in
+ * data_type/payload_columns.hpp; insert / edge / serialization paths of
+ * bind_grove apply it.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "../data_type/key_list.hpp"
+#include "../data_type/payload_columns.hpp"
+#include "../data_type/registry.hpp"
+
+namespace py = pybind11;
+
+template <typename grove_t, typename key_t, typename KeyT, typename Class>
+void bind_interned_fields(Class& cls) {
+    cls.def(
+        "intern_fields",
+        [](py::object self, std::vector<std::string> fields,
+           std::shared_ptr<pygg::string_registry> registry) {
+            auto& g = self.cast<grove_t&>();
+            if (g.vertex_count() != 0 || g.edge_count() != 0) {
+                throw std::invalid_argument(
+                    "intern_fields() must be called on an empty grove");
+            }
+            if (fields.empty()) throw std::invalid_argument("no fields given");
+            auto sorted = fields;
+            std::sort(sorted.begin(), sorted.end());
+            if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+                throw std::invalid_argument("duplicate interned field");
+            }
+            std::shared_ptr<const pygg::payload_columns> declared =
+                pygg::columns_directory::instance().make(
+                    std::move(fields),
+                    registry ? std::move(registry) : std::make_shared<pygg::string_registry>());
+            if (pygg::grove_columns_table::instance().try_attach(self, &g, declared) !=
+                declared) {
+                throw std::invalid_argument("interned fields are already declared");
+            }
+        },
+        py::arg("fields"), py::arg("registry") = py::none(),
+        R"pbdoc(
+            intern_fields(fields, registry=None) -> None
+
+            Declare top-level payload fields (e.g. ["gene_id", "biotype"]) whose
+            str values are interned through `registry` (default: a new private
+            Registry). Every payload and edge metadata inserted afterwards stores
+            those fields' registry ids, as decimal integers in the payload's JSON
+            text (in memory and in the .gg, which stays plain JSON), instead of
+            the strings; key.data and edge metadata expand them back. Field
+            values must be str or None. Call once, on an empty grove.
+        )pbdoc");
+    cls.def_property_readonly(
+        "interned_fields",
+        [](const grove_t& g) {
+            auto cols = pygg::grove_columns(&g);
+            return cols ? cols->fields : std::vector<std::string>{};
+        },
+        "The payload fields declared with intern_fields() (empty if none).");
+    cls.def_property_readonly(
+        "interned_registry",
+        [](const grove_t& g) -> std::shared_ptr<pygg::string_registry> {
+            auto cols = pygg::grove_columns(&g);
+            return cols ? cols->registry : nullptr;
+        },
+        "The Registry holding the interned field values, or None.");
+    cls.def(
+        "intersect_where",
+        [](py::object self, const KeyT& query, std::string_view index,
+           const std::string& field, py::object values) {
+            auto& g = self.cast<grove_t&>();
+            auto cols = pygg::grove_columns(&g);
+            const int slot = cols ? cols->slot(field) : -1;
+            if (slot < 0) {
+                throw std::invalid_argument("'" + field + "' is not an interned field");
+            }
+            std::vector<std::string> wanted;
+            if (py::isinstance<py::str>(values)) {
+                wanted.push_back(values.cast<std::string>());
+            } else {
+                wanted = values.cast<std::vector<std::string>>();
+            }
+            std::unordered_set<pygg::string_registry::id_type> ids;
+            for (const auto& v : wanted) {
+                if (auto id = cols->registry->find(v)) ids.insert(*id);
+            }
+            std::vector<key_t*> keys;
+            if (!ids.empty()) {
+                py::gil_scoped_release release;
+                auto hits = g.intersect(query, index);
+                for (auto* key : hits.get_keys()) {
+                    auto id = pygg::column_id(*cols, key->get_data(),
+                                              static_cast<std::size_t>(slot));
+                    if (id && ids.count(*id)) keys.push_back(key);
+                }
+            }
+            return pinned_key_list(keys, self);
+        },
+        py::arg("query"), py::arg("index"), py::arg("field"), py::arg("values"),
+        R"pbdoc(
+            intersect_where(query, index, field, values) -> list[Key]
+
+            The keys of intersect(query, index) whose interned `field` equals
+            `values` (a str) or one of them (a list of str). The values are
+            resolved to registry ids once; each hit's id is read from the
+            fixed-position header of its stored payload and compared as an
+            integer, without scanning or decoding the payload. Raises
+            ValueError when `field` was not declared with intern_fields().
+        )pbdoc");
+}
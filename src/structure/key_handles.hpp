@@ -0,0 +1,246 @@
+/*
+ * Stable key handles — Grove.handle(key, index) returns a KeyHandle that stays
+ * valid across compact(), unlike a Key, which points straight into grove
+ * storage and dangles once compact() moves the slots.
+ *
+ * A handle is a shared record (key pointer, index, generation) that the grove's
+ * handle registry also tracks. genogrove's compact() does not report where the
+ * keys went, so the Grove.compact() binding remaps them around the call: before
+ * it, each handle records its key's value and ordinal among the equal-valued
+ * hits of intersect(value, index) — compaction moves storage, not tree order;
+ * after it, the same query and ordinal give the key's new address, and the
+ * registry's generation advances. handle() therefore only accepts a key that
+ * query finds, and for index=None only a key no index holds. remove_key()
+ * clears the handles of the removed key. Accessing a handle checks it against
+ * the registry's generation, so a handle that was not remapped raises instead
+ * of dangling.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../data_type/side_table.hpp"
+#include "index_walk.hpp"
+
+namespace py = pybind11;
+
+namespace pygg {
+
+template <typename key_t>
+struct key_handle {
+    py::object grove;                  // keeps the grove (and its storage) alive
+    key_t* key = nullptr;              // null once the key is removed
+    std::optional<std::string> index;  // nullopt: an external (graph-only) key
+    uint64_t generation = 0;           // registry generation `key` is valid for
+};
+
+// The handles of one grove, by current key address.
+template <typename key_t>
+class key_handle_registry {
+  public:
+    using handle_t = key_handle<key_t>;
+    using value_t = std::decay_t<decltype(std::declval<const key_t&>().get_value())>;
+
+    uint64_t generation() const { return generation_; }
+
+    std::shared_ptr<handle_t> make(py::object grove, key_t* key, std::optional<std::string> index) {
+        auto h = std::make_shared<handle_t>();
+        h->grove = std::move(grove);
+        h->key = key;
+        h->index = std::move(index);
+        h->generation = generation_;
+        std::lock_guard<std::mutex> lock(mu_);
+        handles_.emplace(key, h);
+        return h;
+    }
+
+    // The key at `key` was removed: its handles no longer resolve.
+    void forget(const key_t* key) {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto [first, last] = handles_.equal_range(key);
+        for (auto it = first; it != last; ++it) {
+            if (auto h = it->second.lock()) h->key = nullptr;
+        }
+        handles_.erase(first, last);
+    }
+
+    // Run compact() and move every live handle to its key's new address.
+    template <typename grove_t, typename Compact>
+    void compact(grove_t& g, Compact&& compact_storage) {
+        struct moved {
+            std::shared_ptr<handle_t> handle;
+            std::optional<value_t> value;
+            std::size_t ordinal = 0;
+        };
+        std::vector<moved> live;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            for (auto& [key, weak] : handles_) {
+                auto h = weak.lock();
+                if (!h || !h->key) continue;
+                moved m{h, std::nullopt, 0};
+                if (h->index) {
+                    m.value.emplace(h->key->get_value());
+                    auto hits = g.intersect(*m.value, *h->index);
+                    for (auto* k : hits.get_keys()) {
+                        if (k == h->key) break;
+                        if (k->get_value() == *m.value) ++m.ordinal;
+                    }
+                }
+                live.push_back(std::move(m));
+            }
+        }
+        compact_storage();
+        std::lock_guard<std::mutex> lock(mu_);
+        handles_.clear();
+        ++generation_;
+        for (auto& m : live) {
+            auto& h = *m.handle;
+            if (m.value) {  // external keys are not moved by compact()
+                key_t* found = nullptr;
+                std::size_t seen = 0;
+                auto hits = g.intersect(*m.value, *h.index);
+                for (auto* k : hits.get_keys()) {
+                    if (!(k->get_value() == *m.value)) continue;
+                    if (seen++ == m.ordinal) {
+                        found = k;
+                        break;
+                    }
+                }
+                h.key = found;
+            }
+            h.generation = generation_;
+            if (h.key) handles_.emplace(h.key, m.handle);
+        }
+    }
+
+  private:
+    std::mutex mu_;
+    std::unordered_multimap<const key_t*, std::weak_ptr<handle_t>> handles_;
+    uint64_t generation_ = 0;
+};
+
+// One registry per grove object, created on first use and dropped with it.
+using key_handle_table = object_side_table<void, struct key_handles_tag>;
+
+template <typename key_t>
+std::shared_ptr<key_handle_registry<key_t>> key_handles(const void* grove) {
+    return std::static_pointer_cast<key_handle_registry<key_t>>(
+        key_handle_table::instance().find(grove));
+}
+
+template <typename key_t>
+std::shared_ptr<key_handle_registry<key_t>> key_handles_for(py::handle self, const void* grove) {
+    if (auto registry = key_handles<key_t>(grove)) return registry;
+    return std::static_pointer_cast<key_handle_registry<key_t>>(
+        key_handle_table::instance().try_attach(self, grove,
+                                                std::make_shared<key_handle_registry<key_t>>()));
+}
+
+// Whether `key` is one of the keys of `index` (found through its own value).
+template <typename grove_t, typename key_t>
+bool key_in_index(grove_t& g, const key_t* key, const std::string& index) {
+    const auto names = index_names(g);
+    if (!std::binary_search(names.begin(), names.end(), index)) return false;
+    auto hits = g.intersect(key->get_value(), index);
+    for (auto* k : hits.get_keys()) {
+        if (k == key) return true;
+    }
+    return false;
+}
+
+// Called after a key leaves the grove (remove_key and friends).
+template <typename key_t>
+void forget_key_handles(const void* grove, const key_t* key) {
+    if (auto registry = key_handles<key_t>(grove)) registry->forget(key);
+}
+
+// grove.compact(), moving the grove's live KeyHandles to their keys' new slots.
+template <typename key_t, typename grove_t>
+void compact_with_handles(grove_t& g) {
+    if (auto registry = key_handles<key_t>(&g)) {
+        registry->compact(g, [&g] { g.compact(); });
+    } else {
+        g.compact();
+    }
+}
+
+}  // namespace pygg
+
+template <typename grove_t, typename key_t, typename Class>
+void bind_key_handles(py::module_& m, Class& cls, const char* handle_name) {
+    using handle_t = pygg::key_handle<key_t>;
+
+    py::class_<handle_t, std::shared_ptr<handle_t>>(m, handle_name, R"pbdoc(
+        A stable reference to a key of a grove, returned by Grove.handle(). Unlike
+        a Key, it survives compact(): the grove moves every live handle to its
+        key's new storage slot. Resolve it to a Key with .key whenever needed, and
+        keep the handle, not the Key, across compactions.
+    )pbdoc")
+        .def_property_readonly(
+            "key",
+            [](const handle_t& h) {
+                auto registry = pygg::key_handles<key_t>(&h.grove.cast<const grove_t&>());
+                if (!h.key) throw std::invalid_argument("the key was removed from the grove");
+                if (!registry || registry->generation() != h.generation) {
+                    throw std::invalid_argument("stale key handle");
+                }
+                return py::cast(h.key, py::return_value_policy::reference_internal, h.grove);
+            },
+            "The Key this handle refers to now. Raises ValueError when the key has "
+            "been removed.")
+        .def_property_readonly(
+            "valid", [](const handle_t& h) { return h.key != nullptr; },
+            "False once the key has been removed from the grove.")
+        .def_property_readonly(
+            "index", [](const handle_t& h) { return h.index; },
+            "The index the key lives in (None for an external key).")
+        .def("__repr__", [handle_name](const handle_t& h) {
+            return std::string(handle_name) + "(" +
+                   (h.key ? h.key->to_string() : std::string("removed")) + ")";
+        });
+
+    cls.def(
+        "handle",
+        [](py::object self, key_t* key, std::optional<std::string> index) {
+            auto& g = self.cast<grove_t&>();
+            if (index) {
+                if (!pygg::key_in_index(g, key, *index)) {
+                    throw std::invalid_argument("key is not in index '" + *index + "'");
+                }
+            } else {
+                for (const auto& name : pygg::index_names(g)) {
+                    if (pygg::key_in_index(g, key, name)) {
+                        throw std::invalid_argument("key is in index '" + name +
+                                                    "'; pass it as handle(key, index)");
+                    }
+                }
+            }
+            return pygg::key_handles_for<key_t>(self, &g)->make(self, key, std::move(index));
+        },
+        py::arg("key").none(false), py::arg("index") = py::none(),
+        R"pbdoc(
+            handle(key, index=None) -> KeyHandle
+
+            A stable handle to `key`, which lives in `index` (None for a key
+            from add_external_key()). The handle stays valid across compact(),
+            and handle.key gives the key's current Key. Keys sharing an index
+            and key value are told apart by their order in the index. Raises
+            ValueError when `key` is not in `index`, or with index=None when it
+            is indexed at all.
+        )pbdoc");
+}
@@ -0,0 +1,510 @@
+/*
+ * KmerCounter — multi-threaded k-mer occurrence counting over FASTA/FASTQ
+ * input. KmerGrove stores membership with one payload per key; counting through
+ * it from Python (read the JSON count, write it back) is a lookup and a
+ * re-encode per k-mer. The counter keeps counts in C++ hash tables and only
+ * materializes them at the end — as NumPy arrays, or bulk-built into a
+ * KmerGrove / NumericGrove whose payload is the count.
+ *
+ * The key space is hash-partitioned, one partition (an open-addressing table)
+ * per worker thread. The calling thread reads the source and hands batches of
+ * stretches to the workers; a worker encodes its batch, routes each k-mer to the
+ * owning partition's inbox, and drains its own inbox into its table — so every
+ * table has exactly one writer and no table is ever locked. Partitions hold
+ * disjoint k-mers, so export just concatenates them and sorts once.
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <genogrove/data_type/kmer.hpp>
+#include <genogrove/data_type/numeric.hpp>
+#include <genogrove/structure/grove/grove.hpp>
+
+#include "../data_type/json_value.hpp"
+#include "../data_type/packed_sequence.hpp"
+#include "../io/kmer_source.hpp"
+
+namespace py = pybind11;
+namespace ggs = genogrove::structure;
+namespace gdt = genogrove::data_type;
+
+namespace pygg {
+
+// Linear-probing encoding -> count table. ~0 marks an empty slot, so the one
+// k-mer whose encoding is ~0 (k = 32 all-T, non-canonical) is counted aside.
+class kmer_count_table {
+public:
+    void add(uint64_t enc, uint64_t n = 1) {
+        if (enc == empty) {
+            if (!all_ones_) ++size_;
+            all_ones_ += n;
+            return;
+        }
+        if ((size_ + 1) * 10 > keys_.size() * 7) grow();
+        std::size_t i = kmer_hash(enc) & mask_;
+        while (keys_[i] != empty && keys_[i] != enc) i = (i + 1) & mask_;
+        if (keys_[i] == empty) {
+            keys_[i] = enc;
+            ++size_;
+        }
+        counts_[i] += n;
+    }
+
+    uint64_t get(uint64_t enc) const {
+        if (enc == empty) return all_ones_;
+        if (keys_.empty()) return 0;
+        std::size_t i = kmer_hash(enc) & mask_;
+        while (keys_[i] != empty) {
+            if (keys_[i] == enc) return counts_[i];
+            i = (i + 1) & mask_;
+        }
+        return 0;
+    }
+
+    // fn(encoding, count) for every stored k-mer, in table order.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (std::size_t i = 0; i < keys_.size(); ++i) {
+            if (keys_[i] != empty) fn(keys_[i], counts_[i]);
+        }
+        if (all_ones_) fn(empty, all_ones_);
+    }
+
+    std::size_t size() const { return size_; }
+
+    void clear() {
+        keys_.clear();
+        counts_.clear();
+        mask_ = 0;
+        size_ = 0;
+        all_ones_ = 0;
+    }
+
+private:
+    static constexpr uint64_t empty = ~uint64_t{0};
+
+    void grow() {
+        std::vector<uint64_t> keys = std::move(keys_);
+        std::vector<uint64_t> counts = std::move(counts_);
+        const std::size_t cap = keys.empty() ? 1024 : keys.size() * 2;
+        keys_.assign(cap, empty);
+        counts_.assign(cap, 0);
+        mask_ = cap - 1;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] == empty) continue;
+            std::size_t j = kmer_hash(keys[i]) & mask_;
+            while (keys_[j] != empty) j = (j + 1) & mask_;
+            keys_[j] = keys[i];
+            counts_[j] = counts[i];
+        }
+    }
+
+    std::vector<uint64_t> keys_;
+    std::vector<uint64_t> counts_;
+    std::size_t mask_ = 0;
+    std::size_t size_ = 0;
+    uint64_t all_ones_ = 0;
+};
+
+class kmer_counter {
+public:
+    kmer_counter(unsigned k, bool canonical, unsigned threads)
+        : k_(k), canonical_(canonical), parts_(resolve_threads(threads)) {
+        check_kmer_k(k);
+    }
+
+    unsigned k() const { return k_; }
+    bool canonical() const { return canonical_; }
+    unsigned threads() const { return static_cast<unsigned>(parts_.size()); }
+    uint64_t total() const { return total_; }
+
+    std::size_t distinct() const {
+        std::size_t n = 0;
+        for (const auto& p : parts_) n += p.size();
+        return n;
+    }
+
+    // Count every k-mer of `seq`; returns the number of k-mers counted.
+    uint64_t add_sequence(std::string_view seq) {
+        uint64_t n = 0;
+        for_each_kmer_ascii(seq, k_, canonical_, 1, [&](std::size_t, uint64_t enc) {
+            parts_[part_of(enc)].add(enc);
+            ++n;
+        });
+        total_ += n;
+        return n;
+    }
+
+    // Drain a reader into the tables; returns the number of k-mers counted.
+    uint64_t add_reader(fasta_reader_handle& reader, unsigned min_quality) {
+        if (parts_.size() == 1) {
+            uint64_t n = 0;
+            for_each_reader_stretch(
+                reader, k_,
+                [&](std::string_view seq, std::size_t) { n += add_sequence(seq); },
+                min_quality);
+            return n;
+        }
+        return add_reader_parallel(reader, min_quality);
+    }
+
+    // The count of one k-mer, given as bases (canonicalized like the input).
+    uint64_t count(std::string_view bases) const {
+        if (bases.size() != k_) {
+            throw std::invalid_argument("k-mer length " + std::to_string(bases.size()) +
+                                        " does not match k=" + std::to_string(k_));
+        }
+        uint64_t result = 0;
+        bool valid = false;
+        for_each_kmer_ascii(bases, k_, canonical_, 1, [&](std::size_t, uint64_t enc) {
+            result = parts_[part_of(enc)].get(enc);
+            valid = true;
+        });
+        if (!valid) throw std::invalid_argument("k-mer contains a non-ACGT base");
+        return result;
+    }
+
+    // Encodings (ascending) and counts of every k-mer seen >= min_count times.
+    void export_sorted(uint64_t min_count, std::vector<uint64_t>& enc,
+                       std::vector<uint64_t>& counts) const {
+        std::vector<std::pair<uint64_t, uint64_t>> all;
+        all.reserve(distinct());
+        for (const auto& p : parts_) {
+            p.for_each([&](uint64_t e, uint64_t c) {
+                if (c >= min_count) all.emplace_back(e, c);
+            });
+        }
+        std::sort(all.begin(), all.end());
+        enc.resize(all.size());
+        counts.resize(all.size());
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            enc[i] = all[i].first;
+            counts[i] = all[i].second;
+        }
+    }
+
+    void clear() {
+        for (auto& p : parts_) p.clear();
+        total_ = 0;
+    }
+
+private:
+    // Stretches handed to one worker at a time, and the k-mers a worker routes
+    // to another partition before flushing them to its inbox.
+    static constexpr std::size_t batch_bases = std::size_t{1} << 20;
+    static constexpr std::size_t route_flush = std::size_t{1} << 14;
+
+    std::size_t part_of(uint64_t enc) const {
+        // High hash bits pick the partition; the table probes with the low ones.
+        return static_cast<std::size_t>(
+            ((kmer_hash(enc) >> 32) * parts_.size()) >> 32);
+    }
+
+    uint64_t add_reader_parallel(fasta_reader_handle& reader, unsigned min_quality) {
+        const std::size_t nparts = parts_.size();
+
+        struct inbox {
+            std::mutex mu;
+            std::vector<std::vector<uint64_t>> blocks;
+        };
+        std::vector<inbox> inboxes(nparts);
+        auto drain = [&](std::size_t p) {
+            std::vector<std::vector<uint64_t>> blocks;
+            {
+                std::lock_guard<std::mutex> lock(inboxes[p].mu);
+                blocks.swap(inboxes[p].blocks);
+            }
+            for (const auto& b : blocks) {
+                for (uint64_t e : b) parts_[p].add(e);
+            }
+        };
+
+        std::mutex mu;
+        std::condition_variable ready, space;
+        std::deque<std::vector<std::string>> work;
+        bool done = false;
+        std::exception_ptr error;
+        std::vector<uint64_t> counted(nparts, 0);
+        struct stop_feeding {};  // a worker failed: stop reading the source
+
+        auto worker = [&](std::size_t self) {
+            std::vector<std::vector<uint64_t>> out(nparts);
+            auto flush = [&](std::size_t p) {
+                if (out[p].empty()) return;
+                std::lock_guard<std::mutex> lock(inboxes[p].mu);
+                inboxes[p].blocks.push_back(std::move(out[p]));
+                out[p].clear();
+            };
+            uint64_t n = 0;
+            try {
+                for (;;) {
+                    std::vector<std::string> batch;
+                    {
+                        std::unique_lock<std::mutex> lock(mu);
+                        ready.wait(lock, [&] { return done || !work.empty(); });
+                        if (work.empty()) break;
+                        batch = std::move(work.front());
+                        work.pop_front();
+                    }
+                    space.notify_one();
+                    for (const auto& seq : batch) {
+                        for_each_kmer_ascii(seq, k_, canonical_, 1,
+                                            [&](std::size_t, uint64_t enc) {
+                                                const std::size_t p = part_of(enc);
+                                                out[p].push_back(enc);
+                                                if (out[p].size() >= route_flush) flush(p);
+                                                ++n;
+                                            });
+                    }
+                    drain(self);
+                }
+                for (std::size_t p = 0; p < nparts; ++p) flush(p);
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(mu);
+                    if (!error) error = std::current_exception();
+                    done = true;
+                    work.clear();
+                }
+                ready.notify_all();
+                space.notify_all();
+            }
+            counted[self] = n;
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < nparts; ++t) workers.emplace_back(worker, t);
+        auto finish = [&] {
+            {
+                std::lock_guard<std::mutex> lock(mu);
+                done = true;
+            }
+            ready.notify_all();
+            for (auto& w : workers) w.join();
+        };
+
+        try {
+            std::vector<std::string> batch;
+            std::size_t bases = 0;
+            auto submit = [&] {
+                std::unique_lock<std::mutex> lock(mu);
+                space.wait(lock, [&] { return done || work.size() < 2 * nparts; });
+                if (done) throw stop_feeding{};
+                work.push_back(std::move(batch));
+                lock.unlock();
+                ready.notify_one();
+                batch.clear();
+                bases = 0;
+            };
+            for_each_reader_stretch(
+                reader, k_,
+                [&](std::string_view seq, std::size_t) {
+                    batch.emplace_back(seq);
+                    bases += seq.size();
+                    if (bases >= batch_bases) submit();
+                },
+                min_quality);
+            if (!batch.empty()) submit();
+        } catch (const stop_feeding&) {
+            // the worker's error is rethrown below
+        } catch (...) {
+            finish();
+            throw;
+        }
+        finish();
+        if (error) std::rethrow_exception(error);
+
+        // Every worker has flushed; empty what is still queued for each
+        // partition, one partition per thread.
+        std::vector<std::thread> drains;
+        for (std::size_t p = 0; p < nparts; ++p) drains.emplace_back(drain, p);
+        for (auto& d : drains) d.join();
+
+        uint64_t n = 0;
+        for (uint64_t c : counted) n += c;
+        total_ += n;
+        return n;
+    }
+
+    unsigned k_;
+    bool canonical_;
+    std::vector<kmer_count_table> parts_;
+    uint64_t total_ = 0;
+};
+
+}  // namespace pygg
+
+inline void bind_kmer_counter(py::module_& m) {
+    using counter_t = pygg::kmer_counter;
+    using kmer_grove_t = ggs::grove<gdt::kmer, pygg::json_value, pygg::json_value>;
+    using numeric_grove_t = ggs::grove<gdt::numeric, pygg::json_value, pygg::json_value>;
+
+    py::class_<counter_t>(m, "KmerCounter", R"pbdoc(
+        Multi-threaded k-mer occurrence counter over FASTA/FASTQ input.
+
+        Counts live in C++ hash tables, one hash partition per worker thread, and
+        are exported at the end as NumPy arrays (to_numpy) or bulk-built into a
+        KmerGrove / NumericGrove whose payload is the count. Not thread-safe:
+        feed one counter from one Python thread at a time.
+
+        Parameters
+        ----------
+        k : int
+            The k-mer length, 1..32.
+        canonical : bool, optional
+            Count min(k-mer, reverse complement) (default: True).
+        threads : int, optional
+            Worker threads and hash partitions (default: 0 = all cores).
+    )pbdoc")
+        .def(py::init<unsigned, bool, unsigned>(), py::arg("k"),
+             py::arg("canonical") = true, py::arg("threads") = 0)
+        .def_property_readonly("k", &counter_t::k, "The k-mer length.")
+        .def_property_readonly("canonical", &counter_t::canonical,
+                               "Whether k-mers are counted canonically.")
+        .def_property_readonly("threads", &counter_t::threads,
+                               "Number of worker threads / hash partitions.")
+        .def_property_readonly("total", &counter_t::total,
+                               "Number of k-mer occurrences counted so far.")
+        .def("__len__", &counter_t::distinct, "Number of distinct k-mers counted.")
+        .def("__repr__", [](const counter_t& c) {
+            return "KmerCounter(k=" + std::to_string(c.k()) +
+                   ", distinct=" + std::to_string(c.distinct()) +
+                   ", total=" + std::to_string(c.total()) + ")";
+        })
+        .def("add",
+             [](counter_t& c, pygg::fasta_reader_handle& reader, unsigned min_quality) {
+                 return c.add_reader(reader, min_quality);
+             },
+             py::arg("source"), py::arg("min_quality") = 0,
+             py::call_guard<py::gil_scoped_release>(),
+             R"pbdoc(
+                 add(source, min_quality=0) -> int
+
+                 Count every k-mer of every record of `source` — a FastaReader
+                 (whole or chunk_size mode) or a FASTA/FASTQ path, streamed in
+                 1 Mb windows. K-mers containing non-A/C/G/T bases are skipped;
+                 with min_quality > 0, so are k-mers covering a FASTQ base whose
+                 Phred score (offset 33) is below it. Runs with the GIL released
+                 and returns the number of k-mer occurrences counted.
+             )pbdoc")
+        .def("add",
+             [](counter_t& c, const std::string& path, unsigned min_quality) {
+                 auto reader = pygg::open_kmer_source(path);
+                 return c.add_reader(reader, min_quality);
+             },
+             py::arg("source"), py::arg("min_quality") = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("add_sequence",
+             [](counter_t& c, std::string_view sequence) {
+                 return c.add_sequence(sequence);
+             },
+             py::arg("sequence"), py::call_guard<py::gil_scoped_release>(),
+             "Count every k-mer of one sequence (str) on the calling thread; "
+             "returns the number counted.")
+        .def("count",
+             [](const counter_t& c, std::string_view kmer) { return c.count(kmer); },
+             py::arg("kmer"),
+             R"pbdoc(
+                 count(kmer) -> int
+
+                 Occurrences of one k-mer, given as a str or Kmer of length k
+                 (canonicalized first on a canonical counter); 0 if unseen.
+                 Raises ValueError for the wrong length or a non-ACGT base.
+             )pbdoc")
+        .def("count",
+             [](const counter_t& c, const gdt::kmer& kmer) {
+                 return c.count(kmer.to_string());
+             },
+             py::arg("kmer"))
+        .def("clear", &counter_t::clear, "Drop every count.")
+        .def("to_numpy",
+             [](const counter_t& c, uint64_t min_count) {
+                 std::vector<uint64_t> enc, counts;
+                 {
+                     py::gil_scoped_release release;
+                     c.export_sorted(min_count, enc, counts);
+                 }
+                 py::array_t<uint64_t> enc_arr(static_cast<py::ssize_t>(enc.size()));
+                 std::copy(enc.begin(), enc.end(), enc_arr.mutable_data());
+                 py::array_t<uint64_t> cnt_arr(static_cast<py::ssize_t>(counts.size()));
+                 std::copy(counts.begin(), counts.end(), cnt_arr.mutable_data());
+                 return py::make_tuple(enc_arr, cnt_arr);
+             },
+             py::arg("min_count") = 1,
+             R"pbdoc(
+                 to_numpy(min_count=1) -> tuple[numpy.ndarray, numpy.ndarray]
+
+                 The k-mers seen at least min_count times as two uint64 arrays:
+                 2-bit encodings in ascending order (Kmer(encoding, k) decodes
+                 one) and their counts.
+             )pbdoc")
+        .def("to_kmer_grove",
+             [](const counter_t& c, const std::string& index, uint64_t min_count,
+                std::optional<int> order) {
+                 std::vector<uint64_t> enc, counts;
+                 c.export_sorted(min_count, enc, counts);
+                 std::vector<std::pair<gdt::kmer, pygg::json_value>> items;
+                 items.reserve(enc.size());
+                 for (std::size_t i = 0; i < enc.size(); ++i) {
+                     items.emplace_back(gdt::kmer(enc[i], static_cast<uint8_t>(c.k())),
+                                        pygg::json_value{std::to_string(counts[i])});
+                 }
+                 kmer_grove_t g = order ? kmer_grove_t(*order) : kmer_grove_t();
+                 if (!items.empty()) g.insert_data(index, items, ggs::sorted, ggs::bulk);
+                 return g;
+             },
+             py::arg("index") = "kmers", py::arg("min_count") = 1,
+             py::arg("order") = py::none(), py::call_guard<py::gil_scoped_release>(),
+             R"pbdoc(
+                 to_kmer_grove(index="kmers", min_count=1, order=None) -> KmerGrove
+
+                 Bulk-build a KmerGrove of the k-mers seen at least min_count
+                 times into `index`, each key's payload its count (an int).
+             )pbdoc")
+        .def("to_numeric_grove",
+             [](const counter_t& c, const std::string& index, uint64_t min_count,
+                std::optional<int> order) {
+                 if (c.k() > 15) {
+                     throw std::invalid_argument(
+                         "to_numeric_grove needs k <= 15 (encodings must fit a "
+                         "Numeric), got k=" + std::to_string(c.k()));
+                 }
+                 std::vector<uint64_t> enc, counts;
+                 c.export_sorted(min_count, enc, counts);
+                 std::vector<std::pair<gdt::numeric, pygg::json_value>> items;
+                 items.reserve(enc.size());
+                 for (std::size_t i = 0; i < enc.size(); ++i) {
+                     items.emplace_back(gdt::numeric(static_cast<int>(enc[i])),
+                                        pygg::json_value{std::to_string(counts[i])});
+                 }
+                 numeric_grove_t g = order ? numeric_grove_t(*order) : numeric_grove_t();
+                 if (!items.empty()) g.insert_data(index, items, ggs::sorted, ggs::bulk);
+                 return g;
+             },
+             py::arg("index") = "kmers", py::arg("min_count") = 1,
+             py::arg("order") = py::none(), py::call_guard<py::gil_scoped_release>(),
+             R"pbdoc(
+                 to_numeric_grove(index="kmers", min_count=1, order=None)
+                     -> NumericGrove
+
+                 Like to_kmer_grove, but keyed by Numeric(encoding) — for k <= 15,
+                 where every encoding fits a Numeric. Raises ValueError otherwise.
+             )pbdoc");
+}
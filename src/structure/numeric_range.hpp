@@ -0,0 +1,114 @@
+/*
+ * Range scans over the point-keyed NumericGrove / NumericGroveView: every key
+ * whose value lies in the closed range [lo, hi]. gdt::numeric overlap is exact
+ * equality, so intersect() cannot express a range on its own.
+ *
+ * On a NumericGrove the scan descends once to the first key >= lo and walks
+ * the leaf chain until a value exceeds hi (index_walk.hpp): one descent plus
+ * the keys in range. A NumericGroveView has no node access, so it steps through
+ * the distinct values instead — flanking()'s successor, then a point lookup for
+ * every key sharing that value — one pair of descents per distinct value in
+ * range.
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <genogrove/data_type/numeric.hpp>
+
+#include "../data_type/key_list.hpp"
+#include "../data_type/payload_columns.hpp"
+#include "index_walk.hpp"
+
+namespace py = pybind11;
+namespace gdt = genogrove::data_type;
+
+namespace pygg {
+
+// fn(key*) for every key of `index` with lo <= value <= hi, in value order.
+// Owner is a grove or a grove_view over gdt::numeric keys.
+template <typename Owner, typename Fn>
+void numeric_range_scan(Owner& owner, int64_t lo, int64_t hi, std::string_view index,
+                        Fn&& fn) {
+    lo = std::max<int64_t>(lo, INT_MIN);
+    hi = std::min<int64_t>(hi, INT_MAX);
+    if (lo > hi) return;
+    columns_scope scope(&owner);
+    const std::string name(index);
+    if constexpr (has_leaf_chain<Owner>) {
+        walk_index(
+            owner, name, [lo](const auto& key) { return key.get_value().get_value() < lo; },
+            [&](auto* key) {
+                if (key->get_value().get_value() > hi) return false;
+                fn(key);
+                return true;
+            });
+        return;
+    }
+    int value = static_cast<int>(lo);
+    for (;;) {
+        const gdt::numeric query(value);
+        auto hits = owner.intersect(query, index);
+        for (auto* key : hits.get_keys()) fn(key);
+        auto next = owner.flanking(query, name).get_successor();
+        if (!next || next->get_value().get_value() > hi) return;
+        value = next->get_value().get_value();
+    }
+}
+
+// key_t is the Owner's gdt::key instantiation.
+template <typename Owner, typename key_t, typename Class>
+void bind_numeric_range(Class& cls, bool release_gil) {
+    cls.def(
+        "range",
+        [release_gil](py::object self, int64_t lo, int64_t hi, std::string_view index,
+                      bool as_array) -> py::object {
+            auto& owner = self.cast<Owner&>();
+            std::vector<key_t*> keys;
+            {
+                std::optional<py::gil_scoped_release> release;
+                if (release_gil) release.emplace();
+                numeric_range_scan(owner, lo, hi, index,
+                                   [&](key_t* key) { keys.push_back(key); });
+            }
+            if (!as_array) return pinned_key_list(keys, self);
+            py::array_t<int64_t> out(static_cast<py::ssize_t>(keys.size()));
+            int64_t* o = out.mutable_data();
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                o[i] = keys[i]->get_value().get_value();
+            }
+            return std::move(out);
+        },
+        py::arg("lo"), py::arg("hi"), py::arg("index"), py::arg("as_array") = false,
+        R"pbdoc(
+            range(lo, hi, index, as_array=False) -> list[NumericKey] | numpy.ndarray
+
+            Every key of `index` whose value lies in the closed range [lo, hi],
+            in ascending value order (keys sharing a value are all returned).
+            With as_array=True, their values as an int64 array instead. Bounds
+            beyond the 32-bit Numeric range are clamped; lo > hi is empty.
+        )pbdoc");
+    cls.def(
+        "range_count",
+        [release_gil](Owner& owner, int64_t lo, int64_t hi, std::string_view index) {
+            std::size_t n = 0;
+            std::optional<py::gil_scoped_release> release;
+            if (release_gil) release.emplace();
+            numeric_range_scan(owner, lo, hi, index, [&](key_t*) { ++n; });
+            return n;
+        },
+        py::arg("lo"), py::arg("hi"), py::arg("index"),
+        "Number of keys of `index` with lo <= value <= hi (see range()).");
+}
+
+}  // namespace pygg
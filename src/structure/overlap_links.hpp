@@ -0,0 +1,159 @@
+/*
+ * link_overlaps — build a locus graph natively on the genomic_coordinate groves:
+ * one directed edge, earlier key -> later key in coordinate order, for every
+ * pair of keys in an index that overlap or lie within max_gap positions of each
+ * other (optionally only on compatible strands).
+ *
+ * The index's keys are read once (an intersect with a whole-index '*' query,
+ * which walks the leaves in order) and swept by start: an active list holds the
+ * keys whose end + max_gap still reaches the sweep position, so each key is
+ * compared only with the keys it can link to. The sweep and the linking run with
+ * the GIL released; a callable `metadata` is evaluated per pair in between, with
+ * the GIL held.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <genogrove/data_type/genomic_coordinate.hpp>
+
+#include "../data_type/json_value.hpp"
+#include "../data_type/payload_columns.hpp"
+#include "frozen_graph.hpp"
+
+namespace py = pybind11;
+namespace gdt = genogrove::data_type;
+
+namespace pygg {
+
+inline bool strands_compatible(char a, char b) { return a == b || a == '*' || b == '*'; }
+
+// Every (earlier, later) pair of `index`'s keys with later.start <=
+// earlier.end + max_gap, in sweep order.
+template <typename grove_t, typename key_t>
+std::vector<std::pair<key_t*, key_t*>> overlapping_pairs(grove_t& g, std::string_view index,
+                                                         std::size_t max_gap, bool same_strand) {
+    const gdt::genomic_coordinate everything('*', 0, std::numeric_limits<std::size_t>::max());
+    auto hits = g.intersect(everything, index);
+    std::vector<key_t*> keys(hits.get_keys().begin(), hits.get_keys().end());
+    // Leaves come back in coordinate order already; the sweep only needs start
+    // order, which the (stable) sort guarantees either way.
+    std::stable_sort(keys.begin(), keys.end(), [](const key_t* a, const key_t* b) {
+        return a->get_value().get_start() < b->get_value().get_start();
+    });
+    auto reach = [max_gap](const key_t* k) {
+        const std::size_t end = k->get_value().get_end();
+        return end > std::numeric_limits<std::size_t>::max() - max_gap
+                   ? std::numeric_limits<std::size_t>::max()
+                   : end + max_gap;
+    };
+    std::vector<std::pair<key_t*, key_t*>> pairs;
+    std::vector<key_t*> active;
+    for (key_t* key : keys) {
+        const auto& c = key->get_value();
+        std::size_t kept = 0;
+        for (key_t* a : active) {
+            if (reach(a) < c.get_start()) continue;  // can no longer reach any later key
+            active[kept++] = a;
+            if (same_strand && !strands_compatible(a->get_value().get_strand(), c.get_strand())) {
+                continue;
+            }
+            pairs.emplace_back(a, key);
+        }
+        active.resize(kept);
+        active.push_back(key);
+    }
+    return pairs;
+}
+
+}  // namespace pygg
+
+template <typename grove_t, typename key_t, typename EdgeT, typename Class>
+void bind_link_overlaps(Class& cls) {
+    auto pairs_of = [](grove_t& g, std::string_view index, std::size_t max_gap, bool same_strand) {
+        py::gil_scoped_release release;
+        return pygg::overlapping_pairs<grove_t, key_t>(g, index, max_gap, same_strand);
+    };
+    if constexpr (std::is_same_v<EdgeT, pygg::json_value>) {
+        cls.def(
+            "link_overlaps",
+            [pairs_of](py::object self, std::string_view index, std::size_t max_gap,
+                       bool same_strand, py::object metadata) {
+                auto& g = self.cast<grove_t&>();
+                pygg::thaw_graph(&g);
+                auto pairs = pairs_of(g, index, max_gap, same_strand);
+                const auto cols = pygg::grove_columns(&g);
+                if (metadata.is_none()) {
+                    py::gil_scoped_release release;
+                    for (auto& [a, b] : pairs) g.add_edge(a, b);
+                    return pairs.size();
+                }
+                if (PyCallable_Check(metadata.ptr())) {
+                    // Per-pair metadata: Python calls, so the GIL stays held.
+                    std::size_t added = 0;
+                    for (auto& [a, b] : pairs) {
+                        constexpr auto policy = py::return_value_policy::reference_internal;
+                        py::object m = metadata(py::cast(a, policy, self), py::cast(b, policy, self));
+                        if (m.is_none()) continue;
+                        auto data = m.cast<pygg::json_value>();
+                        if (cols) pygg::encode_columns(*cols, data);
+                        g.add_edge(a, b, std::move(data));
+                        ++added;
+                    }
+                    return added;
+                }
+                auto data = metadata.cast<pygg::json_value>();
+                if (cols) pygg::encode_columns(*cols, data);
+                py::gil_scoped_release release;
+                for (auto& [a, b] : pairs) g.add_edge(a, b, data);
+                return pairs.size();
+            },
+            py::arg("index"), py::arg("max_gap") = 0, py::arg("same_strand") = false,
+            py::arg("metadata") = py::none(),
+            R"pbdoc(
+                link_overlaps(index, max_gap=0, same_strand=False, metadata=None) -> int
+
+                Add a directed edge earlier -> later (in coordinate order) between
+                every pair of keys in `index` that overlap or lie within max_gap
+                positions of each other — later.start <= earlier.end + max_gap, so
+                max_gap=0 links overlapping keys and max_gap=1 also book-ended
+                ones. same_strand=True links only keys on compatible strands ('*'
+                matches any). The index is swept once in C++ with the GIL
+                released. `metadata` is None (unlabelled edges), a value attached
+                to every edge, or a callable metadata(earlier, later) returning the
+                edge's metadata, or None to skip the pair (evaluated with the GIL
+                held, after the sweep). Returns the number of edges added.
+            )pbdoc");
+    } else {
+        cls.def(
+            "link_overlaps",
+            [pairs_of](grove_t& g, std::string_view index, std::size_t max_gap,
+                       bool same_strand) {
+                pygg::thaw_graph(&g);
+                auto pairs = pairs_of(g, index, max_gap, same_strand);
+                py::gil_scoped_release release;
+                for (auto& [a, b] : pairs) g.add_edge(a, b);
+                return pairs.size();
+            },
+            py::arg("index"), py::arg("max_gap") = 0, py::arg("same_strand") = false,
+            R"pbdoc(
+                link_overlaps(index, max_gap=0, same_strand=False) -> int
+
+                Add a directed edge earlier -> later (in coordinate order) between
+                every pair of keys in `index` that overlap or lie within max_gap
+                positions of each other — later.start <= earlier.end + max_gap, so
+                max_gap=0 links overlapping keys and max_gap=1 also book-ended
+                ones. same_strand=True links only keys on compatible strands ('*'
+                matches any). The index is swept once in C++ with the GIL
+                released. Returns the number of edges added.
+            )pbdoc");
+    }
+}
@@ -0,0 +1,195 @@
+/*
+ * In-place payload updates on the JSON-payload groves (Grove, NumericGrove,
+ * KmerGrove) — set_data / set_data_many replace a key's stored json_value, and
+ * update(query, index, fields) patches the payloads of a query's hits.
+ *
+ * The payload is not part of B+ tree ordering, so none of these touch the tree:
+ * each assigns through the key's storage slot. A dict of fields is encoded once
+ * (interned fields included) and spliced into each hit's stored JSON text with
+ * the GIL released — the payloads are never decoded; a callable update decodes
+ * each payload for the call, with the GIL held.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../data_type/json_value.hpp"
+#include "../data_type/payload_columns.hpp"
+
+namespace py = pybind11;
+
+namespace pygg {
+
+// One top-level member to set: its name, the quoted name, and the JSON value.
+struct json_field {
+    std::string name;
+    std::string quoted;
+    std::string value;
+};
+
+// The members of an (already encoded) JSON object, in order.
+inline std::vector<json_field> json_fields_of(const json_value& patch) {
+    std::vector<json_field> out;
+    const std::string_view s(patch.json);
+    const bool object = for_each_json_member(s, [&](std::string_view name, std::size_t b,
+                                                    std::size_t e) {
+        std::string plain = name.find('\\') == std::string_view::npos ? std::string(name)
+                                                                      : json_unescape(name);
+        out.push_back({plain, json_quote(plain).json, std::string(s.substr(b, e - b))});
+    });
+    if (!object) throw std::invalid_argument("update fields must be a dict");
+    return out;
+}
+
+// Whether set_json_fields can patch v: a JSON object, or null.
+inline bool json_patchable(const json_value& v) {
+    return v.json == "null" ||
+           for_each_json_member(v.json, [](std::string_view, std::size_t, std::size_t) {});
+}
+
+// Set `fields` on the JSON object in v: an existing member's value is replaced
+// (the last one, as json.loads keeps), a new one is appended. A null payload
+// becomes an object; any other non-object payload raises.
+inline void set_json_fields(json_value& v, const std::vector<json_field>& fields) {
+    std::string& s = v.json;
+    if (s == "null") s = "{}";
+    for (const auto& f : fields) {
+        std::optional<std::pair<std::size_t, std::size_t>> at;
+        const bool object = for_each_json_member(s, [&](std::string_view name, std::size_t b,
+                                                        std::size_t e) {
+            const bool match = name.find('\\') == std::string_view::npos
+                                   ? name == f.name
+                                   : json_unescape(name) == f.name;
+            if (match) at.emplace(b, e);
+        });
+        if (!object) {
+            throw std::invalid_argument(
+                "payload is not a JSON object; use set_data() to replace it");
+        }
+        if (at) {
+            s.replace(at->first, at->second - at->first, f.value);
+            continue;
+        }
+        const std::size_t close = s.find_last_of('}');
+        const bool empty = json_skip_ws(s, s.find('{') + 1) == close;
+        s.insert(close, (empty ? "" : ", ") + f.quoted + ": " + f.value);
+    }
+}
+
+}  // namespace pygg
+
+template <typename grove_t, typename key_t, typename KeyT, typename Class>
+void bind_payload_update(Class& cls) {
+    cls.def(
+        "set_data",
+        [](grove_t& g, key_t* key, pygg::json_value data) {
+            pygg::apply_columns(&g, data);
+            key->get_data() = std::move(data);
+        },
+        py::arg("key").none(false), py::arg("data"),
+        R"pbdoc(
+            set_data(key, data) -> None
+
+            Replace the payload of `key` in place. The payload is not part of
+            B+ tree ordering, so the key keeps its position, edges and handles;
+            interned fields are encoded as on insert.
+        )pbdoc");
+    cls.def(
+        "set_data_many",
+        [](grove_t& g, const std::vector<key_t*>& keys, const py::sequence& values) {
+            if (static_cast<std::size_t>(py::len(values)) != keys.size()) {
+                throw std::invalid_argument("keys and values must have the same length");
+            }
+            std::vector<pygg::json_value> data;
+            data.reserve(keys.size());
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (!keys[i]) throw std::invalid_argument("keys must not contain None");
+                data.push_back(values[i].cast<pygg::json_value>());
+            }
+            const auto cols = pygg::grove_columns(&g);
+            py::gil_scoped_release release;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (cols) pygg::encode_columns(*cols, data[i]);
+                keys[i]->get_data() = std::move(data[i]);
+            }
+            return keys.size();
+        },
+        py::arg("keys"), py::arg("values"),
+        R"pbdoc(
+            set_data_many(keys, values) -> int
+
+            set_data() for each (keys[i], values[i]) pair: the values are
+            converted to JSON first, then stored with the GIL released. Returns
+            the number of payloads replaced.
+        )pbdoc");
+    cls.def(
+        "update",
+        [](py::object self, const KeyT& query, std::string_view index, py::object fields) {
+            auto& g = self.cast<grove_t&>();
+            const auto cols = pygg::grove_columns(&g);
+            std::vector<key_t*> hits;
+            {
+                py::gil_scoped_release release;
+                auto result = g.intersect(query, index);
+                hits.assign(result.get_keys().begin(), result.get_keys().end());
+            }
+            if (py::isinstance<py::dict>(fields)) {
+                auto patch = fields.cast<pygg::json_value>();
+                if (cols) {
+                    pygg::encode_columns(*cols, patch);
+                    pygg::strip_columns_header(patch);
+                }
+                const auto members = pygg::json_fields_of(patch);
+                py::gil_scoped_release release;
+                // Check every hit first, so a bad payload leaves all of them as
+                // they were.
+                for (key_t* k : hits) {
+                    if (!pygg::json_patchable(k->get_data())) {
+                        throw std::invalid_argument(
+                            "payload is not a JSON object; use set_data() to replace it");
+                    }
+                }
+                for (key_t* k : hits) {
+                    auto& data = k->get_data();
+                    pygg::set_json_fields(data, members);
+                    if (cols) pygg::index_columns(*cols, data);
+                }
+                return hits.size();
+            }
+            if (!PyCallable_Check(fields.ptr())) {
+                throw py::type_error("update() takes a dict of fields or a callable");
+            }
+            // Every new payload is computed before any is stored, so a raising
+            // callable leaves the grove unchanged.
+            std::vector<pygg::json_value> data;
+            data.reserve(hits.size());
+            for (key_t* k : hits) {
+                data.push_back(fields(py::cast(k->get_data())).cast<pygg::json_value>());
+                if (cols) pygg::encode_columns(*cols, data.back());
+            }
+            for (std::size_t i = 0; i < hits.size(); ++i) hits[i]->get_data() = std::move(data[i]);
+            return hits.size();
+        },
+        py::arg("query"), py::arg("index"), py::arg("fields"),
+        R"pbdoc(
+            update(query, index, fields) -> int
+
+            Update the payload of every key intersect(query, index) returns.
+            `fields` is a dict of top-level fields to set — encoded once and
+            spliced into each stored payload in C++ with the GIL released
+            (a None payload becomes a dict; any other non-dict payload raises
+            ValueError) — or a callable fn(data) returning the new payload,
+            called per hit with the GIL held. Every hit is checked (or, for a
+            callable, computed) before any is written, so on an error the
+            grove is left unchanged. Returns the number of keys updated.
+        )pbdoc");
+}
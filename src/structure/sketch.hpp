@@ -0,0 +1,562 @@
+/*
+ * Sequence sketches for sample-similarity screening: minimizers, bottom-k
+ * MinHash sketches, and a SketchIndex answering containment / Jaccard queries
+ * over many sampled sketches. Full k-mer sets of every sample do not fit a
+ * KmerGrove; a sketch keeps the `size` smallest k-mer hashes instead, which is
+ * enough to estimate set similarity.
+ *
+ * K-mers are taken with the same rolling 2-bit encoder as PackedSequence.kmers
+ * and KmerGrove.from_sequences (gdt::kmer encoding), and ranked by kmer_hash —
+ * lexicographic minima would over-select poly-A.
+ *
+ * The index is a KmerGrove of postings: one key per distinct hash, Kmer(hash,
+ * 32) — a 32-mer's encoding is a full 64-bit word — whose payload lists the ids
+ * of the samples holding it. A query looks up only its own hashes and counts
+ * shared hashes per sample from the postings; the estimates then need just each
+ * sample's sketch size, hash count and largest hash, so the postings are the
+ * only copy of the sketches. add() merges a sketch's ascending hashes into the
+ * postings in key order and bulk-loads the result bottom-up, one pass over the
+ * index rather than an insert per hash.
+ */
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <genogrove/data_type/kmer.hpp>
+#include <genogrove/structure/grove/grove.hpp>
+
+#include "../data_type/json_value.hpp"
+#include "../data_type/packed_sequence.hpp"
+#include "../io/kmer_source.hpp"
+#include "index_walk.hpp"
+
+namespace py = pybind11;
+namespace ggs = genogrove::structure;
+namespace gdt = genogrove::data_type;
+
+namespace pygg {
+
+// fn(position, encoding) for each (w, k)-minimizer of seq: the k-mer with the
+// smallest hash among w consecutive k-mers (leftmost on ties), reported once
+// per run of windows sharing it. A non-ACGT base ends the current run of
+// windows; the next window starts w k-mers after it.
+template <typename Fn>
+void for_each_minimizer(std::string_view seq, unsigned k, unsigned w, bool canonical,
+                        Fn&& fn) {
+    struct entry {
+        std::size_t pos;
+        uint64_t enc;
+        uint64_t hash;
+    };
+    std::deque<entry> window;  // increasing hash, increasing position
+    std::size_t run = 0;       // consecutive k-mers since the last break
+    std::size_t next_pos = 0;
+    std::size_t last = std::numeric_limits<std::size_t>::max();
+    for_each_kmer_ascii(seq, k, canonical, 1, [&](std::size_t pos, uint64_t enc) {
+        if (pos != next_pos) {  // an N broke the k-mer run
+            window.clear();
+            run = 0;
+        }
+        next_pos = pos + 1;
+        const uint64_t h = kmer_hash(enc);
+        while (!window.empty() && window.back().hash > h) window.pop_back();
+        window.push_back({pos, enc, h});
+        if (++run < w) return;
+        while (window.front().pos + w <= pos) window.pop_front();
+        if (window.front().pos != last) {
+            last = window.front().pos;
+            fn(last, window.front().enc);
+        }
+    });
+}
+
+// Bottom-k MinHash: the `size` smallest distinct kmer_hash values of every
+// k-mer added, kept sorted.
+class minhash_sketch {
+public:
+    minhash_sketch(unsigned k, std::size_t size, bool canonical)
+        : k_(k), size_(size), canonical_(canonical) {
+        check_kmer_k(k);
+        if (size == 0) throw std::invalid_argument("sketch size must be positive");
+    }
+
+    unsigned k() const { return k_; }
+    std::size_t size() const { return size_; }
+    bool canonical() const { return canonical_; }
+    const std::vector<uint64_t>& hashes() const { return hashes_; }
+    bool full() const { return hashes_.size() == size_; }
+
+    void add_sequence(std::string_view seq) {
+        for_each_kmer_ascii(seq, k_, canonical_, 1,
+                            [&](std::size_t, uint64_t enc) { push(kmer_hash(enc)); });
+        compact();
+    }
+
+    void add_reader(fasta_reader_handle& reader, unsigned min_quality) {
+        for_each_reader_stretch(
+            reader, k_,
+            [&](std::string_view seq, std::size_t) {
+                for_each_kmer_ascii(seq, k_, canonical_, 1, [&](std::size_t, uint64_t enc) {
+                    push(kmer_hash(enc));
+                });
+            },
+            min_quality);
+        compact();
+    }
+
+    // Precomputed hashes (e.g. a stored sketch); kept to the bottom `size`.
+    void add_hashes(const uint64_t* h, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) push(h[i]);
+        compact();
+    }
+
+    // Mash's estimator: the share of the union's bottom-s hashes (s the smaller
+    // sketch size) that both sketches hold.
+    double jaccard(const minhash_sketch& other) const {
+        check_compatible(other);
+        const auto& a = hashes_;
+        const auto& b = other.hashes_;
+        const std::size_t s = std::min(size_, other.size_);
+        std::size_t i = 0, j = 0, taken = 0, shared = 0;
+        while (taken < s && (i < a.size() || j < b.size())) {
+            if (j == b.size() || (i < a.size() && a[i] < b[j])) {
+                ++i;
+            } else if (i == a.size() || b[j] < a[i]) {
+                ++j;
+            } else {
+                ++shared;
+                ++i;
+                ++j;
+            }
+            ++taken;
+        }
+        return taken ? static_cast<double>(shared) / static_cast<double>(taken) : 0.0;
+    }
+
+    // Estimated fraction of this sketch's k-mers present in other's set. Only
+    // hashes up to other's largest are comparable when other is full.
+    double containment(const minhash_sketch& other) const {
+        check_compatible(other);
+        const auto& b = other.hashes_;
+        const uint64_t limit =
+            other.full() ? b.back() : std::numeric_limits<uint64_t>::max();
+        std::size_t considered = 0, shared = 0, j = 0;
+        for (uint64_t h : hashes_) {
+            if (h > limit) break;
+            ++considered;
+            while (j < b.size() && b[j] < h) ++j;
+            if (j < b.size() && b[j] == h) ++shared;
+        }
+        return considered ? static_cast<double>(shared) / static_cast<double>(considered)
+                          : 0.0;
+    }
+
+    void check_compatible(const minhash_sketch& other) const {
+        if (other.k_ != k_ || other.canonical_ != canonical_) {
+            throw std::invalid_argument(
+                "sketches differ in k or canonical mode and cannot be compared");
+        }
+    }
+
+private:
+    void push(uint64_t h) {
+        if (full() && h >= hashes_.back()) return;
+        pending_.push_back(h);
+        if (pending_.size() >= 2 * size_) compact();
+    }
+
+    void compact() {
+        if (pending_.empty()) return;
+        pending_.insert(pending_.end(), hashes_.begin(), hashes_.end());
+        std::sort(pending_.begin(), pending_.end());
+        pending_.erase(std::unique(pending_.begin(), pending_.end()), pending_.end());
+        if (pending_.size() > size_) pending_.resize(size_);
+        hashes_.swap(pending_);
+        pending_.clear();
+    }
+
+    unsigned k_;
+    std::size_t size_;
+    bool canonical_;
+    std::vector<uint64_t> hashes_;
+    std::vector<uint64_t> pending_;
+};
+
+class sketch_index {
+public:
+    using grove_t = ggs::grove<gdt::kmer, json_value, json_value>;
+    static constexpr const char* index_name = "sketch";
+
+    // name, shared hashes, containment of the query, Jaccard estimate
+    using hit = std::tuple<std::string, std::size_t, double, double>;
+
+    sketch_index(unsigned k, bool canonical, std::optional<int> order)
+        : k_(k), canonical_(canonical), order_(order), grove_(make_grove()) {
+        check_kmer_k(k);
+    }
+
+    unsigned k() const { return k_; }
+    bool canonical() const { return canonical_; }
+    std::size_t sample_count() const { return samples_.size(); }
+    std::vector<std::string> names() const {
+        std::vector<std::string> out;
+        out.reserve(samples_.size());
+        for (const auto& s : samples_) out.push_back(s.name);
+        return out;
+    }
+
+    // Sample id's sketch, gathered from the postings (one pass over the index).
+    minhash_sketch sketch(std::size_t id) const {
+        const sample& smp = samples_.at(id);
+        std::vector<uint64_t> hashes;
+        hashes.reserve(smp.count);
+        for_each_posting([&](uint64_t h, const std::vector<uint32_t>& ids) {
+            if (std::binary_search(ids.begin(), ids.end(), static_cast<uint32_t>(id))) {
+                hashes.push_back(h);
+            }
+        });
+        minhash_sketch out(k_, smp.size, canonical_);
+        out.add_hashes(hashes.data(), hashes.size());
+        return out;
+    }
+
+    std::size_t add(const std::string& name, const minhash_sketch& s) {
+        if (s.k() != k_ || s.canonical() != canonical_) {
+            throw std::invalid_argument("sketch k / canonical mode does not match the index");
+        }
+        for (const auto& smp : samples_) {
+            if (smp.name == name) {
+                throw std::invalid_argument("sample '" + name + "' is already indexed");
+            }
+        }
+        const auto id = static_cast<uint32_t>(samples_.size());
+        const auto& hashes = s.hashes();
+        // Merge the sketch's (ascending) hashes into the index's postings, in
+        // key order, and bulk-load the result bottom-up.
+        std::vector<std::pair<gdt::kmer, json_value>> items;
+        std::size_t i = 0;
+        for_each_posting([&](uint64_t h, std::vector<uint32_t> ids) {
+            for (; i < hashes.size() && hashes[i] < h; ++i) items.push_back(posting(hashes[i], {id}));
+            if (i < hashes.size() && hashes[i] == h) {
+                ids.push_back(id);
+                ++i;
+            }
+            items.push_back(posting(h, ids));
+        });
+        for (; i < hashes.size(); ++i) items.push_back(posting(hashes[i], {id}));
+        auto fresh = make_grove();
+        if (!items.empty()) fresh->insert_data(index_name, items, ggs::sorted, ggs::bulk);
+        grove_ = std::move(fresh);
+        samples_.push_back({name, s.size(), hashes.size(), hashes.empty() ? 0 : hashes.back()});
+        return id;
+    }
+
+    // Samples sharing at least min_shared hashes with q, most similar first.
+    // Only q's hashes are looked up; the estimates use the shared counts and
+    // each sample's size and largest hash.
+    std::vector<hit> query(const minhash_sketch& q, std::size_t min_shared) const {
+        if (q.k() != k_ || q.canonical() != canonical_) {
+            throw std::invalid_argument("sketch k / canonical mode does not match the index");
+        }
+        std::vector<std::size_t> shared(samples_.size(), 0);
+        for (uint64_t h : q.hashes()) {
+            auto result = grove_->intersect(gdt::kmer(h, 32), index_name);
+            for (auto* key : result.get_keys()) {
+                for (uint32_t id : posting_ids(key->get_data().json)) ++shared[id];
+            }
+        }
+        std::vector<hit> out;
+        for (std::size_t id = 0; id < shared.size(); ++id) {
+            if (shared[id] == 0 || shared[id] < min_shared) continue;
+            const auto [containment, jaccard] = estimates(q, samples_[id], shared[id]);
+            out.emplace_back(samples_[id].name, shared[id], containment, jaccard);
+        }
+        std::stable_sort(out.begin(), out.end(), [](const hit& a, const hit& b) {
+            return std::get<3>(a) > std::get<3>(b);
+        });
+        return out;
+    }
+
+private:
+    struct sample {
+        std::string name;
+        std::size_t size;   // the sketch's size parameter
+        std::size_t count;  // hashes it holds
+        uint64_t max_hash;  // its largest hash
+        bool full() const { return count == size; }
+    };
+
+    std::unique_ptr<grove_t> make_grove() const {
+        return order_ ? std::make_unique<grove_t>(*order_) : std::make_unique<grove_t>();
+    }
+
+    static std::pair<gdt::kmer, json_value> posting(uint64_t h, const std::vector<uint32_t>& ids) {
+        std::string json = "[";
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (i) json += ',';
+            json += std::to_string(ids[i]);
+        }
+        json += ']';
+        return {gdt::kmer(h, 32), json_value{std::move(json)}};
+    }
+
+    // The sample ids of a posting payload, "[0,4,7]", ascending.
+    static std::vector<uint32_t> posting_ids(std::string_view json) {
+        std::vector<uint32_t> out;
+        uint32_t v = 0;
+        bool digit = false;
+        for (char c : json) {
+            if (c >= '0' && c <= '9') {
+                v = v * 10 + static_cast<uint32_t>(c - '0');
+                digit = true;
+            } else if (digit) {
+                out.push_back(v);
+                v = 0;
+                digit = false;
+            }
+        }
+        return out;
+    }
+
+    // fn(hash, ids) for every posting, in ascending hash order.
+    template <typename Fn>
+    void for_each_posting(Fn&& fn) const {
+        for_each_index_key(*grove_, index_name, [&fn](auto* key) {
+            fn(key->get_value().get_encoding(), posting_ids(key->get_data().json));
+        });
+    }
+
+    // (containment, Jaccard) of q against a sample it shares `shared` hashes
+    // with. Both count only hashes up to t, the smaller of the two sketches'
+    // limits (a sketch that is not full covers every hash): containment is the
+    // share of q's hashes <= t found in the sample, as minhash_sketch computes
+    // it; Jaccard is shared / |union| over hashes <= t, with the sample's count
+    // below t scaled from its largest hash when t falls inside its range.
+    static std::pair<double, double> estimates(const minhash_sketch& q, const sample& s,
+                                               std::size_t shared) {
+        constexpr uint64_t unbounded = std::numeric_limits<uint64_t>::max();
+        const auto& qh = q.hashes();
+        const uint64_t q_limit = q.full() ? qh.back() : unbounded;
+        const uint64_t s_limit = s.full() ? s.max_hash : unbounded;
+        const uint64_t t = std::min(q_limit, s_limit);
+        const auto q_t = static_cast<std::size_t>(
+            std::upper_bound(qh.begin(), qh.end(), t) - qh.begin());
+        double s_t = static_cast<double>(s.count);
+        if (t < s.max_hash) {
+            s_t = std::max(static_cast<double>(shared),
+                           s_t * static_cast<double>(t) / static_cast<double>(s.max_hash));
+        }
+        const double considered = static_cast<double>(
+            std::upper_bound(qh.begin(), qh.end(), s_limit) - qh.begin());
+        const double containment = considered ? static_cast<double>(shared) / considered : 0.0;
+        const double uni = static_cast<double>(q_t) + s_t - static_cast<double>(shared);
+        return {containment, uni > 0 ? static_cast<double>(shared) / uni : 0.0};
+    }
+
+    unsigned k_;
+    bool canonical_;
+    std::optional<int> order_;
+    std::unique_ptr<grove_t> grove_;
+    std::vector<sample> samples_;
+};
+
+}  // namespace pygg
+
+inline void bind_sketch(py::module_& m) {
+    using sketch_t = pygg::minhash_sketch;
+    using index_t = pygg::sketch_index;
+
+    m.def(
+        "minimizers",
+        [](std::string_view sequence, unsigned k, unsigned w, bool canonical,
+           bool positions) -> py::object {
+            pygg::check_kmer_k(k);
+            if (w == 0) throw std::invalid_argument("w must be positive");
+            std::vector<uint64_t> enc;
+            std::vector<int64_t> pos;
+            {
+                py::gil_scoped_release release;
+                pygg::for_each_minimizer(sequence, k, w, canonical,
+                                         [&](std::size_t at, uint64_t e) {
+                                             enc.push_back(e);
+                                             pos.push_back(static_cast<int64_t>(at));
+                                         });
+            }
+            py::array_t<uint64_t> enc_arr(static_cast<py::ssize_t>(enc.size()));
+            std::copy(enc.begin(), enc.end(), enc_arr.mutable_data());
+            if (!positions) return std::move(enc_arr);
+            py::array_t<int64_t> pos_arr(static_cast<py::ssize_t>(pos.size()));
+            std::copy(pos.begin(), pos.end(), pos_arr.mutable_data());
+            return py::make_tuple(enc_arr, pos_arr);
+        },
+        py::arg("sequence"), py::arg("k"), py::arg("w"), py::arg("canonical") = true,
+        py::arg("positions") = false,
+        R"pbdoc(
+            minimizers(sequence, k, w, canonical=True, positions=False)
+                -> numpy.ndarray | tuple[numpy.ndarray, numpy.ndarray]
+
+            The (w, k)-minimizers of a DNA string: in every window of w
+            consecutive k-mers, the k-mer with the smallest hash (leftmost on
+            ties), reported once per run of windows that share it. Returns their
+            uint64 2-bit encodings (Kmer(encoding, k) decodes one), plus int64
+            start positions with positions=True. Windows never span a non-ACGT
+            base.
+        )pbdoc");
+
+    py::class_<sketch_t>(m, "MinHashSketch", R"pbdoc(
+        A bottom-k MinHash sketch: the `size` smallest distinct hashes of a
+        sequence set's k-mers, for estimating Jaccard similarity and
+        containment between sets without storing them.
+
+        Parameters
+        ----------
+        k : int, optional
+            The k-mer length, 1..32 (default: 21).
+        size : int, optional
+            Number of hashes kept (default: 1000).
+        canonical : bool, optional
+            Hash min(k-mer, reverse complement) (default: True).
+    )pbdoc")
+        .def(py::init<unsigned, std::size_t, bool>(), py::arg("k") = 21,
+             py::arg("size") = 1000, py::arg("canonical") = true)
+        .def_static(
+            "from_hashes",
+            [](py::array_t<uint64_t, py::array::c_style | py::array::forcecast> hashes,
+               unsigned k, std::size_t size, bool canonical) {
+                sketch_t s(k, size, canonical);
+                s.add_hashes(hashes.data(), static_cast<std::size_t>(hashes.size()));
+                return s;
+            },
+            py::arg("hashes"), py::arg("k"), py::arg("size") = 1000,
+            py::arg("canonical") = true,
+            "Rebuild a sketch from stored hashes (e.g. a saved `hashes` array).")
+        .def_property_readonly("k", &sketch_t::k, "The k-mer length.")
+        .def_property_readonly("size", &sketch_t::size, "Maximum number of hashes kept.")
+        .def_property_readonly("canonical", &sketch_t::canonical,
+                               "Whether k-mers are hashed canonically.")
+        .def_property_readonly(
+            "hashes",
+            [](const sketch_t& s) {
+                const auto& h = s.hashes();
+                py::array_t<uint64_t> out(static_cast<py::ssize_t>(h.size()));
+                std::copy(h.begin(), h.end(), out.mutable_data());
+                return out;
+            },
+            "The sketch's hashes as an ascending uint64 array (a copy).")
+        .def("__len__", [](const sketch_t& s) { return s.hashes().size(); })
+        .def("__repr__", [](const sketch_t& s) {
+            return "MinHashSketch(k=" + std::to_string(s.k()) + ", size=" +
+                   std::to_string(s.size()) + ", hashes=" +
+                   std::to_string(s.hashes().size()) + ")";
+        })
+        .def("add",
+             [](sketch_t& s, pygg::fasta_reader_handle& reader, unsigned min_quality) {
+                 s.add_reader(reader, min_quality);
+             },
+             py::arg("source"), py::arg("min_quality") = 0,
+             py::call_guard<py::gil_scoped_release>(),
+             R"pbdoc(
+                 add(source, min_quality=0)
+
+                 Sketch every k-mer of `source` — a FastaReader or a FASTA/FASTQ
+                 path — into this sketch, with the GIL released. K-mers with
+                 non-ACGT bases, or covering a FASTQ base below min_quality
+                 (Phred+33), are skipped.
+             )pbdoc")
+        .def("add",
+             [](sketch_t& s, const std::string& path, unsigned min_quality) {
+                 auto reader = pygg::open_kmer_source(path);
+                 s.add_reader(reader, min_quality);
+             },
+             py::arg("source"), py::arg("min_quality") = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("add_sequence",
+             [](sketch_t& s, std::string_view sequence) { s.add_sequence(sequence); },
+             py::arg("sequence"), py::call_guard<py::gil_scoped_release>(),
+             "Sketch every k-mer of one sequence (str).")
+        .def("jaccard", &sketch_t::jaccard, py::arg("other"),
+             R"pbdoc(
+                 Estimated Jaccard similarity with another sketch: the share of
+                 the union's bottom-s hashes held by both (s the smaller size).
+                 Raises ValueError if k or canonical mode differ.
+             )pbdoc")
+        .def("containment", &sketch_t::containment, py::arg("other"),
+             R"pbdoc(
+                 Estimated fraction of this sketch's k-mers contained in other's
+                 set — screening a small query against a large sample. Raises
+                 ValueError if k or canonical mode differ.
+             )pbdoc");
+
+    py::class_<index_t>(m, "SketchIndex", R"pbdoc(
+        An index of named MinHash sketches for screening a query sketch
+        against many samples.
+
+        Backed by a private KmerGrove of postings — one Kmer(hash, 32) key per
+        distinct hash, listing the samples that hold it — so a query costs one
+        point lookup per query hash, and shared hashes are counted per sample
+        from the postings. add() merges the new sketch into the postings and
+        bulk-loads them in one pass over the index.
+
+        Parameters
+        ----------
+        k : int, optional
+            K-mer length of the sketches it accepts (default: 21).
+        canonical : bool, optional
+            Canonical mode of the sketches it accepts (default: True).
+        order : int, optional
+            B+ tree order of the backing grove.
+    )pbdoc")
+        .def(py::init<unsigned, bool, std::optional<int>>(), py::arg("k") = 21,
+             py::arg("canonical") = true, py::arg("order") = py::none())
+        .def_property_readonly("k", &index_t::k, "K-mer length of indexed sketches.")
+        .def_property_readonly("canonical", &index_t::canonical,
+                               "Canonical mode of indexed sketches.")
+        .def_property_readonly("names", &index_t::names,
+                               "Sample names, indexed by sample id.")
+        .def("__len__", &index_t::sample_count, "Number of indexed samples.")
+        .def("sketch", &index_t::sketch, py::arg("id"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Sample id's sketch, gathered from the postings (one pass over the "
+             "index).")
+        .def("add", &index_t::add, py::arg("name"), py::arg("sketch"),
+             py::call_guard<py::gil_scoped_release>(),
+             R"pbdoc(
+                 add(name, sketch) -> int
+
+                 Index a sample's sketch under a unique name; returns its sample
+                 id. The sketch's hashes are merged into the postings and the
+                 index is bulk-loaded again, one pass over it. Raises ValueError
+                 for a duplicate name or a sketch whose k / canonical mode
+                 differ from the index.
+             )pbdoc")
+        .def("query", &index_t::query, py::arg("sketch"), py::arg("min_shared") = 1,
+             py::call_guard<py::gil_scoped_release>(),
+             R"pbdoc(
+                 query(sketch, min_shared=1)
+                     -> list[tuple[str, int, float, float]]
+
+                 Samples sharing at least min_shared hashes with the query, as
+                 (name, shared, containment, jaccard) sorted by Jaccard estimate,
+                 highest first. Only the query's hashes are looked up.
+                 containment is the estimated fraction of the query's k-mers
+                 found in the sample (as MinHashSketch.containment); jaccard is
+                 estimated over the hash range both sketches cover, from the
+                 shared count and each sample's size and largest hash.
+             )pbdoc");
+}
@@ -0,0 +1,81 @@
+"""
+Tests for PackedSequence — 2-bit DNA with an N-run sidecar: encode / decode
+round-trip, masking, reverse complement, GC content, and k-mer extraction
+agreeing with Kmer encodings. The FASTA producers (to_packed / fetch_packed)
+are covered next to their readers in tests/io.
+"""
+
+import math
+
+import pytest
+
+
+def _pg():
+    return pytest.importorskip("pygenogrove")
+
+
+def _revcomp(s):
+    return s[::-1].translate(str.maketrans("ACGTN", "TGCAN"))
+
+
+def test_roundtrip_and_masking():
+    pg = _pg()
+    p = pg.PackedSequence("acgtNNACGTRYacgtac", name="chr1")
+    assert len(p) == 18
+    assert p.name == "chr1"
+    # case is folded and every non-ACGT base decodes as N
+    assert str(p) == "ACGTNNACGTNNACGTAC"
+    assert p.n_count() == 4
+    assert p.n_runs().tolist() == [[4, 6], [10, 12]]
+    assert len(bytes(p.packed)) == 5  # ceil(18 / 4)
+    assert pg.PackedSequence(b"ACGT") == pg.PackedSequence("acgt")
+
+
+def test_reverse_complement():
+    pg = _pg()
+    for seq in ["", "A", "ACG", "ACGTN", "GATTACANNNCCGGTTA" * 3]:
+        p = pg.PackedSequence(seq)
+        rc = p.reverse_complement()
+        assert str(rc) == _revcomp(seq)
+        assert rc.reverse_complement() == p
+
+
+def test_gc_content():
+    pg = _pg()
+    assert pg.PackedSequence("GGCCAATT").gc_content() == 0.5
+    p = pg.PackedSequence("GCNNNA")
+    assert p.gc_count() == 2
+    assert p.gc_content() == pytest.approx(2 / 3)
+    assert math.isnan(pg.PackedSequence("NNN").gc_content())
+
+
+def test_kmers_match_kmer_encoding():
+    pytest.importorskip("numpy")
+    pg = _pg()
+    seq = "ACGTTGCANACGGT"
+    enc, pos = pg.PackedSequence(seq).kmers(3, positions=True)
+    expected = [(i, seq[i:i + 3]) for i in range(len(seq) - 2)
+                if "N" not in seq[i:i + 3]]
+    assert pos.tolist() == [i for i, _ in expected]
+    assert enc.tolist() == [pg.Kmer(w).encoding for _, w in expected]
+
+
+def test_canonical_and_step():
+    pytest.importorskip("numpy")
+    pg = _pg()
+    seq = "AAACCCGGGTTT"
+    canon = pg.PackedSequence(seq).kmers(4, canonical=True).tolist()
+    for i, e in enumerate(canon):
+        w = seq[i:i + 4]
+        assert e == min(pg.Kmer(w).encoding, pg.Kmer(_revcomp(w)).encoding)
+    _, pos = pg.PackedSequence(seq).kmers(4, step=3, positions=True)
+    assert pos.tolist() == [0, 3, 6]
+
+
+def test_kmers_rejects_bad_k():
+    pg = _pg()
+    p = pg.PackedSequence("ACGT")
+    with pytest.raises(ValueError):
+        p.kmers(0)
+    with pytest.raises(ValueError):
+        p.kmers(33)
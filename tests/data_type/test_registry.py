@@ -8,10 +8,11 @@ its own payload, so get(id) returns the string back (plain string interning).
 
 Ports the behaviourally-observable cases from genogrove
 tests/data_type/registry_test.cpp (both the key == payload and key -> payload
-forms), plus the JSON round-trip specific to this binding. Registry is a
-process-wide singleton, so each test resets it first (autouse fixture) for
-isolation. Tagged / concurrency cases are out of scope (not bound / not
-Python-testable).
+forms), plus the JSON round-trip specific to this binding. Registry.instance()
+is a process-wide singleton, so each test resets it first (autouse fixture) for
+isolation; Registry() instances and the read-only MappedRegistry are covered at
+the end. Tagged cases are out of scope (not bound); concurrency is covered
+through intern_many and interning from Python threads.
 """
 
 import pytest
@@ -249,9 +250,146 @@ def test_deserialize_replaces_existing_data(tmp_path):
     assert r.find("OTHER") is None
 
 
+def test_serialize_keeps_gdt_registry_layout(tmp_path):
+    """The file is the gdt::registry layout (an entry count first); files with
+    the interim PGGREG header still load."""
+    import struct
+
+    pg = _pg()
+    r = pg.Registry()
+    r.intern("ENSG001", {"name": "BRCA2"})
+    r.intern("ENSG002")
+    path = tmp_path / "genes.gg"
+    r.serialize(str(path))
+    body = path.read_bytes()
+    assert struct.unpack("<Q", body[:8]) == (2,)
+
+    legacy = tmp_path / "legacy.gg"
+    legacy.write_bytes(b"PGGREG\0\1" + body)
+    b = pg.Registry()
+    b.load(str(legacy))
+    assert len(b) == 2 and b.get(b.find("ENSG001")) == {"name": "BRCA2"}
+
+
 def test_serialize_open_failure_raises():
     pg = _pg()
     r = pg.Registry.instance()
     r.intern("ENSG001", {"name": "BRCA2"})
     with pytest.raises(RuntimeError):
-        r.serialize("/nonexistent_dir_xyz/reg.gg")
\ No newline at end of file
+        r.serialize("/nonexistent_dir_xyz/reg.gg")
+
+
+# --- batch / concurrent interning ------------------------------------------------
+
+
+def test_intern_many_matches_sequential_intern():
+    pg = _pg()
+    np = pytest.importorskip("numpy")
+    r = pg.Registry.instance()
+    r.intern("chr1")
+    names = [f"gene{i % 700}" for i in range(20000)] + ["chr1"]
+    ids = r.intern_many(names, threads=4)
+    assert ids.dtype == np.uint32
+    assert ids[-1] == 0                        # existing ids are kept
+    assert ids[0] == 1 and ids[1] == 2         # new ids in input order
+    assert len(r) == 701
+    assert ids.tolist() == [r.find(n) for n in names]
+    assert r.get(int(ids[5])) == "gene5"       # string is its own payload
+    assert r.intern_many([]).size == 0
+
+
+def test_intern_many_numpy_bytes_array():
+    pg = _pg()
+    np = pytest.importorskip("numpy")
+    r = pg.Registry.instance()
+    arr = np.array([b"ENSG1", b"ENSG22", b"ENSG1"], dtype="S6")
+    assert r.intern_many(arr).tolist() == [0, 1, 0]
+    assert r.get(1) == "ENSG22"                # NUL padding stripped
+    assert r.intern_many(np.array(["ENSG22", "x"])).tolist() == [1, 2]
+
+
+def test_concurrent_interns_agree():
+    import threading
+
+    pg = _pg()
+    r = pg.Registry.instance()
+    names = [f"read{i % 997}" for i in range(5000)]
+    results = [None] * 4
+
+    def work(t):
+        if t % 2:
+            results[t] = [r.intern(n) for n in names]
+        else:
+            results[t] = r.intern_many(names, threads=2).tolist()
+
+    threads = [threading.Thread(target=work, args=(t,)) for t in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert all(res == results[0] for res in results)
+    assert len(r) == 997
+    assert all(r.get(i) == n for i, n in zip(results[0], names))
+
+
+def test_independent_instances():
+    pg = _pg()
+    a = pg.Registry()
+    b = pg.Registry()
+    assert a.intern("chr1") == 0 and a.intern("chr2") == 1
+    assert b.intern("chr2") == 0               # own id namespace
+    assert b.find("chr1") is None
+    assert len(pg.Registry.instance()) == 0    # the singleton is untouched
+
+
+def test_load_into_instance(tmp_path):
+    pg = _pg()
+    a = pg.Registry()
+    a.intern("ENSG1", {"name": "BRCA2"})
+    a.intern("ENSG2", {"name": "TP53"})
+    path = str(tmp_path / "reg.bin")
+    a.serialize(path)
+    b = pg.Registry()
+    b.intern("other")
+    b.load(path)
+    assert len(b) == 2 and b.find("other") is None
+    assert b.get(b.find("ENSG2")) == {"name": "TP53"}
+
+
+def test_mapped_registry_round_trip(tmp_path):
+    pg = _pg()
+    r = pg.Registry()
+    names = [f"gene{(i * 7919) % 1000}" for i in range(1000)]  # unsorted
+    for n in names:
+        r.intern(n)
+    g = r.intern("ENSG001", {"name": "BRCA2", "biotype": "protein_coding"})
+    path = str(tmp_path / "names.reg")
+    r.write_mapped(path)
+
+    m = pg.MappedRegistry(path)
+    assert len(m) == len(r) == 1001 and not m.empty()
+    assert m.mapped_bytes > 0
+    assert all(m.find(n) == r.find(n) for n in names)
+    assert m.find("gene") is None and m.find("zzz") is None and m.find("") is None
+    assert m.get(g) == {"name": "BRCA2", "biotype": "protein_coding"}
+    assert m.key(g) == "ENSG001" and m.get(0) == names[0]
+    assert m.contains(1000) and not m.contains(1001)
+    with pytest.raises(IndexError):
+        m.get(1001)
+
+    copy = m.to_registry()
+    assert len(copy) == 1001 and copy.find("gene7") == r.find("gene7")
+    assert copy.intern("new") == 1001
+
+
+def test_mapped_registry_empty_and_bad_file(tmp_path):
+    pg = _pg()
+    path = str(tmp_path / "empty.reg")
+    pg.Registry().write_mapped(path)
+    m = pg.MappedRegistry(path)
+    assert len(m) == 0 and m.empty() and m.find("x") is None
+
+    bad = tmp_path / "bad.reg"
+    bad.write_bytes(b"not a registry table at all, really")
+    with pytest.raises(RuntimeError):
+        pg.MappedRegistry(str(bad))
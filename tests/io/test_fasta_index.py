@@ -106,4 +106,120 @@ def test_pairs_with_genomic_coordinate(tmp_path):
     idx = _index(pg, tmp_path)
     # A '+'-strand feature spanning bases [4, 7] of chr1 (closed) -> fetch(name, 4, 8).
     gc = pg.GenomicCoordinate("+", 4, 7)
-    assert idx.fetch("chr1", gc.start, gc.end + 1) == "ACGT"
\ No newline at end of file
+    assert idx.fetch("chr1", gc.start, gc.end + 1) == "ACGT"
+
+
+def test_fetch_many_input_order_and_strands(tmp_path):
+    pg = _pg()
+    idx = _index(pg, tmp_path)
+    seqs = idx.fetch_many(["chr2", "chr1", "chr1", "chr2"], [0, 4, 0, 8],
+                          [4, 8, 3, 12], strands=["+", "-", ".", "-"])
+    # chr1[4:8] = ACGT (its own revcomp); chr2[8:12] = CCCC -> GGGG
+    assert seqs == ["TTTT", "ACGT", "ACG", "GGGG"]
+    # coalescing must not change what is returned
+    assert idx.fetch_many(["chr1", "chr1"], [0, 4], [3, 8], max_gap=0) == \
+        ["ACG", "ACGT"]
+
+
+def test_fetch_many_concat_with_numpy(tmp_path):
+    np = pytest.importorskip("numpy")
+    pg = _pg()
+    idx = _index(pg, tmp_path)
+    buf, offsets = idx.fetch_many(["chr1", "chr2"], np.array([0, 12]),
+                                  np.array([2, 16]), concat=True)
+    assert buf == b"ACGGGG"
+    assert offsets.tolist() == [0, 2, 6]
+
+
+def test_fetch_many_errors(tmp_path):
+    pg = _pg()
+    idx = _index(pg, tmp_path)
+    with pytest.raises(ValueError):
+        idx.fetch_many(["chr1"], [0, 1], [2, 3])
+    with pytest.raises(IndexError):
+        idx.fetch_many(["chrX"], [0], [4])
+    with pytest.raises(IndexError):
+        idx.fetch_many(["chr1"], [4], [4])
+
+
+def test_fetch_many_from_query_result(tmp_path):
+    pg = _pg()
+    idx = _index(pg, tmp_path)
+    g = pg.Grove()
+    g.insert("chr2", pg.GenomicCoordinate("+", 0, 3))
+    g.insert("chr2", pg.GenomicCoordinate("-", 8, 11))
+    res = g.intersect(pg.GenomicCoordinate("*", 0, 15), "chr2")
+    assert sorted(idx.fetch_many(res, "chr2")) == ["GGGG", "TTTT"]
+
+
+def test_shared_index_concurrent_fetch(tmp_path):
+    """One FastaIndex fetched from many threads at once (per-fetch handle pool)."""
+    from concurrent.futures import ThreadPoolExecutor
+
+    pg = _pg()
+    idx = _index(pg, tmp_path)
+
+    def work(i):
+        return [idx.fetch("chr2", j % 12, j % 12 + 4) for j in range(i, i + 200)]
+
+    with ThreadPoolExecutor(max_workers=8) as pool:
+        results = list(pool.map(work, range(16)))
+    expected = "TTTTAAAACCCCGGGG"
+    for i, seqs in enumerate(results):
+        assert seqs == [expected[j % 12:j % 12 + 4] for j in range(i, i + 200)]
+    assert 1 <= idx.handle_count() <= 8
+
+
+def test_fetch_many_threads_matches_serial(tmp_path):
+    pg = _pg()
+    idx = _index(pg, tmp_path)
+    names = ["chr1", "chr2"] * 500
+    starts = [i % 16 for i in range(1000)]
+    ends = [s + 4 for s in starts]
+    strands = ["+", "-", "."] * 333 + ["+"]
+    serial = idx.fetch_many(names, starts, ends, strands=strands, max_gap=0)
+    assert idx.fetch_many(names, starts, ends, strands=strands, max_gap=0,
+                          threads=4) == serial
+
+
+_MULTILINE = ">chr1\nACGTACG\nTACgtAC\nGTACGTA\n>chr2\nTTTTAAAACCCC\nGGGG\n>empty\n"
+
+
+@pytest.mark.parametrize("mode", ["mmap", "resident"])
+def test_in_memory_modes_match_faidx(tmp_path, mode):
+    pg = _pg()
+    p = tmp_path / "multi.fa"
+    p.write_text(_MULTILINE)
+    ref = pg.FastaIndex(str(p))
+    idx = pg.FastaIndex(str(p), mode=mode)
+    assert idx.mode == mode and ref.mode == "faidx"
+    assert idx.memory_bytes() > 0 and ref.memory_bytes() == 0
+    # region crossing line breaks, case preserved, clipped at the end
+    for name, start, end in [("chr1", 3, 19), ("chr1", 18, 40), ("chr2", 10, 14)]:
+        assert idx.fetch(name, start, end) == ref.fetch(name, start, end)
+    assert idx.fetch("chr1", 7, 12) == "TACgt"
+    assert idx.fetch("chr2") == "TTTTAAAACCCCGGGG"
+    assert idx.fetch_many(["chr1", "chr2"], [0, 12], [4, 16],
+                          strands=["-", "+"]) == ["ACGT", "GGGG"]
+    with pytest.raises(IndexError):
+        idx.fetch("chrX", 0, 4)
+    with pytest.raises(IndexError):
+        idx.fetch("chr1", 5, 5)
+
+
+def test_mode_validation(tmp_path):
+    pg = _pg()
+    p = tmp_path / "genome.fa"
+    p.write_text(_FASTA)
+    with pytest.raises(ValueError):
+        pg.FastaIndex(str(p), mode="bogus")
+
+
+def test_fetch_packed(tmp_path):
+    pg = _pg()
+    idx = _index(pg, tmp_path)
+    p = idx.fetch_packed("chr2")
+    assert p.name == "chr2" and len(p) == 16
+    assert str(p) == "TTTTAAAACCCCGGGG"
+    assert str(idx.fetch_packed("chr2", 8, 12)) == "CCCC"
+    assert str(idx.fetch_packed("chr2", start=12)) == "GGGG"
@@ -69,6 +69,23 @@ def test_fasta_entry_construct():
     assert e.quality is None
 
 
+def test_fasta_entry_views_pin_their_bytes():
+    pg = _pg()
+    e = pg.FastaEntry("r1", "ACGT")
+    e.quality = "IIII"
+    e.sequence = "ACGTA"                               # writable while no view exists
+    e.sequence = "ACGT"
+    v = e.sequence_view
+    with pytest.raises(BufferError):
+        e.sequence = "A"
+    with pytest.raises(BufferError):
+        e.quality = None
+    assert bytes(v) == b"ACGT" and e.quality == "IIII"
+    del v
+    e.sequence = "TT"
+    assert e.sequence == "TT" and bytes(e.sequence_view) == b"TT"
+
+
 def test_clean_eof_error_message(tmp_path):
     pg = _pg()
     r = pg.FastaReader(_write(tmp_path, "x.fa", _FASTA))
@@ -79,4 +96,67 @@ def test_clean_eof_error_message(tmp_path):
 def test_missing_file_raises():
     pg = _pg()
     with pytest.raises((RuntimeError, IOError, OSError)):
-        pg.FastaReader("/nonexistent_dir_xyz/genome.fa")
\ No newline at end of file
+        pg.FastaReader("/nonexistent_dir_xyz/genome.fa")
+
+
+def test_sequence_and_quality_views(tmp_path):
+    pg = _pg()
+    r = next(iter(pg.FastaReader(_write(tmp_path, "x.fq", _FASTQ))))
+    seq = r.sequence_view
+    assert isinstance(seq, memoryview)
+    assert seq.readonly
+    assert bytes(seq) == b"ACGT"
+    assert r.quality_view.tobytes() == b"IIII"
+    del r  # the view keeps the entry alive
+    assert bytes(seq) == b"ACGT"
+
+    fa = next(iter(pg.FastaReader(_write(tmp_path, "x.fa", _FASTA))))
+    assert fa.quality_view is None
+    assert len(fa.sequence_view) == 8
+
+
+def test_chunked_fasta(tmp_path):
+    pg = _pg()
+    path = _write(tmp_path, "c.fa", ">s1 desc\nACGTA\nCG\n>empty\n>s2\nTTTT\n")
+    chunks = list(pg.FastaReader(path, chunk_size=3))
+    assert [(c.name, c.start, c.sequence, c.last) for c in chunks] == [
+        ("s1", 0, "ACG", False),
+        ("s1", 3, "TAC", False),
+        ("s1", 6, "G", True),
+        ("empty", 0, "", True),
+        ("s2", 0, "TTT", False),
+        ("s2", 3, "T", True),
+    ]
+    assert chunks[0].comment == "desc"
+    assert chunks[1].end == 6
+    assert bytes(chunks[1].sequence_view) == b"TAC"
+
+    kept = list(pg.FastaReader(path, chunk_size=3, skip_empty_sequences=True))
+    assert "empty" not in {c.name for c in kept}
+
+
+def test_chunked_fastq_slices_quality(tmp_path):
+    pg = _pg()
+    path = _write(tmp_path, "c.fq", "@r1\nACGTA\n+\n@IIIJ\n")
+    chunks = list(pg.FastaReader(path, chunk_size=2))
+    assert [(c.sequence, c.quality) for c in chunks] == [
+        ("AC", "@I"), ("GT", "II"), ("A", "J")]
+    assert chunks[-1].last
+
+
+def test_chunked_rejects_bad_input(tmp_path):
+    pg = _pg()
+    with pytest.raises(ValueError):
+        pg.FastaReader(_write(tmp_path, "x.fa", _FASTA), chunk_size=0)
+    with pytest.raises(RuntimeError):
+        list(pg.FastaReader(_write(tmp_path, "bad.fa", "ACGT\n"), chunk_size=2))
+
+
+def test_entry_and_chunk_to_packed(tmp_path):
+    pg = _pg()
+    path = _write(tmp_path, "p.fa", ">s1\nACGTNNacgt\n")
+    p = next(iter(pg.FastaReader(path))).to_packed()
+    assert p.name == "s1"
+    assert str(p) == "ACGTNNACGT"
+    chunks = [c.to_packed() for c in pg.FastaReader(path, chunk_size=4)]
+    assert [str(c) for c in chunks] == ["ACGT", "NNAC", "GT"]
@@ -0,0 +1,130 @@
+"""
+Tests for annotate_vcf — streaming a VCF through a BED/GFF grove (or a
+GroveView over one) and writing overlapping features' fields as INFO tags or
+TSV columns.
+"""
+
+import gzip
+
+import pytest
+
+
+def _pg():
+    return pytest.importorskip("pygenogrove")
+
+
+_VCF = "\n".join([
+    "##fileformat=VCFv4.2",
+    "##contig=<ID=chr1,length=10000>",
+    "##contig=<ID=chr2,length=10000>",
+    '##INFO=<ID=DP,Number=1,Type=Integer,Description="Total Depth">',
+    "\t".join(["#CHROM", "POS", "ID", "REF", "ALT", "QUAL", "FILTER", "INFO"]),
+    # 0-based 100: inside geneA [100, 199] only
+    "\t".join(["chr1", "101", "rs1", "A", "G", "50", "PASS", "DP=30"]),
+    # 0-based 160, inside both geneA and geneB
+    "\t".join(["chr1", "161", "rs2", "C", "T", "50", "PASS", "DP=12"]),
+    # deletion spanning [498, 500] reaches geneC starting at 500
+    "\t".join(["chr1", "499", ".", "ACG", "A", ".", "PASS", "DP=5"]),
+    # no feature on chr2
+    "\t".join(["chr2", "50", "rs4", "G", "A", "50", "PASS", "DP=7"]),
+    "",
+])
+
+
+def _write_vcf(tmp_path):
+    p = tmp_path / "calls.vcf"
+    p.write_text(_VCF)
+    return str(p)
+
+
+def _bed_grove(pg):
+    g = pg.BedGrove()
+    for name, start, end in [("geneA", 100, 200), ("geneB", 150, 300),
+                             ("geneC", 500, 600)]:
+        e = pg.BedEntry("chr1", start, end)
+        e.name = name
+        g.insert("chr1", pg.GenomicCoordinate(".", start, end - 1), e)
+    return g
+
+
+def _gff_grove(pg):
+    g = pg.GffGrove()
+    e = pg.GffEntry("chr1", 100, 200, "gene")
+    e.attributes = {"gene_id": "ENSG1", "gene_name": "ALPHA ONE"}
+    g.insert("chr1", pg.GenomicCoordinate("+", 100, 199), e)
+    return g
+
+
+def _records(path):
+    return [line.split("\t") for line in open(path).read().splitlines()
+            if not line.startswith("#")]
+
+
+def test_annotates_info_from_bed_grove(tmp_path):
+    pg = _pg()
+    out = str(tmp_path / "out.vcf")
+    stats = pg.annotate_vcf(_write_vcf(tmp_path), _bed_grove(pg), out)
+    assert stats == (4, 3)
+
+    text = open(out).read()
+    assert "##INFO=<ID=name," in text
+    info = [r[7] for r in _records(out)]
+    assert info == ["DP=30;name=geneA", "DP=12;name=geneA,geneB",
+                    "DP=5;name=geneC", "DP=7"]
+
+
+def test_fields_and_prefix(tmp_path):
+    pg = _pg()
+    out = str(tmp_path / "out.vcf")
+    pg.annotate_vcf(_write_vcf(tmp_path), _gff_grove(pg), out,
+                    fields=["gene_id", "gene_name", "type"], info_prefix="GG_")
+    first = _records(out)[0][7]
+    # unstranded VCF records match a '+' feature; spaces are INFO-escaped
+    assert first == "DP=30;GG_gene_id=ENSG1;GG_gene_name=ALPHA_ONE;GG_type=gene"
+
+
+def test_default_gff_field_is_gene_id(tmp_path):
+    pg = _pg()
+    out = str(tmp_path / "out.vcf")
+    assert pg.annotate_vcf(_write_vcf(tmp_path), _gff_grove(pg), out) == (4, 2)
+    assert _records(out)[1][7] == "DP=12;gene_id=ENSG1"
+
+
+def test_tsv_output(tmp_path):
+    pg = _pg()
+    out = str(tmp_path / "out.tsv")
+    pg.annotate_vcf(_write_vcf(tmp_path), _bed_grove(pg), out, output="tsv")
+    lines = open(out).read().splitlines()
+    assert lines[0] == "#CHROM\tPOS\tID\tREF\tALT\tname"
+    assert lines[2] == "chr1\t161\trs2\tC\tT\tgeneA,geneB"
+    assert lines[4] == "chr2\t50\trs4\tG\tA\t."
+
+
+def test_accepts_grove_view(tmp_path):
+    pg = _pg()
+    gg = str(tmp_path / "genes.gg")
+    _bed_grove(pg).serialize(gg)
+    view = pg.BedGroveView.open(gg)
+    out = str(tmp_path / "out.vcf")
+    assert pg.annotate_vcf(_write_vcf(tmp_path), view, out) == (4, 3)
+    assert _records(out)[2][7] == "DP=5;name=geneC"
+
+
+def test_bgzip_output_reads_back(tmp_path):
+    pg = _pg()
+    out = str(tmp_path / "out.vcf.gz")
+    pg.annotate_vcf(_write_vcf(tmp_path), _bed_grove(pg), out, threads=2)
+    assert len(list(pg.VcfReader(out))) == 4
+    with gzip.open(out, "rt") as fh:
+        info = [line.split("\t")[7] for line in fh if not line.startswith("#")]
+    assert info[1] == "DP=12;name=geneA,geneB"
+
+
+def test_bad_output_mode_and_missing_input(tmp_path):
+    pg = _pg()
+    with pytest.raises(ValueError):
+        pg.annotate_vcf(_write_vcf(tmp_path), _bed_grove(pg),
+                        str(tmp_path / "o"), output="bed")
+    with pytest.raises(RuntimeError):
+        pg.annotate_vcf(str(tmp_path / "missing.vcf"), _bed_grove(pg),
+                        str(tmp_path / "o.vcf"))
@@ -187,3 +187,85 @@ def test_empty_region_reads_all(tmp_path):
     pg = _pg()
     gz = _bgzip_tabix_vcf(tmp_path)
     assert len(list(pg.VcfReader(gz, region=""))) == 2
+
+
+def test_info_fields_selector(tmp_path):
+    pg = _pg()
+    a = next(iter(pg.VcfReader(_write_vcf(tmp_path), info_fields=["DP"])))
+    assert a.info == {"DP": [30]}
+    a = next(iter(pg.VcfReader(_write_vcf(tmp_path), info_fields=[])))
+    assert a.info == {}
+
+
+def test_samples_selector_reorders_and_subsets(tmp_path):
+    pg = _pg()
+    reader = pg.VcfReader(_write_vcf(tmp_path), samples=["S2"])
+    assert reader.get_sample_names() == ["S2"]
+    a = next(iter(reader))
+    assert [s.gt_string() for s in a.samples] == ["1|1"]
+
+    reader = pg.VcfReader(_write_vcf(tmp_path), samples=["S2", "S1"])
+    a = next(iter(reader))
+    assert [s.gt_string() for s in a.samples] == ["1|1", "0/1"]
+
+
+def test_samples_selector_keeps_fields_and_header(tmp_path):
+    pg = _pg()
+    reader = pg.VcfReader(_write_vcf(tmp_path), samples=["S2"], info_fields=["DP"])
+    a, b = list(reader)
+    assert a.info == {"DP": [30]}
+    assert list(a.format) == ["GT", "DP"]
+    assert a.samples[0].fields["DP"] == [25]
+    assert [s.gt_string() for s in b.samples] == ["./."]
+    # The header text is the file's, not the narrowed one.
+    assert reader.get_header().rstrip().endswith("S1\tS2")
+    assert reader.get_current_line() == 2
+
+
+def test_samples_selector_unknown_name_raises(tmp_path):
+    pg = _pg()
+    with pytest.raises(ValueError):
+        pg.VcfReader(_write_vcf(tmp_path), samples=["S9"])
+
+
+def test_samples_selector_duplicate_name_raises(tmp_path):
+    pg = _pg()
+    with pytest.raises(ValueError):
+        pg.VcfReader(_write_vcf(tmp_path), samples=["S1", "S1"])
+
+
+def test_format_fields_selector_keeps_gt(tmp_path):
+    pg = _pg()
+    a = next(iter(pg.VcfReader(_write_vcf(tmp_path), format_fields=[])))
+    assert list(a.format) == ["GT"]
+    assert a.samples[0].fields == {}
+    assert a.samples[0].gt_string() == "0/1"  # GT is always decoded
+
+
+def test_read_genotypes_matrix(tmp_path):
+    pg = _pg()
+    np = pytest.importorskip("numpy")
+    reader = pg.VcfReader(_write_vcf(tmp_path))
+    dosage, phased = reader.read_genotypes(10)
+    assert dosage.dtype == np.int8 and phased.dtype == np.bool_
+    # Rows are records, columns samples: 0/1 1|1 ; 0/0 ./.
+    assert dosage.tolist() == [[1, 2], [0, -1]]
+    assert phased.tolist() == [[False, True], [False, False]]
+    # Exhausted: an empty batch with the sample width preserved.
+    dosage, phased = reader.read_genotypes(10)
+    assert dosage.shape == (0, 2)
+
+
+def test_read_genotypes_batches_and_selection(tmp_path):
+    pg = _pg()
+    pytest.importorskip("numpy")
+    reader = pg.VcfReader(_write_vcf(tmp_path), samples=["S2"], skip_filtered=True)
+    dosage, _ = reader.read_genotypes(1)
+    assert dosage.tolist() == [[2]]
+    assert reader.read_genotypes(1)[0].shape == (0, 1)  # the q10 record is dropped
+
+
+def test_read_genotypes_requires_samples(tmp_path):
+    pg = _pg()
+    with pytest.raises(ValueError):
+        pg.VcfReader(_write_vcf(tmp_path), parse_samples=False).read_genotypes(1)
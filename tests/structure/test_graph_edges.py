@@ -5,6 +5,8 @@ Tests for the completed graph overlay on the universal Grove:
     get_edges, get_neighbors_if, link_with.
   * edge removal / bulk linking (#2, available on every grove): remove_edges_from,
     remove_edges_to, remove_all_edges, clear_graph, graph_empty, link_if.
+  * bulk edge creation: add_edges from Keys or key ids, with per-edge or
+    columnar metadata.
 
 Mirrors genogrove graph_overlay_test.cpp's metadata + link_if cases. The basic
 unlabelled edge surface (add_edge/remove_edge/has_edge/get_neighbors/…) is
@@ -375,5 +377,100 @@ def test_labelled_edge_key_keeps_grove_alive():
     assert nbr.value.start == 300
 
 
+def test_add_edges_from_keys_with_per_edge_data():
+    pg = _pg()
+    g = pg.Grove()
+    a, b, c = _chain(g, (100, 200), (300, 400), (500, 600))
+    assert g.add_edges([a, a, b], [b, c, c], [{"w": 1}, {"w": 2}, None]) == 3
+    assert g.get_edges(a) == [{"w": 1}, {"w": 2}]
+    assert g.get_edge_list(b)[0][1] is None
+    assert g.edge_count() == 3
+
+
+def test_add_edges_from_ids_with_columnar_data():
+    pg = _pg()
+    np = pytest.importorskip("numpy")
+    g = pg.Grove()
+    keys = _chain(g, (100, 200), (300, 400), (500, 600), (700, 800))
+    src = np.array([0, 1, 2], dtype=np.int32)
+    tgt = np.array([1, 2, 3], dtype=np.int64)
+    n = g.add_edges(src, tgt, keys=keys,
+                    data={"weight": np.array([0.5, 1.0, 2.25]),
+                          "n": np.array([1, 2, 3]),
+                          "ok": np.array([True, False, True]),
+                          "type": ["exon", "intron", "exon"]})
+    assert n == 3
+    assert g.get_edges(keys[1]) == [{"weight": 1.0, "n": 2, "ok": False, "type": "intron"}]
+    assert g.has_edge(keys[2], keys[3]) and not g.has_edge(keys[0], keys[2])
+
+
+def test_add_edges_validation():
+    pg = _pg()
+    g = pg.Grove()
+    a, b = _chain(g, (100, 200), (300, 400))
+    with pytest.raises(ValueError):
+        g.add_edges([a], [a, b])                      # length mismatch
+    with pytest.raises(ValueError):
+        g.add_edges([0], [1])                         # ids without keys
+    with pytest.raises(IndexError):
+        g.add_edges([0], [5], keys=[a, b])            # id out of range
+    with pytest.raises(ValueError):
+        g.add_edges([a], [b], data={"w": [1, 2]})     # column length
+    with pytest.raises(TypeError):
+        g.add_edges([a, None], [b, b])
+    assert g.edge_count() == 0
+
+
+# --------------------------------------------------------------------------- #
+# Overlap-graph construction (link_overlaps)
+# --------------------------------------------------------------------------- #
+
+def test_link_overlaps_links_overlapping_pairs():
+    pg = _pg()
+    g = pg.Grove()
+    a, b, c, d = _chain(g, (100, 200), (150, 250), (180, 190), (251, 300))
+    assert g.link_overlaps("chr1") == 3               # a-b, a-c, b-c; d is book-ended
+    assert g.has_edge(a, b) and g.has_edge(a, c) and g.has_edge(b, c)
+    assert not g.has_edge(b, a) and g.out_degree(d) == 0
+    assert g.get_edges(a) == [None, None]
+
+
+def test_link_overlaps_max_gap_and_strand():
+    pg = _pg()
+    g = pg.Grove()
+    a = g.insert("chr1", pg.GenomicCoordinate("+", 100, 200))
+    b = g.insert("chr1", pg.GenomicCoordinate("-", 150, 250))
+    c = g.insert("chr1", pg.GenomicCoordinate("+", 260, 300))
+    assert g.link_overlaps("chr1", same_strand=True) == 0
+    assert g.link_overlaps("chr1", max_gap=10, same_strand=True) == 0
+    assert g.link_overlaps("chr1", max_gap=10) == 2    # a-b overlap, c within 10 of b
+    assert g.has_edge(b, c) and not g.has_edge(a, c)
+    g.clear_graph()
+    assert g.link_overlaps("chr1", max_gap=60, same_strand=True) == 1
+    assert g.has_edge(a, c)
+
+
+def test_link_overlaps_metadata():
+    pg = _pg()
+    g = pg.Grove()
+    a, b, c = _chain(g, (100, 200), (150, 250), (240, 300))
+    assert g.link_overlaps("chr1", metadata={"kind": "overlap"}) == 2
+    assert g.get_edges(a) == [{"kind": "overlap"}]
+
+    g.clear_graph()
+    overlap = lambda x, y: (x.value.end - y.value.start + 1) if y.value.start > 120 else None
+    assert g.link_overlaps("chr1", metadata=overlap) == 2
+    assert g.get_edges(a) == [51] and g.get_edges(b) == [11]
+
+
+def test_link_overlaps_void_grove():
+    pg = _pg()
+    g = pg.BedGrove(5)
+    keys = [g.insert("chr1", pg.GenomicCoordinate(".", s, e), pg.BedEntry("chr1", s, e))
+            for s, e in [(10, 20), (15, 30), (40, 50)]]
+    assert g.link_overlaps("chr1", max_gap=10) == 2
+    assert g.has_edge(keys[1], keys[2])
+
+
 if __name__ == "__main__":
-    pytest.main([__file__, "-v"])
\ No newline at end of file
+    pytest.main([__file__, "-v"])
@@ -0,0 +1,294 @@
+"""
+Tests for the native graph traversals — bfs / reachable / shortest_path /
+k_hop_neighborhood — on the universal Grove and on a GroveView over its .gg
+(which pages target blocks in as the walk reaches them).
+"""
+
+import pytest
+
+
+def _pg():
+    return pytest.importorskip("pygenogrove")
+
+
+def _graph(pg, g):
+    """0 -> 1, 0 -> 2, 1 -> 3, 2 -> 3, 2 -> 4 (w=9), 3 -> 0; 5 isolated."""
+    keys = [g.insert("chr1", pg.GenomicCoordinate(".", 100 * i, 100 * i + 50), {"n": i})
+            for i in range(6)]
+    for s, t, w in [(0, 1, 1), (0, 2, 1), (1, 3, 1), (2, 3, 1), (2, 4, 9), (3, 0, 1)]:
+        g.add_edge(keys[s], keys[t], {"w": w})
+    return keys
+
+
+def _ns(keys):
+    return [k.data["n"] for k in keys]
+
+
+def test_bfs_orders_by_depth():
+    pg = _pg()
+    g = pg.Grove()
+    keys = _graph(pg, g)
+    visited, depth = g.bfs(keys[0])
+    assert _ns(visited) == [0, 1, 2, 3, 4]
+    assert depth.tolist() == [0, 1, 1, 2, 2]
+    visited, depth = g.bfs(keys[0], max_depth=1)
+    assert _ns(visited) == [0, 1, 2] and depth.dtype.name == "int32"
+    visited, _ = g.bfs([keys[5], keys[4]])
+    assert _ns(visited) == [5, 4]
+
+
+def test_edge_filter_receives_metadata():
+    pg = _pg()
+    g = pg.Grove()
+    keys = _graph(pg, g)
+    visited, _ = g.bfs(keys[0], edge_filter=lambda m: m["w"] < 5)
+    assert 4 not in _ns(visited)
+    assert g.shortest_path(keys[0], keys[4], edge_filter=lambda m: m["w"] < 5) is None
+
+
+def test_reachable_and_k_hop():
+    pg = _pg()
+    g = pg.Grove()
+    keys = _graph(pg, g)
+    assert sorted(_ns(g.reachable(keys[1]))) == [0, 2, 3, 4]   # source excluded
+    assert g.reachable(keys[5]) == []
+    hood, depth = g.k_hop_neighborhood(keys[0], 1)
+    assert _ns(hood) == [1, 2] and depth.tolist() == [1, 1]
+    hood, depth = g.k_hop_neighborhood(keys[3], 2)
+    assert _ns(hood) == [0, 1, 2] and depth.tolist() == [1, 2, 2]
+    with pytest.raises(ValueError):
+        g.k_hop_neighborhood(keys[0], -1)
+
+
+def test_shortest_path():
+    pg = _pg()
+    g = pg.Grove()
+    keys = _graph(pg, g)
+    assert _ns(g.shortest_path(keys[1], keys[4])) == [1, 3, 0, 2, 4]
+    assert _ns(g.shortest_path(keys[0], keys[0])) == [0]
+    assert g.shortest_path(keys[0], keys[5]) is None
+
+
+def test_traversals_on_grove_view(tmp_path):
+    pg = _pg()
+    g = pg.Grove(4)
+    _graph(pg, g)
+    path = str(tmp_path / "graph.gg")
+    g.serialize(path)
+
+    view = pg.GroveView.open(path)
+    start = [k for k in view.intersect(pg.GenomicCoordinate(".", 0, 10), "chr1")][0]
+    visited, depth = view.bfs(start)
+    assert _ns(visited) == [0, 1, 2, 3, 4] and depth.tolist() == [0, 1, 1, 2, 2]
+    target = visited[-1]
+    assert _ns(view.shortest_path(start, target)) == [0, 2, 4]
+    assert sorted(_ns(view.reachable(start, edge_filter=lambda m: m["w"] < 5))) == [1, 2, 3]
+
+
+def test_freeze_graph_csr_snapshot():
+    pg = _pg()
+    g = pg.Grove()
+    keys = _graph(pg, g)
+    assert not g.graph_frozen()
+    assert g.freeze_graph([keys[1], keys[5]]) == 6     # 1, 5, then the closure
+    assert g.graph_frozen()
+    indptr, indices, order = g.frozen_csr()
+    assert _ns(order) == [1, 5, 3, 0, 2, 4]
+    assert indptr.tolist() == [0, 1, 1, 2, 4, 6, 6]
+    assert indices.tolist() == [2, 3, 0, 4, 2, 5]
+    assert _ns(g.get_neighbors(keys[0])) == [1, 2]
+
+    visited, depth = g.bfs(keys[0], edge_filter=lambda m: m["w"] < 5)
+    assert _ns(visited) == [0, 1, 2, 3] and depth.tolist() == [0, 1, 1, 2]
+    assert _ns(g.shortest_path(keys[1], keys[4])) == [1, 3, 0, 2, 4]
+
+    assert g.shortest_path(keys[1], keys[5]) is None   # 5 has no in-edges
+    g.freeze_graph([keys[2]])                          # 2, 3, 4, 0, 1; not 5
+    assert g.shortest_path(keys[2], keys[5]) is None
+    assert _ns(g.k_hop_neighborhood(keys[2], 1)[0]) == [3, 4]
+
+    g.add_edge(keys[4], keys[5])                       # any edge mutation thaws
+    assert not g.graph_frozen()
+    assert _ns(g.reachable(keys[2])) == [3, 4, 0, 5, 1]
+    with pytest.raises(ValueError):
+        g.frozen_csr()
+
+
+def test_freeze_graph_on_grove_view(tmp_path):
+    pg = _pg()
+    g = pg.Grove(4)
+    _graph(pg, g)
+    path = str(tmp_path / "graph.gg")
+    g.serialize(path)
+
+    view = pg.GroveView.open(path)
+    start = list(view.intersect(pg.GenomicCoordinate(".", 0, 10), "chr1"))
+    assert view.freeze_graph(start) == 5
+    loaded = view.blocks_loaded()
+    visited, _ = view.bfs(start[0])
+    assert _ns(visited) == [0, 1, 2, 3, 4]
+    assert view.blocks_loaded() == loaded              # nothing paged after freezing
+    assert len(view.frozen_csr()[1]) == 6
+
+
+def test_freeze_graph_without_keys(tmp_path):
+    pg = _pg()
+    g = pg.Grove(3)
+    keys = _graph(pg, g)
+    other = g.insert("chr2", pg.GenomicCoordinate(".", 0, 10), {"n": 9})
+    assert g.freeze_graph(index="chr2") == 1
+    assert _ns(g.frozen_csr()[2]) == [9]
+    assert g.freeze_graph() == 7                       # every index, in index order
+    assert _ns(g.frozen_csr()[2]) == [0, 1, 2, 3, 4, 5, 9]
+    assert g.freeze_graph(index="nope") == 0
+    with pytest.raises(ValueError):
+        g.freeze_graph([other], index="chr2")
+
+    path = str(tmp_path / "graph.gg")
+    g.serialize(path)
+    view = pg.GroveView.open(path)
+    assert view.freeze_graph(index="chr1") == 6
+    assert _ns(view.frozen_csr()[2]) == [0, 1, 2, 3, 4, 5]
+
+
+def test_frozen_graph_persists_beside_the_gg(tmp_path):
+    import os
+
+    pg = _pg()
+    g = pg.Grove(3)
+    keys = _graph(pg, g)
+    g.freeze_graph([keys[1], keys[5]])
+    path = str(tmp_path / "graph.gg")
+    g.serialize(path)
+    assert os.path.exists(path + ".csr")
+
+    loaded = pg.Grove.deserialize(path)
+    assert loaded.graph_frozen()
+    indptr, indices, order = loaded.frozen_csr()
+    assert _ns(order) == [1, 5, 3, 0, 2, 4]
+    assert indptr.tolist() == [0, 1, 1, 2, 4, 6, 6] and indices.tolist() == [2, 3, 0, 4, 2, 5]
+
+    plain = pg.GroveView.open(path)
+    assert not plain.graph_frozen()                    # the snapshot is opt-in
+    view = pg.GroveView.open(path, frozen=True)
+    assert view.blocks_loaded() == plain.blocks_loaded()  # read on first graph access
+    assert view.graph_frozen()
+    assert _ns(view.frozen_csr()[2]) == [1, 5, 3, 0, 2, 4]
+    start = view.intersect(pg.GenomicCoordinate(".", 0, 10), "chr1")[0]
+    visited, _ = view.bfs(start, edge_filter=lambda m: m["w"] < 5)
+    assert _ns(visited) == [0, 1, 2, 3]
+
+    g.thaw_graph()
+    g.serialize(path)                                  # a stale snapshot is removed
+    assert not os.path.exists(path + ".csr")
+    assert not pg.GroveView.open(path, frozen=True).graph_frozen()
+
+
+def test_connected_components():
+    pg = _pg()
+    g = pg.Grove()
+    keys = _graph(pg, g)
+    order, comp = g.connected_components(keys)
+    assert _ns(order) == [0, 1, 2, 3, 4, 5]
+    assert comp.tolist() == [0, 0, 0, 0, 0, 1] and comp.dtype.name == "int32"
+
+    order, comp = g.strongly_connected_components(keys)
+    assert comp.tolist() == [0, 0, 0, 0, 1, 2]        # the 0-1/2-3 cycle, 4, 5
+    assert g.connected_components(keys, weak=False)[1].tolist() == comp.tolist()
+
+    order, comp = g.connected_components([keys[5], keys[4], keys[1]])
+    assert _ns(order) == [5, 4, 1] and comp.tolist() == [0, 1, 1]
+    assert g.strongly_connected_components([keys[4], keys[1], keys[3]])[1].tolist() == [0, 1, 1]
+
+    order, comp = g.connected_components()             # no keys, not frozen: every index
+    assert _ns(order) == [0, 1, 2, 3, 4, 5] and comp.tolist() == [0, 0, 0, 0, 0, 1]
+    g.freeze_graph([keys[5], keys[2]])
+    order, comp = g.connected_components(threads=2)
+    assert _ns(order) == [5, 2, 3, 4, 0, 1] and comp.tolist() == [0, 1, 1, 1, 1, 1]
+
+
+def test_weak_components_follow_in_edges():
+    pg = _pg()
+    g = pg.Grove()
+    a, b, c, d = [g.insert("chr1", pg.GenomicCoordinate(".", 100 * i, 100 * i + 50), {"n": i})
+                  for i in range(4)]
+    g.add_edge(a, b)
+    g.add_edge(a, c)
+    order, comp = g.connected_components([b, c, d])    # b and c meet only through a
+    assert _ns(order) == [1, 2, 3] and comp.tolist() == [0, 0, 1]
+    assert g.connected_components([c, b], weak=False)[1].tolist() == [0, 1]
+
+
+def test_topological_order():
+    pg = _pg()
+    g = pg.Grove()
+    keys = _graph(pg, g)
+    with pytest.raises(ValueError):
+        g.topological_order(keys)                      # 0 -> 1 -> 3 -> 0
+    g.remove_edge(keys[3], keys[0])
+    assert _ns(g.topological_order(keys)) == [0, 5, 1, 2, 3, 4]
+
+
+def test_components_on_grove_view(tmp_path):
+    pg = _pg()
+    g = pg.Grove(4)
+    keys = _graph(pg, g)
+    g.remove_edge(keys[3], keys[0])
+    path = str(tmp_path / "graph.gg")
+    g.serialize(path)
+
+    view = pg.GroveView.open(path)
+    start = list(view.intersect(pg.GenomicCoordinate(".", 0, 10), "chr1"))
+    order, comp = view.strongly_connected_components(start)
+    assert _ns(order) == [0, 1, 2, 3, 4] and comp.tolist() == [0, 1, 2, 3, 4]
+    assert _ns(view.topological_order(start)) == [0, 1, 2, 3, 4]
+
+
+def test_edges_to_numpy():
+    pg = _pg()
+    g = pg.Grove()
+    keys = _graph(pg, g)
+    src, tgt, order = g.edges_to_numpy(keys)
+    assert _ns(order) == [0, 1, 2, 3, 4, 5]
+    assert src.dtype.name == "int64" and tgt.dtype.name == "int64"
+    assert list(zip(src.tolist(), tgt.tolist())) == [(0, 1), (0, 2), (1, 3), (2, 3), (2, 4), (3, 0)]
+
+    src, tgt, order = g.edges_to_numpy()               # not frozen: every index
+    assert _ns(order) == [0, 1, 2, 3, 4, 5] and len(src) == 6
+
+    g.freeze_graph([keys[3]])
+    src, tgt, order = g.edges_to_numpy()
+    assert _ns(order) == [3, 0, 1, 2, 4] and len(src) == 6
+
+
+def test_to_csr_matrix():
+    pg = _pg()
+    pytest.importorskip("scipy")
+    g = pg.Grove()
+    keys = _graph(pg, g)
+    matrix, order = g.to_csr_matrix(keys[:2])
+    assert matrix.shape == (5, 5) and matrix.nnz == 6
+    assert _ns(order) == [0, 1, 2, 3, 4]
+    dense = matrix.toarray()
+    assert dense[0, 1] == 1 and dense[3, 0] == 1 and dense[1, 0] == 0
+
+    matrix, order = g.to_csr_matrix()
+    assert matrix.shape == (6, 6) and matrix.nnz == 6 and _ns(order) == [0, 1, 2, 3, 4, 5]
+
+
+def test_edge_export_on_grove_view(tmp_path):
+    pg = _pg()
+    g = pg.Grove(4)
+    _graph(pg, g)
+    path = str(tmp_path / "graph.gg")
+    g.serialize(path)
+
+    view = pg.GroveView.open(path)
+    start = list(view.intersect(pg.GenomicCoordinate(".", 0, 10), "chr1"))
+    src, tgt, order = view.edges_to_numpy(start)
+    assert _ns(order) == [0, 1, 2, 3, 4]
+    assert sorted(zip(src.tolist(), tgt.tolist())) == [(0, 1), (0, 2), (1, 3), (2, 3), (2, 4), (3, 0)]
+
+    view = pg.GroveView.open(path)                     # no keys: every index, block by block
+    src, tgt, order = view.edges_to_numpy()
+    assert _ns(order) == [0, 1, 2, 3, 4, 5] and len(src) == 6
@@ -0,0 +1,143 @@
+"""
+Tests for interned payload fields on the JSON-payload groves: intern_fields()
+stores the declared fields' str values as registry ids (payloads and edge
+metadata), key.data expands them back, intersect_where() filters on the ids,
+and serialize() / deserialize() carry the fields in "<path>.columns".
+"""
+
+import os
+
+import pytest
+
+
+def _pg():
+    return pytest.importorskip("pygenogrove")
+
+
+def _c(pg, start, end, strand="+"):
+    return pg.GenomicCoordinate(strand, start, end)
+
+
+def _genes(pg, g):
+    rows = [
+        (100, 200, {"gene_id": "ENSG1", "biotype": "protein_coding", "score": 1}),
+        (150, 250, {"gene_id": "ENSG2", "biotype": "lncRNA", "score": 2}),
+        (180, 300, {"gene_id": "ENSG3", "biotype": "protein_coding", "score": 3}),
+        (400, 500, {"gene_id": "ENSG4", "biotype": None, "score": 4}),
+    ]
+    return [g.insert("chr1", _c(pg, s, e), d) for s, e, d in rows]
+
+
+def test_interned_fields_roundtrip_on_key_data():
+    pg = _pg()
+    g = pg.Grove()
+    g.intern_fields(["gene_id", "biotype"])
+    assert g.interned_fields == ["gene_id", "biotype"]
+    keys = _genes(pg, g)
+    assert keys[0].data == {"gene_id": "ENSG1", "biotype": "protein_coding", "score": 1}
+    assert keys[3].data["biotype"] is None
+    hits = list(g.intersect(_c(pg, 190, 195), "chr1"))
+    assert sorted(k.data["gene_id"] for k in hits) == ["ENSG1", "ENSG2", "ENSG3"]
+
+    r = g.interned_registry
+    assert r.find("protein_coding") is not None
+    assert len(r) == 6          # 4 gene ids + 2 biotypes, deduplicated
+
+
+def test_shared_registry_and_edge_metadata():
+    pg = _pg()
+    r = pg.Registry()
+    g = pg.Grove()
+    g.intern_fields(["source"], registry=r)
+    a = g.insert("chr1", _c(pg, 1, 10), {"source": "HAVANA"})
+    b = g.insert("chr1", _c(pg, 20, 30), {"source": "ENSEMBL"})
+    g.add_edge(a, b, {"source": "HAVANA", "kind": "next"})
+    assert g.interned_registry is r
+    assert r.find("HAVANA") == 0 and len(r) == 2
+    assert g.get_edges(a) == [{"source": "HAVANA", "kind": "next"}]
+
+
+def test_intersect_where_compares_ids():
+    pg = _pg()
+    g = pg.Grove()
+    g.intern_fields(["gene_id", "biotype"])
+    _genes(pg, g)
+    q = _c(pg, 0, 1000, "*")
+    coding = g.intersect_where(q, "chr1", "biotype", "protein_coding")
+    assert sorted(k.data["gene_id"] for k in coding) == ["ENSG1", "ENSG3"]
+    both = g.intersect_where(q, "chr1", "gene_id", ["ENSG2", "ENSG4", "missing"])
+    assert sorted(k.data["gene_id"] for k in both) == ["ENSG2", "ENSG4"]
+    assert g.intersect_where(q, "chr1", "biotype", "snRNA") == []
+    with pytest.raises(ValueError):
+        g.intersect_where(q, "chr1", "score", "1")
+
+
+def test_intern_fields_validation():
+    pg = _pg()
+    g = pg.Grove()
+    g.intern_fields(["gene_id"])
+    with pytest.raises(ValueError):
+        g.insert("chr1", _c(pg, 1, 10), {"gene_id": 7})   # must be str / None
+    with pytest.raises(ValueError):
+        g.intern_fields(["biotype"])                       # already declared
+
+    h = pg.Grove()
+    h.insert("chr1", _c(pg, 1, 10), {"gene_id": "x"})
+    with pytest.raises(ValueError):
+        h.intern_fields(["gene_id"])                       # not empty
+    assert h.interned_fields == [] and h.interned_registry is None
+
+
+def test_serialization_carries_interned_fields(tmp_path):
+    pg = _pg()
+    g = pg.Grove()
+    g.intern_fields(["gene_id", "biotype"])
+    _genes(pg, g)
+    path = str(tmp_path / "genes.gg")
+    g.serialize(path)
+    assert os.path.exists(path + ".columns")
+
+    loaded = pg.Grove.deserialize(path)
+    assert loaded.interned_fields == ["gene_id", "biotype"]
+    q = _c(pg, 0, 1000, "*")
+    got = sorted((k.data["gene_id"], k.data["biotype"]) for k in loaded.intersect(q, "chr1"))
+    assert got[0] == ("ENSG1", "protein_coding") and got[3] == ("ENSG4", None)
+    assert len(loaded.intersect_where(q, "chr1", "biotype", "lncRNA")) == 1
+
+    # Re-serializing a plain grove to the same path drops the stale columns.
+    pg.Grove().serialize(path)
+    assert not os.path.exists(path + ".columns")
+
+
+def test_grove_view_reads_interned_fields(tmp_path):
+    pg = _pg()
+    g = pg.Grove()
+    g.intern_fields(["gene_id", "biotype"])
+    keys = _genes(pg, g)
+    g.add_edge(keys[0], keys[1], {"biotype": "lncRNA"})
+    path = str(tmp_path / "genes.gg")
+    g.serialize(path)
+
+    view = pg.GroveView.open(path)
+    q = _c(pg, 0, 1000, "*")
+    got = sorted((k.data["gene_id"], k.data["biotype"]) for k in view.intersect(q, "chr1"))
+    assert got[0] == ("ENSG1", "protein_coding") and got[3] == ("ENSG4", None)
+    first = view.intersect(_c(pg, 100, 120), "chr1")[0]
+    assert view.get_edges(first) == [{"biotype": "lncRNA"}]
+
+    # The .gg holds plain JSON: without the sidecar the fields read as their ids.
+    os.remove(path + ".columns")
+    plain = pg.Grove.deserialize(path)
+    assert sorted(k.data["gene_id"] for k in plain.intersect(q, "chr1")) == [0, 2, 4, 5]
+    assert isinstance(pg.GroveView.open(path).intersect(q, "chr1")[0].data["biotype"], int)
+
+
+def test_numeric_grove_interned_fields():
+    pg = _pg()
+    g = pg.NumericGrove()
+    g.intern_fields(["chrom"])
+    for i in range(10):
+        g.insert("ids", pg.Numeric(i), {"chrom": f"chr{i % 3}"})
+    hits = g.intersect_where(pg.Numeric(4), "ids", "chrom", "chr1")
+    assert [k.data for k in hits] == [{"chrom": "chr1"}]
+    assert len(g.interned_registry) == 3
@@ -0,0 +1,116 @@
+"""
+Tests for KmerCounter — counting k-mer occurrences over FASTA/FASTQ input in
+hash-partitioned C++ tables, exported as NumPy arrays or a count-carrying
+KmerGrove / NumericGrove.
+"""
+
+from collections import Counter
+
+import pytest
+
+
+def _pg():
+    return pytest.importorskip("pygenogrove")
+
+
+def _revcomp(s):
+    return s[::-1].translate(str.maketrans("ACGT", "TGCA"))
+
+
+def _expected(seqs, k, canonical=True):
+    out = Counter()
+    for s in seqs:
+        for i in range(len(s) - k + 1):
+            w = s[i:i + k]
+            if set(w) <= set("ACGT"):
+                out[min(w, _revcomp(w)) if canonical else w] += 1
+    return out
+
+
+_SEQS = ["ACGTACGTTTGACCAACGT", "GGGNNCCCATATGACGTA", "TTTTTTTTAAAA"]
+
+
+def _write_fasta(tmp_path):
+    p = tmp_path / "s.fa"
+    p.write_text("".join(f">r{i}\n{s}\n" for i, s in enumerate(_SEQS)))
+    return str(p)
+
+
+@pytest.mark.parametrize("threads", [1, 3])
+def test_counts_match_reference(tmp_path, threads):
+    pg = _pg()
+    path = _write_fasta(tmp_path)
+    c = pg.KmerCounter(5, threads=threads)
+    expected = _expected(_SEQS, 5)
+    assert c.add(pg.FastaReader(path, chunk_size=4)) == sum(expected.values())
+    assert len(c) == len(expected)
+    assert c.total == sum(expected.values())
+    for w, n in expected.items():
+        assert c.count(w) == n
+        assert c.count(_revcomp(w)) == n  # canonicalized lookup
+    assert c.count("CCCCC") == 0
+
+
+def test_non_canonical_and_add_sequence(tmp_path):
+    pg = _pg()
+    c = pg.KmerCounter(3, canonical=False)
+    c.add_sequence("AAAAT")
+    assert c.count("AAA") == 2 and c.count("TTT") == 0
+    assert c.count(pg.Kmer("AAT")) == 1
+    c.add(_write_fasta(tmp_path))  # a path is streamed too
+    assert c.total == 3 + sum(_expected(_SEQS, 3, canonical=False).values())
+    c.clear()
+    assert len(c) == 0 and c.total == 0
+    with pytest.raises(ValueError):
+        c.count("AAAA")
+    with pytest.raises(ValueError):
+        pg.KmerCounter(33)
+
+
+def test_fastq_quality_threshold(tmp_path):
+    pg = _pg()
+    p = tmp_path / "r.fq"
+    # base 4 ('!' = Phred 0) is low quality: only k-mers avoiding it survive
+    p.write_text("@r\nACGTACGTA\n+\nIIII!IIII\n")
+    all_kmers = pg.KmerCounter(4, canonical=False)
+    assert all_kmers.add(str(p)) == 6
+    filtered = pg.KmerCounter(4, canonical=False, threads=2)
+    assert filtered.add(pg.FastaReader(str(p)), min_quality=20) == 2
+    assert filtered.count("ACGT") == 1 and filtered.count("CGTA") == 1
+    assert filtered.count("GTAC") == 0
+
+
+def test_to_numpy(tmp_path):
+    pg = _pg()
+    np = pytest.importorskip("numpy")
+    c = pg.KmerCounter(4, threads=2)
+    c.add(_write_fasta(tmp_path))
+    enc, counts = c.to_numpy()
+    assert enc.dtype == np.uint64 and counts.dtype == np.uint64
+    assert list(enc) == sorted(enc)
+    expected = _expected(_SEQS, 4)
+    assert {str(pg.Kmer(int(e), 4)): int(n) for e, n in zip(enc, counts)} == expected
+    enc2, counts2 = c.to_numpy(min_count=2)
+    assert len(enc2) == sum(1 for n in expected.values() if n >= 2)
+    assert (counts2 >= 2).all()
+
+
+def test_to_groves_carry_counts(tmp_path):
+    pg = _pg()
+    c = pg.KmerCounter(4)
+    c.add(_write_fasta(tmp_path))
+    expected = _expected(_SEQS, 4)
+
+    g = c.to_kmer_grove(order=8)
+    assert g.size() == len(expected) and g.get_order() == 8
+    for w, n in expected.items():
+        assert list(g.intersect(pg.Kmer(w), "kmers"))[0].data == n
+
+    ng = c.to_numeric_grove(index="counts", min_count=2)
+    assert ng.size() == sum(1 for n in expected.values() if n >= 2)
+    w = max(expected, key=expected.get)
+    hit = list(ng.intersect(pg.Numeric(pg.Kmer(w).encoding), "counts"))[0]
+    assert hit.data == expected[w]
+
+    with pytest.raises(ValueError):
+        pg.KmerCounter(16).to_numeric_grove()
@@ -81,4 +81,98 @@ def test_keys_keep_grove_alive():
     key = g.insert("seqs", pg.Kmer("ACGT"))
     del g
     gc.collect()
-    assert str(key.value) == "ACGT"
\ No newline at end of file
+    assert str(key.value) == "ACGT"
+
+
+def _revcomp(s):
+    return s[::-1].translate(str.maketrans("ACGT", "TGCA"))
+
+
+def _expected_kmers(seqs, k, canonical):
+    out = set()
+    for s in seqs:
+        for i in range(len(s) - k + 1):
+            w = s[i:i + k]
+            if "N" in w:
+                continue
+            out.add(min(w, _revcomp(w)) if canonical else w)
+    return out
+
+
+def test_from_sequences_reader_and_path(tmp_path):
+    pg = _pg()
+    seqs = ["ACGTACGTTTGACCA", "GGGNNCCCATATG"]
+    path = tmp_path / "s.fa"
+    path.write_text("".join(f">r{i}\n{s}\n" for i, s in enumerate(seqs)))
+
+    g = pg.KmerGrove.from_sequences(pg.FastaReader(str(path)), 5, canonical=False)
+    expected = _expected_kmers(seqs, 5, canonical=False)
+    assert g.size() == len(expected)
+    for w in expected:
+        assert len(g.intersect(pg.Kmer(w), "kmers")) == 1
+    assert len(g.intersect(pg.Kmer("TTTTT"), "kmers")) == 0
+
+    canon = pg.KmerGrove.from_sequences(str(path), 5, index="idx", order=16)
+    assert canon.size() == len(_expected_kmers(seqs, 5, canonical=True))
+    assert canon.get_order() == 16
+    for w in _expected_kmers(seqs, 5, canonical=True):
+        hits = list(canon.intersect(pg.Kmer(w), "idx"))
+        assert len(hits) == 1 and hits[0].data is None
+
+
+def test_from_sequences_chunked_reader_matches_whole(tmp_path):
+    pg = _pg()
+    seq = "ACGTTGCAAGCTTAGCCGATAGGCTANNACGTTAGCATCGA" * 3
+    path = tmp_path / "long.fa"
+    path.write_text(">chr\n" + "\n".join(seq[i:i + 10] for i in range(0, len(seq), 10)) + "\n")
+    whole = pg.KmerGrove.from_sequences(pg.FastaReader(str(path)), 7, threads=2)
+    chunked = pg.KmerGrove.from_sequences(
+        pg.FastaReader(str(path), chunk_size=4), 7, threads=2)
+    assert whole.size() == chunked.size() == len(_expected_kmers([seq], 7, True))
+
+
+def test_from_sequences_step_and_validation(tmp_path):
+    pg = _pg()
+    path = tmp_path / "s.fa"
+    path.write_text(">r\nAAAACCCCGGGG\n")
+    g = pg.KmerGrove.from_sequences(str(path), 4, canonical=False, step=4)
+    assert sorted(str(k.value) for k in g.intersect(pg.Kmer("AAAA"), "kmers")) == ["AAAA"]
+    assert g.size() == 3  # AAAA, CCCC, GGGG
+    with pytest.raises(ValueError):
+        pg.KmerGrove.from_sequences(str(path), 33)
+    with pytest.raises(ValueError):
+        pg.KmerGrove.from_sequences(str(path), 4, step=0)
+
+
+def test_contains_many_and_lookup_many(tmp_path):
+    pg = _pg()
+    np = pytest.importorskip("numpy")
+    g = pg.KmerGrove(4)
+    for s in ("ACGT", "GGGG", "TACG", "AAAA", "CATG"):
+        g.insert("seqs", pg.Kmer(s), {"seq": s})
+    queries = ["TACG", "TTTT", "ACGT", "TACG", "CCCC", "AAAA"]
+    enc = np.array([pg.Kmer(s).encoding for s in queries], dtype=np.uint64)
+
+    assert g.contains_many(enc, "seqs", 4).tolist() == [
+        True, False, True, True, False, True]
+    slots, keys = g.lookup_many(enc, "seqs", 4)
+    assert slots.dtype == np.int64
+    assert [str(k.value) for k in keys] == ["AAAA", "ACGT", "TACG"]
+    assert [keys[s].data["seq"] if s >= 0 else None for s in slots] == [
+        "TACG", None, "ACGT", "TACG", None, "AAAA"]
+    assert g.contains_many(enc, "nope", 4).tolist() == [False] * len(queries)
+    assert g.contains_many(np.array([], dtype=np.uint64), "seqs", 4).size == 0
+
+    path = str(tmp_path / "kmers.gg")
+    g.serialize(path)
+    view = pg.KmerGroveView.open(path)
+    assert view.contains_many(enc, "seqs", 4).tolist() == \
+        g.contains_many(enc, "seqs", 4).tolist()
+    vslots, vkeys = view.lookup_many(enc, "seqs", 4)
+    assert vslots.tolist() == slots.tolist()
+    assert [k.data for k in vkeys] == [k.data for k in keys]
+
+    with pytest.raises(ValueError):
+        g.contains_many(np.array([256], dtype=np.uint64), "seqs", 4)  # > 4^4
+    with pytest.raises(ValueError):
+        g.contains_many(enc, "seqs", 0)
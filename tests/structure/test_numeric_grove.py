@@ -82,4 +82,88 @@ def test_keys_keep_grove_alive():
     key = g.insert("ids", pg.Numeric(5))
     del g
     gc.collect()
-    assert key.value.value == 5
\ No newline at end of file
+    assert key.value.value == 5
+
+
+def test_contains_many_and_lookup_many(tmp_path):
+    pg = _pg()
+    np = pytest.importorskip("numpy")
+    g = pg.NumericGrove(3)
+    for v in range(0, 100, 5):
+        g.insert("ids", pg.Numeric(v), {"v": v})
+    values = np.array([10, 11, 95, 10, -5, 0], dtype=np.int64)
+
+    assert g.contains_many(values, "ids").tolist() == [
+        True, False, True, True, False, True]
+    slots, keys = g.lookup_many(values, "ids")
+    assert [k.value.value for k in keys] == [0, 10, 95]
+    assert slots.tolist() == [1, -1, 2, 1, -1, 0]
+    assert g.contains_many([5, 6], "ids").tolist() == [True, False]  # lists cast
+
+    path = str(tmp_path / "ids.gg")
+    g.serialize(path)
+    view = pg.NumericGroveView.open(path)
+    assert view.contains_many(values, "ids").tolist() == \
+        g.contains_many(values, "ids").tolist()
+    vslots, vkeys = view.lookup_many(values, "ids")
+    assert vslots.tolist() == slots.tolist()
+    assert [k.data for k in vkeys] == [{"v": 0}, {"v": 10}, {"v": 95}]
+
+    with pytest.raises(ValueError):
+        g.contains_many(np.array([2**40], dtype=np.int64), "ids")
+
+
+def test_lookup_many_cursor_matches_point_queries():
+    pg = _pg()
+    np = pytest.importorskip("numpy")
+    g = pg.NumericGrove(4)
+    stored = {-(2**31), -3, 0, 7, 8, 9, 40, 41, 2**31 - 1}
+    for v in stored:
+        g.insert("ids", pg.Numeric(v), {"v": v})
+    values = np.array([9, -(2**31), 41, 6, 8, 2**31 - 1, 9, -4, 100, 0, 40, -3],
+                      dtype=np.int64)
+    assert g.contains_many(values, "ids").tolist() == [v in stored for v in values.tolist()]
+    slots, keys = g.lookup_many(values, "ids")
+    assert [keys[s].value.value if s >= 0 else None for s in slots.tolist()] == [
+        v if v in stored else None for v in values.tolist()]
+
+
+def test_range_and_range_count(tmp_path):
+    pg = _pg()
+    np = pytest.importorskip("numpy")
+    g = pg.NumericGrove(3)
+    for v in (50, 10, 30, 20, 30, 40, -7, 1000):
+        g.insert("ts", pg.Numeric(v), {"v": v})
+
+    keys = g.range(15, 40, "ts")
+    assert [k.value.value for k in keys] == [20, 30, 30, 40]
+    assert [k.data["v"] for k in keys] == [20, 30, 30, 40]
+    assert g.range_count(15, 40, "ts") == 4
+    assert g.range_count(10, 10, "ts") == 1            # closed bounds
+    assert g.range_count(11, 19, "ts") == 0
+    assert g.range_count(40, 15, "ts") == 0            # lo > hi
+    assert g.range_count(-2**40, 2**40, "ts") == 8     # clamped to Numeric range
+    assert g.range_count(0, 100, "nope") == 0
+    values = g.range(-100, 100, "ts", as_array=True)
+    assert values.dtype == np.int64
+    assert values.tolist() == [-7, 10, 20, 30, 30, 40, 50]
+
+    path = str(tmp_path / "ts.gg")
+    g.serialize(path)
+    view = pg.NumericGroveView.open(path)
+    assert [k.data["v"] for k in view.range(15, 40, "ts")] == [20, 30, 30, 40]
+    assert view.range_count(0, 2000, "ts") == 7
+    assert view.range(0, 2000, "ts", as_array=True).tolist()[-1] == 1000
+
+
+def test_range_walks_leaves_across_duplicates():
+    pg = _pg()
+    g = pg.NumericGrove(3)
+    # Runs of equal values straddle leaf boundaries at order 3.
+    values = [v // 4 for v in range(400)]
+    for v in reversed(values):
+        g.insert("ids", pg.Numeric(v), None)
+    assert g.range(10, 12, "ids", as_array=True).tolist() == [10] * 4 + [11] * 4 + [12] * 4
+    assert g.range_count(0, 99, "ids") == 400
+    assert g.range_count(-5, 0, "ids") == 4
+    assert g.range_count(99, 200, "ids") == 4
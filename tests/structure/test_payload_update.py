@@ -0,0 +1,109 @@
+"""
+Tests for in-place payload updates on the JSON-payload groves: set_data() /
+set_data_many() replace stored payloads, and update(query, index, fields)
+patches the payloads of a query's hits with a dict of fields or a callable.
+"""
+
+import pytest
+
+
+def _pg():
+    return pytest.importorskip("pygenogrove")
+
+
+def _c(pg, start, end, strand="+"):
+    return pg.GenomicCoordinate(strand, start, end)
+
+
+def _grove(pg):
+    g = pg.Grove()
+    keys = [g.insert("chr1", _c(pg, s, s + 50), {"n": i}) for i, s in enumerate(range(0, 500, 100))]
+    return g, keys
+
+
+def test_set_data_replaces_payload_in_place():
+    pg = _pg()
+    g, keys = _grove(pg)
+    g.add_edge(keys[0], keys[1])
+    g.set_data(keys[0], {"n": 10, "tag": "x"})
+    assert keys[0].data == {"n": 10, "tag": "x"}
+    g.set_data(keys[1], None)
+    assert keys[1].data is None
+    # Ordering, query results and edges are untouched.
+    assert g.size() == 5
+    assert [k.data for k in g.intersect(_c(pg, 0, 10), "chr1")] == [{"n": 10, "tag": "x"}]
+    assert g.has_edge(keys[0], keys[1])
+
+
+def test_set_data_many():
+    pg = _pg()
+    g, keys = _grove(pg)
+    assert g.set_data_many(keys[:3], ["a", [1, 2], {"n": -1}]) == 3
+    assert [k.data for k in keys] == ["a", [1, 2], {"n": -1}, {"n": 3}, {"n": 4}]
+    with pytest.raises(ValueError):
+        g.set_data_many(keys[:2], [1])
+
+
+def test_update_with_fields():
+    pg = _pg()
+    g, keys = _grove(pg)
+    g.set_data(keys[2], None)
+    n = g.update(_c(pg, 0, 260, "*"), "chr1", {"n": 0, "seen": True})
+    assert n == 3
+    assert keys[0].data == {"n": 0, "seen": True}
+    assert keys[2].data == {"n": 0, "seen": True}      # None became a dict
+    assert keys[3].data == {"n": 3}
+    g.set_data(keys[4], [1])
+    with pytest.raises(ValueError):
+        g.update(_c(pg, 400, 410), "chr1", {"n": 0})
+
+
+def test_update_checks_every_hit_before_writing():
+    pg = _pg()
+    g, keys = _grove(pg)
+    g.set_data(keys[3], [1])                           # among dict payloads
+    with pytest.raises(ValueError):
+        g.update(_c(pg, 0, 460, "*"), "chr1", {"n": 0})
+    assert [k.data for k in keys] == [{"n": 0}, {"n": 1}, {"n": 2}, [1], {"n": 4}]
+
+    def double(d):
+        return {"n": d["n"] * 2}                       # TypeError on the list
+    with pytest.raises(TypeError):
+        g.update(_c(pg, 0, 460, "*"), "chr1", double)
+    assert [k.data for k in keys] == [{"n": 0}, {"n": 1}, {"n": 2}, [1], {"n": 4}]
+
+
+def test_update_with_callable():
+    pg = _pg()
+    g, keys = _grove(pg)
+    n = g.update(_c(pg, 100, 360, "*"), "chr1", lambda d: {"n": d["n"] * 2})
+    assert n == 3
+    assert [k.data["n"] for k in keys] == [0, 2, 4, 6, 4]
+    with pytest.raises(TypeError):
+        g.update(_c(pg, 0, 10), "chr1", 5)
+
+
+def test_update_keeps_interned_fields(tmp_path):
+    pg = _pg()
+    g = pg.Grove()
+    g.intern_fields(["biotype"])
+    a = g.insert("chr1", _c(pg, 100, 200), {"biotype": "lncRNA", "score": 1})
+    g.insert("chr1", _c(pg, 300, 400), {"biotype": "lncRNA", "score": 2})
+    g.update(_c(pg, 150, 160), "chr1", {"biotype": "protein_coding"})
+    assert a.data == {"biotype": "protein_coding", "score": 1}
+    q = _c(pg, 0, 1000, "*")
+    assert [k.data["score"] for k in g.intersect_where(q, "chr1", "biotype", "protein_coding")] == [1]
+
+    path = str(tmp_path / "updated.gg")
+    g.serialize(path)
+    loaded = pg.Grove.deserialize(path)
+    assert sorted((k.data["biotype"], k.data["score"]) for k in loaded.intersect(q, "chr1")) == [
+        ("lncRNA", 2), ("protein_coding", 1)]
+
+
+def test_numeric_grove_set_data():
+    pg = _pg()
+    g = pg.NumericGrove()
+    k = g.insert("ids", pg.Numeric(7), None)
+    g.set_data(k, {"label": "seven"})
+    assert [h.data for h in g.intersect(pg.Numeric(7), "ids")] == [{"label": "seven"}]
@@ -260,4 +260,113 @@ def test_remove_key_on_data_grove():
 
     assert g.remove_key("chr1", a) is True
     assert g.size() == 1
-    assert len(g.intersect(pg.GenomicCoordinate(".", 100, 200), "chr1")) == 0
\ No newline at end of file
+    assert len(g.intersect(pg.GenomicCoordinate(".", 100, 200), "chr1")) == 0
+
+
+# ---------------------------------------------------------------- key handles
+
+def test_key_handles_survive_compact():
+    pg = _pg()
+    g = pg.Grove(4)
+    keys = [g.insert("chr1", pg.GenomicCoordinate(".", s, s + 10), {"n": i})
+            for i, s in enumerate(range(0, 500, 50))]
+    handles = [g.handle(k, "chr1") for k in keys]
+    for k in keys[::2]:
+        assert g.remove_key("chr1", k) is True
+    del keys
+    g.compact()
+    assert g.key_storage_size() >= g.indexed_vertex_count() == 5
+
+    assert [h.valid for h in handles] == [False, True] * 5
+    live = [h for h in handles if h.valid]
+    assert [h.key.data["n"] for h in live] == [1, 3, 5, 7, 9]
+    assert [h.key.value.start for h in live] == [50, 150, 250, 350, 450]
+    with pytest.raises(ValueError):
+        handles[0].key
+    assert live[0].index == "chr1"
+
+    # Handles keep working across repeated compactions.
+    g.remove_key("chr1", live[0].key)
+    g.compact()
+    assert not live[0].valid and live[1].key.data["n"] == 3
+
+
+def test_key_handles_tell_equal_values_apart():
+    pg = _pg()
+    g = pg.Grove(3)
+    c = pg.GenomicCoordinate("+", 100, 200)
+    keys = [g.insert("chr1", c, {"n": i}) for i in range(4)]
+    g.insert("chr1", pg.GenomicCoordinate("+", 150, 160), {"n": "other"})
+    handles = [g.handle(k, "chr1") for k in keys]
+    g.remove_key("chr1", keys[1])
+    g.compact()
+    assert [h.key.data["n"] for h in handles if h.valid] == [0, 2, 3]
+
+
+def test_key_handles_edges_and_external_keys():
+    pg = _pg()
+    g = pg.Grove(4)
+    a = g.insert("chr1", pg.GenomicCoordinate(".", 100, 200))
+    b = g.insert("chr1", pg.GenomicCoordinate(".", 300, 400))
+    x = g.add_external_key(pg.GenomicCoordinate(".", 0, 1), {"ext": True})
+    g.add_edge(b, x)
+    hb, hx = g.handle(b, "chr1"), g.handle(x)
+    assert hx.index is None
+    g.remove_key("chr1", a)
+    g.compact()
+    assert g.has_edge(hb.key, hx.key)
+    assert hx.key.data == {"ext": True}
+
+
+def test_key_handles_check_membership():
+    pg = _pg()
+    g = pg.Grove(4)
+    keys = [g.insert("chr1", pg.GenomicCoordinate(".", s, s + 10), {"n": i})
+            for i, s in enumerate(range(0, 200, 50))]
+    other = g.insert("chr2", pg.GenomicCoordinate(".", 0, 10))
+    h = g.handle(keys[3], "chr1")
+    with pytest.raises(ValueError):
+        g.handle(keys[1])                              # indexed, so not external
+    with pytest.raises(ValueError):
+        g.handle(other, "chr1")
+    with pytest.raises(ValueError):
+        g.handle(keys[1], "nope")
+    g.remove_key("chr1", keys[0])
+    g.compact()
+    assert h.key.data == {"n": 3}
+
+
+# ---------------------------------------------------------------- batch removal
+
+def test_remove_keys_batch():
+    pg = _pg()
+    g = pg.Grove(4)
+    keys = [g.insert("chr1", pg.GenomicCoordinate(".", s, s + 10), {"n": i})
+            for i, s in enumerate(range(0, 1000, 50))]
+    other = g.insert("chr2", pg.GenomicCoordinate(".", 0, 10))
+    for a, b in zip(keys, keys[1:]):
+        g.add_edge(a, b)
+    g.add_edge(other, keys[3])
+    h = g.handle(keys[4], "chr1")
+
+    doomed = keys[3:9] + [keys[3], None, other]        # duplicate, None, wrong index
+    assert g.remove_keys("chr1", doomed) == 6
+    assert g.size() == 15
+    assert g.edge_count() == 20 - 7 - 1                # chain edges touching 3..8, other->3
+    assert g.out_degree(keys[2]) == 0 and g.out_degree(keys[9]) == 1
+    assert not h.valid
+    assert g.remove_keys("chr1", keys[3:5]) == 0       # already removed
+
+
+def test_remove_range_and_compact():
+    pg = _pg()
+    g = pg.Grove(4)
+    keys = [g.insert("chr1", pg.GenomicCoordinate(".", s, s + 10), {"n": i})
+            for i, s in enumerate(range(0, 1000, 50))]
+    h = g.handle(keys[-1], "chr1")
+    del keys
+    assert g.remove_range("chr1", pg.GenomicCoordinate(".", 100, 505), compact=True) == 9
+    assert g.size() == 11 and g.key_storage_size() >= 11
+    assert h.key.data == {"n": 19}
+    assert len(g.intersect(pg.GenomicCoordinate(".", 0, 1000), "chr1")) == 11
+    assert g.remove_range("chr1", pg.GenomicCoordinate(".", 2000, 3000)) == 0
@@ -0,0 +1,103 @@
+"""
+Tests for the sketching primitives — minimizers(), MinHashSketch — and the
+KmerGrove-backed SketchIndex answering containment / Jaccard queries.
+"""
+
+import random
+
+import pytest
+
+
+def _pg():
+    return pytest.importorskip("pygenogrove")
+
+
+def _random_dna(n, seed):
+    rng = random.Random(seed)
+    return "".join(rng.choice("ACGT") for _ in range(n))
+
+
+def test_minimizers_cover_every_window():
+    pg = _pg()
+    seq = _random_dna(500, 1)
+    k, w = 7, 5
+    enc, pos = pg.minimizers(seq, k, w, positions=True)
+    assert len(enc) == len(pos) > 0
+    assert list(pos) == sorted(set(pos))
+    for e, p in zip(enc, pos):
+        kmer = str(pg.Kmer(int(e), k))
+        window = seq[p:p + k]
+        rc = window[::-1].translate(str.maketrans("ACGT", "TGCA"))
+        assert kmer == min(window, rc)
+    # every window of w k-mers contains a reported minimizer
+    starts = set(int(p) for p in pos)
+    for s in range(len(seq) - (w + k - 1) + 1):
+        assert any(s <= p < s + w for p in starts)
+    assert len(pg.minimizers("ACGTNACGT", 4, 2)) == 0  # no window spans the N
+
+
+def test_minhash_sketch_bottom_k(tmp_path):
+    pg = _pg()
+    seq = _random_dna(3000, 2)
+    s = pg.MinHashSketch(k=15, size=100)
+    s.add_sequence(seq)
+    assert len(s) == 100
+    h = s.hashes
+    assert list(h) == sorted(set(h))
+
+    p = tmp_path / "s.fa"
+    p.write_text(">a\n" + "\n".join(seq[i:i + 60] for i in range(0, len(seq), 60)) + "\n")
+    from_file = pg.MinHashSketch(k=15, size=100)
+    from_file.add(pg.FastaReader(str(p), chunk_size=128))
+    assert list(from_file.hashes) == list(h)
+    assert from_file.jaccard(s) == 1.0
+
+    rebuilt = pg.MinHashSketch.from_hashes(h, 15, size=100)
+    assert list(rebuilt.hashes) == list(h)
+
+
+def test_jaccard_and_containment_estimates():
+    pg = _pg()
+    seq = _random_dna(20000, 3)
+    whole = pg.MinHashSketch(k=21, size=500)
+    whole.add_sequence(seq)
+    half = pg.MinHashSketch(k=21, size=500)
+    half.add_sequence(seq[:10000])
+    other = pg.MinHashSketch(k=21, size=500)
+    other.add_sequence(_random_dna(20000, 4))
+
+    assert half.containment(whole) == pytest.approx(1.0)
+    assert 0.35 < whole.containment(half) < 0.65
+    assert 0.35 < whole.jaccard(half) < 0.65
+    assert whole.jaccard(other) < 0.02
+    with pytest.raises(ValueError):
+        whole.jaccard(pg.MinHashSketch(k=15))
+
+
+def test_sketch_index_query():
+    pg = _pg()
+    genomes = {name: _random_dna(8000, seed) for seed, name in enumerate("abc")}
+    index = pg.SketchIndex(k=21, order=16)
+    for name, seq in genomes.items():
+        s = pg.MinHashSketch(k=21, size=300)
+        s.add_sequence(seq)
+        assert index.add(name, s) == len(index) - 1
+    assert index.names == ["a", "b", "c"]
+    first = pg.MinHashSketch(k=21, size=300)
+    first.add_sequence(genomes["a"])
+    assert index.sketch(0).hashes.tolist() == first.hashes.tolist()  # from the postings
+    assert not hasattr(index, "grove")
+
+    q = pg.MinHashSketch(k=21, size=300)
+    q.add_sequence(genomes["b"][:4000])
+    hits = index.query(q)
+    name, shared, containment, jaccard = hits[0]
+    assert name == "b" and shared > 0
+    assert containment == pytest.approx(1.0)
+    assert 0.3 < jaccard < 0.7
+    assert all(h[0] != "b" for h in index.query(q, min_shared=shared + 1))
+
+    with pytest.raises(ValueError):
+        index.add("a", q)  # duplicate name
+    with pytest.raises(ValueError):
+        index.query(pg.MinHashSketch(k=15))
@@ -0,0 +1,120 @@
+"""
+Behaviour of VariantGrove (grove<genomic_coordinate, variant_genotypes>): VCF
+records keyed by their reference span, each carrying REF/ALT and 2-bit packed
+per-sample genotypes (optional 8-bit GQ / DP). Covers the VcfReader bulk load,
+the VariantGenotypes payload, the vectorized VariantQueryResult.genotypes(),
+and a .gg round-trip through VariantGroveView.
+"""
+
+import pytest
+
+
+def _pg():
+    return pytest.importorskip("pygenogrove")
+
+
+_VCF = "\n".join([
+    "##fileformat=VCFv4.2",
+    "##contig=<ID=chr1,length=1000>",
+    "##contig=<ID=chr2,length=1000>",
+    '##FORMAT=<ID=GT,Number=1,Type=String,Description="Genotype">',
+    '##FORMAT=<ID=GQ,Number=1,Type=Integer,Description="Genotype Quality">',
+    '##FORMAT=<ID=DP,Number=1,Type=Integer,Description="Read Depth">',
+    "\t".join(["#CHROM", "POS", "ID", "REF", "ALT", "QUAL", "FILTER", "INFO",
+               "FORMAT", "S1", "S2", "S3", "S4", "S5"]),
+    "\t".join(["chr1", "100", "rs1", "A", "G", "50", "PASS", ".", "GT:GQ:DP",
+               "0/1:30:12", "1|1:99:400", "0/0:20:8", "./.:.:.", "1/2:10:3"]),
+    "\t".join(["chr1", "200", "rs2", "AT", "A", "50", "PASS", ".", "GT:GQ:DP",
+               "0/0:5:5", "0/0:5:5", "0/1:5:5", "1/1:5:5", "0/0:5:5"]),
+    "\t".join(["chr2", "50", "rs3", "C", "T", "50", "PASS", ".", "GT",
+               "1/1", "0/1", "0/0", "0/0", "./."]),
+    "",
+])
+
+
+def _vcf(tmp_path):
+    p = tmp_path / "cohort.vcf"
+    p.write_text(_VCF)
+    return str(p)
+
+
+def _loaded(pg, tmp_path, **kw):
+    g = pg.VariantGrove(8)
+    n = g.insert_vcf(pg.VcfReader(_vcf(tmp_path)), **kw)
+    assert n == 3
+    return g
+
+
+def test_insert_vcf_indexes_by_chrom(tmp_path):
+    pg = _pg()
+    g = _loaded(pg, tmp_path)
+    assert g.size() == 3
+    hits = list(g.intersect(pg.GenomicCoordinate(".", 99, 99), "chr1"))
+    assert len(hits) == 1
+    v = hits[0].data
+    assert (v.id, v.ref, list(v.alt), v.sample_count) == ("rs1", "A", ["G"], 5)
+    assert len(g.intersect(pg.GenomicCoordinate(".", 49, 49), "chr2")) == 1
+
+
+def test_payload_genotypes(tmp_path):
+    pg = _pg()
+    pytest.importorskip("numpy")
+    g = _loaded(pg, tmp_path)
+    v = list(g.intersect(pg.GenomicCoordinate(".", 99, 99), "chr1"))[0].data
+    # 0/1, 1|1, 0/0, ./., 1/2 (two ALT copies -> capped dosage 2)
+    assert v.genotypes().tolist() == [1, 2, 0, -1, 2]
+    assert v.gq() is None and v.dp() is None  # not requested
+
+
+def test_gq_dp_quantized(tmp_path):
+    pg = _pg()
+    pytest.importorskip("numpy")
+    g = _loaded(pg, tmp_path, gq=True, dp=True)
+    v = list(g.intersect(pg.GenomicCoordinate(".", 99, 99), "chr1"))[0].data
+    assert v.gq().tolist() == [30, 99, 20, 255, 10]    # 255 = missing
+    assert v.dp().tolist() == [12, 254, 8, 255, 3]     # clamped to 254
+
+
+def test_query_result_genotype_matrix(tmp_path):
+    pg = _pg()
+    np = pytest.importorskip("numpy")
+    g = _loaded(pg, tmp_path)
+    res = g.intersect(pg.GenomicCoordinate(".", 0, 500), "chr1")
+    mat = res.genotypes()
+    assert mat.dtype == np.int8 and mat.shape == (2, 5)
+    assert mat.tolist() == [[1, 2, 0, -1, 2], [0, 0, 1, 2, 0]]
+    empty = g.intersect(pg.GenomicCoordinate(".", 900, 950), "chr1").genotypes()
+    assert empty.shape[0] == 0
+
+
+def test_sample_selection_applies(tmp_path):
+    pg = _pg()
+    pytest.importorskip("numpy")
+    g = pg.VariantGrove(8)
+    g.insert_vcf(pg.VcfReader(_vcf(tmp_path), samples=["S4", "S1"]))
+    res = g.intersect(pg.GenomicCoordinate(".", 0, 500), "chr1")
+    assert res.genotypes().tolist() == [[-1, 1], [2, 0]]
+
+
+def test_default_payload_is_empty():
+    pg = _pg()
+    pytest.importorskip("numpy")
+    assert pg.VariantGenotypes().sample_count == 0
+    assert len(pg.VariantGenotypes().genotypes()) == 0
+
+
+def test_serialization_and_view(tmp_path):
+    pg = _pg()
+    pytest.importorskip("numpy")
+    g = _loaded(pg, tmp_path, gq=True)
+    path = str(tmp_path / "variants.gg")
+    g.serialize(path)
+
+    loaded = pg.VariantGrove.deserialize(path)
+    v = list(loaded.intersect(pg.GenomicCoordinate(".", 199, 200), "chr1"))[0].data
+    assert v.genotypes().tolist() == [0, 0, 1, 2, 0]
+    assert v.gq().tolist() == [5] * 5
+
+    view = pg.VariantGroveView.open(path)
+    res = view.intersect(pg.GenomicCoordinate(".", 49, 49), "chr2")
+    assert res.genotypes().tolist() == [[2, 1, 0, 0, -1]]